@@ -204,11 +204,14 @@ namespace Utils
 
       public:
         ZonesList();
+        ZonesList(const ZonesList& other);
+        ZonesList& operator=(const ZonesList& other);
         ~ZonesList();
 
         bool Add(uint64 start, uint64 end, AppCUI::Graphics::ColorPair c, std::string_view txt);
         bool Add(const Zone& zone);
         std::optional<Zone> OffsetToZone(uint64 offset) const;
+        std::optional<Zone> OffsetToNextZone(uint64 offset) const;
         bool SetCache(const Zone::Interval& interval);
         void Clear();
         uint32 GetCount() const;
@@ -792,19 +795,35 @@ namespace Decoding
             bool IsEncrypted() const;
         };
 
+        struct ExtractResult {
+            uint32 extracted;
+            uint32 failed;
+            uint64 bytes;
+            uint64 milliseconds;
+        };
+
         struct CORE_EXPORT Info {
             void* context{ nullptr };
 
             uint32 GetCount() const;
             bool GetEntry(uint32 index, Entry& entry) const;
+            // indexes of the entries directly inside 'directory' (empty for the root of the archive)
+            bool GetChildren(std::u16string_view directory, std::vector<uint32>& indexes) const;
+            // reads the entry through the source given to GetInfo (file on disk or DataCache)
             bool Decompress(Buffer& output, uint32 index, const std::string& password) const;
             bool Decompress(const BufferView& input, Buffer& output, uint32 index, const std::string& password) const;
+            // writes the entry in small chunks, the entry is never entirely in memory
+            bool Decompress(AppCUI::OS::DataObject& output, uint32 index, const std::string& password) const;
+            // extracts the entries (directories with everything inside them) under 'destination', concurrently if the archive is on disk
+            bool Extract(const std::vector<uint32>& indexes, const std::filesystem::path& destination, const std::string& password, ExtractResult& result) const;
 
             Info();
             ~Info();
         };
         CORE_EXPORT bool GetInfo(std::u16string_view path, Info& info);
         CORE_EXPORT bool GetInfo(Utils::DataCache& cache, Info& info);
+        // false if writing the entry under a folder would escape it (absolute path, drive letter, ".." component)
+        CORE_EXPORT bool IsSafeEntryPath(std::u8string_view name);
     } // namespace ZIP
 } // namespace Decoding
 
@@ -904,6 +923,43 @@ namespace SQLite3
         ~Column();
     };
 
+    /*
+     * Reads a table one page of rows at a time instead of materializing it. Pages are located by rowid (keyset
+     * paging) when the table has one and by LIMIT/OFFSET otherwise; the page following the last one read is
+     * prefetched on a background connection and the rows count (sqlite_stat1 estimate, then COUNT(*)) is computed
+     * asynchronously. Cells are only formatted when requested.
+     */
+    class CORE_EXPORT Cursor
+    {
+        void* context{ nullptr };
+
+        friend class Database;
+
+      public:
+        static constexpr uint32 DEFAULT_PAGE_SIZE = 256;
+
+        Cursor() = default;
+        Cursor(const Cursor&)            = delete;
+        Cursor& operator=(const Cursor&) = delete;
+        Cursor(Cursor&& other) noexcept;
+        Cursor& operator=(Cursor&& other) noexcept;
+        ~Cursor();
+
+        bool IsValid() const
+        {
+            return context != nullptr;
+        }
+        uint32 GetColumnsCount() const;
+        std::string_view GetColumnName(uint32 column) const;
+
+        // -1 while unknown; exact is false while only the sqlite_stat1 estimate is available
+        AppCUI::int64 GetRowsCount(bool& exact) const;
+
+        // false if the row does not exist (past the end of the table) or the page could not be read
+        bool GetCell(uint64 row, uint32 column, String& value);
+        bool HasRow(uint64 row);
+    };
+
     class CORE_EXPORT Database
     {
         void* handle{ nullptr };
@@ -923,6 +979,7 @@ namespace SQLite3
         std::pair<std::vector<String>, std::vector<std::vector<String>>> GetTableData(std::string_view name);
         std::pair<std::vector<String>, std::vector<std::vector<String>>> GetStatementData(const std::string_view& statement);
         std::vector<Column> ExecuteQuery(const char* query);
+        Cursor OpenCursor(std::string_view tableName, uint32 pageSize = Cursor::DEFAULT_PAGE_SIZE);
     };
 } // namespace SQLite3
 
@@ -947,6 +1004,57 @@ namespace Entropy
     CORE_EXPORT double RenyiEntropy(const BufferView& buffer, double alpha);
 } // namespace Entropy
 
+namespace Strings
+{
+    enum class Encoding : uint8 { None = 0, Ascii = 1, UTF16LE = 2, UTF16BE = 4, All = 7 };
+
+    struct CORE_EXPORT Entry {
+        uint64 offset;
+        uint32 size; // in bytes
+        Encoding encoding;
+
+        inline uint32 GetLength() const
+        {
+            return encoding == Encoding::Ascii ? size : size >> 1;
+        }
+    };
+
+    struct CORE_EXPORT Settings {
+        bool charset[256];
+        uint32 minLength{ 4 };
+        uint32 maxLength{ 0x4000 };    // longer strings are reported with their first maxLength characters (also the overlap between two chunks)
+        uint32 chunkSize{ 0x400000 };  // data processed by a worker at once
+        uint32 threadsCount{ 0 };      // 0 means one worker for each hardware thread
+        Encoding encodings{ Encoding::All };
+
+        Settings(); // charset defaults to the printable ascii characters and TAB
+        inline bool HasEncoding(Encoding e) const
+        {
+            return (static_cast<uint8>(encodings) & static_cast<uint8>(e)) != 0;
+        }
+    };
+
+    class CORE_EXPORT Table
+    {
+        void* context{ nullptr };
+
+      public:
+        Table();
+        ~Table();
+
+        // scans [offset, offset + size) from the cache; I/O is done by the caller thread, classification on all workers
+        bool Build(Utils::DataCache& cache, const Settings& settings, uint64 offset = 0, uint64 size = Utils::INVALID_OFFSET);
+        void Clear();
+
+        uint64 GetCount() const;
+        bool GetEntry(uint64 index, Entry& entry) const;
+        bool GetText(Utils::DataCache& cache, const Entry& entry, std::string& text) const;
+        bool WriteTo(Utils::DataCache& cache, std::u16string_view path) const;
+
+        static std::string_view GetEncodingName(Encoding encoding);
+    };
+} // namespace Strings
+
 /*
  * Object can be:
  *   - a file
@@ -1102,6 +1210,25 @@ namespace View
 
         struct CORE_EXPORT PositionToColorInterface {
             virtual bool GetColorForBuffer(uint64 offset, BufferView buf, BufferColor& result) = 0;
+
+            // batched variant: fills 'result' with the (sorted, non-overlapping) colored spans found for the first 'count' bytes from
+            // 'buf' (the buffer may hold a few extra bytes after 'count' to allow matching patterns that cross the end of the range)
+            virtual void GetColorsForBuffer(uint64 offset, BufferView buf, uint32 count, std::vector<BufferColor>& result)
+            {
+                result.clear();
+                const auto length = static_cast<uint32>(buf.GetLength());
+                count             = std::min<>(count, length);
+                for (uint32 index = 0; index < count;) {
+                    BufferColor bc{ GView::Utils::INVALID_OFFSET, GView::Utils::INVALID_OFFSET, NoColorPair };
+                    const auto window = BufferView(buf.GetData() + index, std::min<>(length - index, 16u));
+                    if (GetColorForBuffer(offset + index, window, bc) && bc.IsValue() && bc.end >= offset + index) {
+                        result.push_back(bc);
+                        index = static_cast<uint32>(std::min<uint64>(bc.end - offset + 1, count));
+                    } else {
+                        index++;
+                    }
+                }
+            }
         };
 
         struct CORE_EXPORT OffsetTranslateInterface {
@@ -1563,6 +1690,18 @@ namespace View
 
     namespace GridViewer
     {
+        // Supplies the cells of a grid on demand; the viewer only asks for the rows of the page it shows.
+        struct CORE_EXPORT DataSourceInterface {
+            // rows known so far (a source may still be counting)
+            virtual uint64 GetRowsCount()                                      = 0;
+            virtual bool HasRow(uint64 row)                                    = 0;
+            virtual uint32 GetColumnsCount()                                   = 0;
+            // false -> the viewer uses the default header
+            virtual bool GetColumnName(uint32 column, String& name)            = 0;
+            virtual bool GetCell(uint64 row, uint32 column, String& value)     = 0;
+            virtual ~DataSourceInterface()                                     = default;
+        };
+
         struct CORE_EXPORT Settings {
             void* data;
 
@@ -1570,6 +1709,8 @@ namespace View
 
             void SetSeparator(char separator[2]);
             bool SetName(std::string_view name);
+            // the viewer takes ownership; without a data source the object is parsed as separated values
+            void SetDataSource(DataSourceInterface* dataSource);
         };
     }; // namespace GridViewer
 
@@ -1682,6 +1823,18 @@ namespace App
           std::string_view typeName = "",
           Reference<Window> parent  = nullptr,
           const ConstString& creationProcess = "");
+    // opens [offset, offset + size) of an already opened object (data stored uncompressed inside a container)
+    // objects that are files on disk are not copied, the new object reads that range directly from the file
+    void CORE_EXPORT OpenSubRange(
+          Reference<Object> parentObject,
+          uint64 offset,
+          uint64 size,
+          const ConstString& name,
+          const ConstString& path,
+          OpenMethod method,
+          std::string_view typeName          = "",
+          Reference<Window> parent           = nullptr,
+          const ConstString& creationProcess = "");
     Reference<GView::Object> CORE_EXPORT GetObject(uint32 index);
     uint32 CORE_EXPORT GetObjectsCount();
     std::string_view CORE_EXPORT GetTypePluginName(uint32 index);
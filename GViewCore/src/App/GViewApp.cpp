@@ -158,6 +158,21 @@ void GView::App::OpenBuffer(
         gviewAppInstance->AddBufferWindow(buf, name, path, method, typeName, parent, creationProcess);
 }
 
+void GView::App::OpenSubRange(
+      Reference<Object> parentObject,
+      uint64 offset,
+      uint64 size,
+      const ConstString& name,
+      const ConstString& path,
+      OpenMethod method,
+      std::string_view typeName,
+      Reference<Window> parent,
+      const ConstString& creationProcess)
+{
+    if (gviewAppInstance)
+        gviewAppInstance->AddSubRangeWindow(parentObject, offset, size, name, path, method, typeName, parent, creationProcess);
+}
+
 Reference<GView::Object> GView::App::GetObject(uint32 index)
 {
     CHECK(gviewAppInstance, nullptr, "GView was not initialized !");
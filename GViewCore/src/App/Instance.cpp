@@ -467,6 +467,40 @@ bool Instance::AddBufferWindow(
     }
     return Add(Object::Type::MemoryBuffer, std::move(f), name, path, 0, method, typeName, parent, creationProcess);
 }
+bool Instance::AddSubRangeWindow(
+      Reference<Object> parentObject,
+      uint64 offset,
+      uint64 size,
+      const ConstString& name,
+      const ConstString& path,
+      OpenMethod method,
+      string_view typeName,
+      Reference<Window> parent,
+      const ConstString& creationProcess)
+{
+    CHECK(parentObject.IsValid(), false, "Expecting a valid parent object !");
+    auto& parentData = parentObject->GetData();
+    CHECK(offset <= parentData.GetSize() && size <= parentData.GetSize() - offset,
+          false,
+          "Range [%llu, %llu) is outside the parent object !",
+          offset,
+          offset + size);
+
+    // the parent's cache is not shared (its object might be closed first) --> files on disk are opened again
+    if (parentObject->GetObjectType() == Object::Type::File) {
+        auto f = std::make_unique<AppCUI::OS::File>();
+        if (f->OpenRead(std::filesystem::path(parentObject->GetPath()))) {
+            auto subRange = std::make_unique<SubRangeDataObject>(std::move(f), offset, size);
+            return Add(Object::Type::File, std::move(subRange), name, path, 0, method, typeName, parent, creationProcess);
+        }
+    }
+
+    // memory buffers, processes, ... --> copy the range
+    CHECK(size <= 0xFFFFFFFFULL, false, "Range too large to be copied: %llu bytes", size);
+    const auto buffer = parentData.CopyToBuffer(offset, static_cast<uint32>(size));
+    CHECK(buffer.GetLength() == size, false, "Fail to copy %llu bytes from offset %llu", size, offset);
+    return AddBufferWindow(buffer, name, path, method, typeName, parent, creationProcess);
+}
 void Instance::OpenFile()
 {
     auto res = Dialogs::FileDialog::ShowOpenFileWindow("", "", this->lastOpenedFolderLocation);
@@ -0,0 +1,58 @@
+#include "Internal.hpp"
+
+namespace GView::App
+{
+SubRangeDataObject::SubRangeDataObject(std::unique_ptr<AppCUI::OS::DataObject> _base, uint64 _start, uint64 _size)
+    : base(std::move(_base)), start(_start), size(_size), position(0)
+{
+}
+SubRangeDataObject::~SubRangeDataObject()
+{
+    Close();
+}
+bool SubRangeDataObject::ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead)
+{
+    bytesRead = 0;
+    CHECK(base, false, "Sub range data object was closed !");
+    CHECK(position <= size, false, "Current position is outside the sub range !");
+
+    const auto toRead = static_cast<uint32>(std::min<uint64>(bufferSize, size - position));
+    if (toRead == 0)
+        return bufferSize == 0;
+    CHECK(base->SetCurrentPos(start + position), false, "Fail to move to offset: %llu", start + position);
+    const auto result = base->ReadBuffer(buffer, toRead, bytesRead);
+    position += bytesRead;
+    return result;
+}
+bool SubRangeDataObject::WriteBuffer(const void*, uint32, uint32& bytesWritten)
+{
+    bytesWritten = 0;
+    RETURNERROR(false, "Sub range data objects are read only !");
+}
+uint64 SubRangeDataObject::GetSize()
+{
+    return size;
+}
+uint64 SubRangeDataObject::GetCurrentPos() const
+{
+    return position;
+}
+bool SubRangeDataObject::SetSize(uint64)
+{
+    RETURNERROR(false, "Sub range data objects can not be resized !");
+}
+bool SubRangeDataObject::SetCurrentPos(uint64 newPosition)
+{
+    CHECK(newPosition <= size, false, "Position %llu is outside the sub range (size: %llu)", newPosition, size);
+    position = newPosition;
+    return true;
+}
+void SubRangeDataObject::Close()
+{
+    if (base)
+    {
+        base->Close();
+        base.reset();
+    }
+}
+} // namespace GView::App
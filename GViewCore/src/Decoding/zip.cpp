@@ -4,12 +4,17 @@
 #include <mz_os.h>
 #include <mz_strm.h>
 #include <mz_strm_buf.h>
+#include <mz_strm_os.h>
 #include <mz_strm_split.h>
 #include <mz_zip.h>
 #include <mz_zip_rw.h>
 
 #include <locale>
 #include <codecvt>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace GView::Decoding::ZIP
 {
@@ -32,6 +37,9 @@ using mz_zip_reader_create_ptr = struct Reader
     }
 };
 
+constexpr uint32 ROOT_INDEX         = 0xFFFFFFFF;
+constexpr uint32 EXTRACT_CHUNK_SIZE = 0x100000; // memory used by one extraction worker
+
 struct _Entry
 {
     uint16_t version_madeby{};     /* version made by */
@@ -62,9 +70,21 @@ struct _Entry
     uint16_t pk_verify{};          /* pkware encryption verifier */
 
     EntryType type{};
+    int64_t cdPosition{ -1 }; /* position inside the central directory, -1 for directories added as parents */
+
+    uint32 parent{ ROOT_INDEX };   /* index of the parent directory entry */
+    std::vector<uint32> children{}; /* entries directly inside this directory */
 };
 
-void ConvertZipFileInfoToEntry(const mz_zip_entry* zipFile, _Entry& entry)
+static inline std::u8string_view GetDirectoryKey(std::u8string_view filename)
+{
+    if (!filename.empty() && filename[filename.size() - 1] == '/') {
+        filename = { filename.data(), filename.size() - 1 };
+    }
+    return filename;
+}
+
+void ConvertZipFileInfoToEntry(void* zipHandle, const mz_zip_entry* zipFile, _Entry& entry)
 {
     entry.version_madeby     = zipFile->version_madeby;
     entry.version_needed     = zipFile->version_needed;
@@ -103,8 +123,8 @@ void ConvertZipFileInfoToEntry(const mz_zip_entry* zipFile, _Entry& entry)
 
     entry.type = EntryType::Unknown;
 
-    const bool isDir     = (mz_zip_entry_is_dir((void*) zipFile) == MZ_OK);
-    const bool isSymlink = (mz_zip_entry_is_symlink((void*) zipFile) == MZ_OK);
+    const bool isDir     = (mz_zip_entry_is_dir(zipHandle) == MZ_OK);
+    const bool isSymlink = (mz_zip_entry_is_symlink(zipHandle) == MZ_OK);
     if (isDir)
     {
         entry.type = EntryType::Directory;
@@ -122,11 +142,129 @@ void ConvertZipFileInfoToEntry(const mz_zip_entry* zipFile, _Entry& entry)
     }
 }
 
+// minizip stream that reads the archive through the object's DataCache, so only the
+// end of central directory records, the central directory and the requested entries are touched
+struct CacheStream
+{
+    mz_stream base{}; // must be first, minizip uses the stream pointer as mz_stream*
+    Utils::DataCache* cache{ nullptr };
+    int64_t position{ 0 };
+};
+
+static int32_t CacheStreamOpen(void* stream, const char*, int32_t mode)
+{
+    return (mode & MZ_OPEN_MODE_WRITE) ? MZ_OPEN_ERROR : MZ_OK;
+}
+
+static int32_t CacheStreamIsOpen(void* stream)
+{
+    return reinterpret_cast<CacheStream*>(stream)->cache != nullptr ? MZ_OK : MZ_OPEN_ERROR;
+}
+
+static int32_t CacheStreamRead(void* stream, void* buf, int32_t size)
+{
+    auto cacheStream = reinterpret_cast<CacheStream*>(stream);
+    auto output      = reinterpret_cast<uint8*>(buf);
+    int32_t read     = 0;
+    while (read < size && static_cast<uint64>(cacheStream->position) < cacheStream->cache->GetSize())
+    {
+        const auto chunkSize = std::min<uint32>(static_cast<uint32>(size - read), cacheStream->cache->GetCacheSize());
+        const auto view      = cacheStream->cache->Get(cacheStream->position, chunkSize, false);
+        if (!view.IsValid() || view.GetLength() == 0)
+        {
+            break;
+        }
+        memcpy(output + read, view.GetData(), view.GetLength());
+        read += static_cast<int32_t>(view.GetLength());
+        cacheStream->position += view.GetLength();
+    }
+    return read;
+}
+
+static int32_t CacheStreamWrite(void*, const void*, int32_t)
+{
+    return MZ_WRITE_ERROR;
+}
+
+static int64_t CacheStreamTell(void* stream)
+{
+    return reinterpret_cast<CacheStream*>(stream)->position;
+}
+
+static int32_t CacheStreamSeek(void* stream, int64_t offset, int32_t origin)
+{
+    auto cacheStream = reinterpret_cast<CacheStream*>(stream);
+    int64_t position = offset;
+    switch (origin)
+    {
+    case MZ_SEEK_CUR:
+        position += cacheStream->position;
+        break;
+    case MZ_SEEK_END:
+        position += static_cast<int64_t>(cacheStream->cache->GetSize());
+        break;
+    case MZ_SEEK_SET:
+        break;
+    default:
+        return MZ_SEEK_ERROR;
+    }
+    if (position < 0 || static_cast<uint64>(position) > cacheStream->cache->GetSize())
+    {
+        return MZ_SEEK_ERROR;
+    }
+    cacheStream->position = position;
+    return MZ_OK;
+}
+
+static int32_t CacheStreamClose(void*)
+{
+    return MZ_OK;
+}
+
+static int32_t CacheStreamError(void*)
+{
+    return MZ_OK;
+}
+
+static mz_stream_vtbl cacheStreamVtbl = { CacheStreamOpen, CacheStreamIsOpen, CacheStreamRead,  CacheStreamWrite, CacheStreamTell, CacheStreamSeek,
+                                          CacheStreamClose, CacheStreamError, nullptr, nullptr, nullptr, nullptr };
+
 struct _Info
 {
     std::string path;
-    mz_zip_reader_create_ptr reader{};
+    CacheStream cacheStream{};    /* used for archives that are read through a DataCache */
+    void* fileStream{ nullptr };  /* used for archives that are read from disk */
+    void* zip{ nullptr };         /* kept open for the lifetime of the info, entries are opened by their central directory position */
     std::vector<_Entry> entries;
+    std::vector<uint32> rootChildren;
+    std::unordered_map<std::u8string, uint32> directories; /* directory path (without the trailing '/') -> entry index */
+
+    void Reset()
+    {
+        if (zip != nullptr)
+        {
+            mz_zip_close(zip);
+            mz_zip_delete(&zip);
+            zip = nullptr;
+        }
+        if (fileStream != nullptr)
+        {
+            mz_stream_os_close(fileStream);
+            mz_stream_os_delete(&fileStream);
+            fileStream = nullptr;
+        }
+        cacheStream.cache    = nullptr;
+        cacheStream.position = 0;
+        path.clear();
+        entries.clear();
+        rootChildren.clear();
+        directories.clear();
+    }
+
+    ~_Info()
+    {
+        Reset();
+    }
 };
 
 uint32 Info::GetCount() const
@@ -144,6 +282,28 @@ bool Info::GetEntry(uint32 index, Entry& entry) const
     return true;
 }
 
+bool Info::GetChildren(std::u16string_view directory, std::vector<uint32>& indexes) const
+{
+    CHECK(context != nullptr, false, "");
+    auto info = reinterpret_cast<_Info*>(context);
+
+    indexes.clear();
+    if (directory.empty()) {
+        indexes = info->rootChildren;
+        return true;
+    }
+
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+    const auto path = convert.to_bytes(directory.data(), directory.data() + directory.size());
+    const auto key  = GetDirectoryKey({ reinterpret_cast<const char8_t*>(path.data()), path.size() });
+
+    const auto it = info->directories.find(std::u8string(key));
+    CHECK(it != info->directories.end(), false, "");
+
+    indexes = info->entries[it->second].children;
+    return true;
+}
+
 Info::Info()
 {
     this->context = new _Info();
@@ -305,26 +465,220 @@ bool Info::Decompress(Buffer& output, uint32 index, const std::string& password)
 {
     CHECK(context != nullptr, false, "");
     auto info = reinterpret_cast<_Info*>(context);
+    CHECK(info->zip != nullptr, false, "");
 
     CHECK(index < info->entries.size(), false, "");
     auto& entry = info->entries.at(index);
     CHECK(entry.type == EntryType::File, false, "");
+    CHECK(entry.cdPosition >= 0, false, "");
 
-    mz_zip_reader_create_ptr reader{ mz_zip_reader_create() };
-    mz_zip_reader_set_password(reader.value, password.c_str());
-    mz_zip_reader_set_pattern(reader.value, (char*) entry.filename.data(), 0);
-
-    CHECK(mz_zip_reader_open_file(reader.value, info->path.c_str()) == MZ_OK, false, "");
+    CHECK(mz_zip_goto_entry(info->zip, entry.cdPosition) == MZ_OK, false, "");
+    CHECK(mz_zip_entry_read_open(info->zip, 0, password.empty() ? nullptr : password.c_str()) == MZ_OK, false, "");
 
     output.Reserve(entry.uncompressed_size);
 
-    CHECK(mz_zip_reader_entry_save_buffer(reader.value, output.GetData(), (int32_t) entry.uncompressed_size) == MZ_OK, false, "");
+    int64_t total = 0;
+    while (total < entry.uncompressed_size)
+    {
+        const auto toRead = static_cast<int32_t>(std::min<int64_t>(entry.uncompressed_size - total, INT32_MAX));
+        const auto read   = mz_zip_entry_read(info->zip, output.GetData() + total, toRead);
+        if (read <= 0)
+        {
+            break;
+        }
+        total += read;
+    }
+
+    // closing the entry after reading all of it validates the crc
+    CHECK(mz_zip_entry_close(info->zip) == MZ_OK, false, "");
+    CHECK(total == entry.uncompressed_size, false, "");
 
     output.Resize(entry.uncompressed_size);
 
     return true;
 }
 
+static bool StreamEntry(void* zip, const _Entry& entry, AppCUI::OS::DataObject& output, const std::string& password, std::vector<uint8>& chunk)
+{
+    CHECK(entry.cdPosition >= 0, false, "");
+    CHECK(mz_zip_goto_entry(zip, entry.cdPosition) == MZ_OK, false, "");
+    CHECK(mz_zip_entry_read_open(zip, 0, password.empty() ? nullptr : password.c_str()) == MZ_OK, false, "");
+
+    int64_t total = 0;
+    bool written  = true;
+    while (true)
+    {
+        const auto read = mz_zip_entry_read(zip, chunk.data(), static_cast<int32_t>(chunk.size()));
+        if (read <= 0)
+        {
+            written = read == 0;
+            break;
+        }
+        if (!output.Write(chunk.data(), static_cast<uint32>(read)))
+        {
+            written = false;
+            break;
+        }
+        total += read;
+    }
+
+    // the entry must be closed even if reading failed, the crc is validated here
+    const bool closed = mz_zip_entry_close(zip) == MZ_OK;
+    CHECK(written && closed && total == entry.uncompressed_size, false, "");
+
+    return true;
+}
+
+bool Info::Decompress(AppCUI::OS::DataObject& output, uint32 index, const std::string& password) const
+{
+    CHECK(context != nullptr, false, "");
+    auto info = reinterpret_cast<_Info*>(context);
+    CHECK(info->zip != nullptr, false, "");
+
+    CHECK(index < info->entries.size(), false, "");
+    auto& entry = info->entries.at(index);
+    CHECK(entry.type == EntryType::File, false, "");
+
+    std::vector<uint8> chunk(EXTRACT_CHUNK_SIZE);
+    return StreamEntry(info->zip, entry, output, password, chunk);
+}
+
+bool IsSafeEntryPath(std::u8string_view name)
+{
+    // no absolute paths, drive letters or ".." components -> the entry stays under the folder it is written to
+    const std::filesystem::path path(name);
+    return !name.empty() && path.is_relative() && !path.has_root_name() &&
+           std::find(path.begin(), path.end(), std::filesystem::path("..")) == path.end();
+}
+
+bool Info::Extract(const std::vector<uint32>& indexes, const std::filesystem::path& destination, const std::string& password, ExtractResult& result) const
+{
+    CHECK(context != nullptr, false, "");
+    auto info = reinterpret_cast<_Info*>(context);
+    CHECK(info->zip != nullptr, false, "");
+
+    result = {};
+
+    // expand the directories to the files inside them
+    std::vector<uint32> files;
+    std::vector<uint32> toVisit(indexes.begin(), indexes.end());
+    std::vector<bool> visited(info->entries.size(), false);
+    while (!toVisit.empty())
+    {
+        const auto index = toVisit.back();
+        toVisit.pop_back();
+        CHECK(index < info->entries.size(), false, "");
+        if (visited[index])
+        {
+            continue;
+        }
+        visited[index] = true;
+
+        const auto& entry = info->entries[index];
+        if (entry.type == EntryType::Directory)
+        {
+            toVisit.insert(toVisit.end(), entry.children.begin(), entry.children.end());
+        }
+        else if (entry.type == EntryType::File && entry.cdPosition >= 0)
+        {
+            files.push_back(index);
+        }
+    }
+
+    // biggest entries first so that one of them does not end up last, alone on a worker
+    std::sort(files.begin(), files.end(), [info](uint32 a, uint32 b) { return info->entries[a].uncompressed_size > info->entries[b].uncompressed_size; });
+
+    const auto start = std::chrono::steady_clock::now();
+    std::atomic<uint32> nextFile{ 0 };
+    std::atomic<uint32> extracted{ 0 };
+    std::atomic<uint32> failed{ 0 };
+    std::atomic<uint64> bytes{ 0 };
+
+    auto worker = [&](void* zip)
+    {
+        std::vector<uint8> chunk(EXTRACT_CHUNK_SIZE);
+        for (uint32 i = nextFile++; i < files.size(); i = nextFile++)
+        {
+            const auto& entry = info->entries[files[i]];
+
+            // do not allow entries to be written outside of the destination
+            if (!IsSafeEntryPath(entry.filename))
+            {
+                failed++;
+                continue;
+            }
+
+            const auto path = destination / std::filesystem::path(entry.filename);
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+            AppCUI::OS::File file;
+            if (!file.Create(path, true))
+            {
+                failed++;
+                continue;
+            }
+            const bool streamed = StreamEntry(zip, entry, file, password, chunk);
+            file.Close();
+            if (streamed)
+            {
+                extracted++;
+                bytes += entry.uncompressed_size;
+            }
+            else
+            {
+                // a wrong password, a corrupted entry or a canceled extraction leaves a partial file behind
+                std::filesystem::remove(path, ec);
+                failed++;
+            }
+        }
+    };
+
+    // the DataCache can not be shared between threads, so only archives on disk are extracted concurrently
+    // (every worker has its own file stream and zip handle)
+    const uint32 workersCount = info->path.empty() ? 1 : std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1), static_cast<uint32>(files.size()));
+    if (workersCount > 1)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(workersCount);
+        for (uint32 i = 0; i < workersCount; i++)
+        {
+            threads.emplace_back(
+                  [&]()
+                  {
+                      void* stream = mz_stream_os_create();
+                      void* zip    = mz_zip_create();
+                      if (stream && zip && mz_stream_os_open(stream, info->path.c_str(), MZ_OPEN_MODE_READ) == MZ_OK &&
+                          mz_zip_open(zip, stream, MZ_OPEN_MODE_READ) == MZ_OK)
+                      {
+                          worker(zip);
+                          mz_zip_close(zip);
+                      }
+                      if (zip)
+                          mz_zip_delete(&zip);
+                      if (stream)
+                      {
+                          mz_stream_os_close(stream);
+                          mz_stream_os_delete(&stream);
+                      }
+                  });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    // whatever was not extracted by the workers (or everything when running on a single thread)
+    worker(info->zip);
+
+    result.extracted    = extracted;
+    result.failed       = failed;
+    result.bytes        = bytes;
+    result.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    return result.failed == 0;
+}
+
 bool Info::Decompress(const BufferView& input, Buffer& output, uint32 index, const std::string& password) const
 {
     CHECK(context != nullptr, false, "");
@@ -355,139 +709,132 @@ bool Info::Decompress(const BufferView& input, Buffer& output, uint32 index, con
     return true;
 }
 
-bool GetInfo(std::u16string_view path, Info& info)
+static inline std::vector<uint32>& GetChildrenList(_Info* info, uint32 parent)
 {
-    auto internalInfo = reinterpret_cast<_Info*>(info.context);
-    CHECK(internalInfo, false, "");
-
-    internalInfo->reader.Reset();
-    internalInfo->reader.value = mz_zip_reader_create();
-
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
-    std::u16string p(path);
-    internalInfo->entries.clear();
-    internalInfo->path = convert.to_bytes(p);
-
-    CHECK(mz_zip_reader_open_file(internalInfo->reader.value, internalInfo->path.c_str()) == MZ_OK, false, "");
-    CHECK(mz_zip_reader_goto_first_entry(internalInfo->reader.value) == MZ_OK, false, "");
+    return parent == ROOT_INDEX ? info->rootChildren : info->entries[parent].children;
+}
 
-    do
-    {
-        mz_zip_entry* zipFile{ nullptr };
-        CHECKBK(mz_zip_reader_entry_get_info(internalInfo->reader.value, &zipFile) == MZ_OK, "");
-        mz_zip_reader_set_pattern(internalInfo->reader.value, nullptr, 1); // do we need a pattern?
-
-        size_t entryIndex = internalInfo->entries.size();
-        auto& entry       = internalInfo->entries.emplace_back();
-      
-        ConvertZipFileInfoToEntry(zipFile, entry);
-
-        std::u8string_view filename = entry.filename;
-        if (entry.type == EntryType::Directory && filename[filename.size() - 1] == '/') {
-            filename = { filename.data(), filename.size() - 1 };
+// returns the entry index of directory 'path', adding it (and its missing parents) if not already present
+static uint32 GetOrAddDirectory(_Info* info, std::u8string_view path, uint16_t versionMadeBy, uint16_t versionNeeded)
+{
+    // walk up until a known directory (or the root) is found
+    std::vector<size_t> missing;
+    uint32 parent              = ROOT_INDEX;
+    std::u8string_view current = path;
+    while (!current.empty()) {
+        const auto it = info->directories.find(std::u8string(current));
+        if (it != info->directories.end()) {
+            parent = it->second;
+            break;
         }
+        missing.push_back(current.size());
 
-        size_t offset = 0;
-
-        while (true) {
-            size_t pos = filename.find_first_of('/', offset);
-
-            CHECKBK(pos != std::string::npos, "");
+        const auto pos = current.find_last_of('/');
+        current        = pos == std::u8string_view::npos ? std::u8string_view{} : current.substr(0, pos);
+    }
 
-            // add the parent as well if not already present
-            auto& entry         = internalInfo->entries[entryIndex];
-            auto parentFilename = entry.filename.substr(0, pos + 1);
+    // ... and add the missing ones top to bottom
+    for (auto it = missing.rbegin(); it != missing.rend(); it++) {
+        const auto index = static_cast<uint32>(info->entries.size());
+        auto& entry      = info->entries.emplace_back();
+
+        entry.filename = path.substr(0, *it);
+        entry.filename.push_back('/');
+        entry.filename_size  = static_cast<uint16_t>(entry.filename.size());
+        entry.type           = EntryType::Directory;
+        entry.version_madeby = versionMadeBy;
+        entry.version_needed = versionNeeded;
+        entry.parent         = parent;
+
+        info->directories.emplace(path.substr(0, *it), index);
+        GetChildrenList(info, parent).push_back(index);
+        parent = index;
+    }
 
-            auto it = std::find_if(
-                  internalInfo->entries.begin(), internalInfo->entries.end(), [&](const _Entry& e) -> bool { return e.filename == parentFilename; });
-            if (it == internalInfo->entries.end()) {
-                auto& parentEntry          = internalInfo->entries.emplace_back();
-                parentEntry.filename       = parentFilename;
-                parentEntry.filename_size  = parentFilename.size();
-                parentEntry.type           = EntryType::Directory;
-                parentEntry.version_madeby = entry.version_madeby;
-                parentEntry.version_needed = entry.version_needed;
-            }
+    return parent;
+}
 
-            offset = pos + 1;
+static void AddEntry(_Info* info, _Entry&& entry)
+{
+    const auto key    = GetDirectoryKey(entry.filename);
+    const auto pos    = key.find_last_of('/');
+    const auto parent = GetOrAddDirectory(info, pos == std::u8string_view::npos ? std::u8string_view{} : key.substr(0, pos), entry.version_madeby, entry.version_needed);
+
+    if (entry.type == EntryType::Directory) {
+        const auto it = info->directories.find(std::u8string(key));
+        if (it != info->directories.end()) {
+            // already added as the parent of a previous entry -> keep its place in the tree, take the real data
+            auto& existing = info->entries[it->second];
+            entry.parent   = existing.parent;
+            entry.children = std::move(existing.children);
+            existing       = std::move(entry);
+            return;
         }
+        info->directories.emplace(key, static_cast<uint32>(info->entries.size()));
+    }
 
-        CHECKBK(mz_zip_reader_goto_next_entry(internalInfo->reader.value) == MZ_OK, "");
-    } while (true);
-
-    return true;
+    entry.parent = parent;
+    GetChildrenList(info, parent).push_back(static_cast<uint32>(info->entries.size()));
+    info->entries.push_back(std::move(entry));
 }
 
-bool GetInfo(Utils::DataCache& cache, Info& info)
+static bool ReadCentralDirectory(_Info* info, void* stream)
 {
-    auto internalInfo = reinterpret_cast<_Info*>(info.context);
-    CHECK(internalInfo, false, "");
+    info->zip = mz_zip_create();
+    CHECK(info->zip != nullptr, false, "");
 
-    internalInfo->reader.Reset();
-    internalInfo->reader.value = mz_zip_reader_create();
-
-    // mz_zip_reader_set_password(reader, password.c_str()); // do we want to try a password?
-    // mz_zip_reader_set_encoding(reader.get(), 0);
-
-    // not the best option.. you might want to stream this or drop it on the disk as a temp file
-    // every option has its downsides
-    auto buffer = cache.GetEntireFile();
-    CHECK(buffer.IsValid(), false, "");
-
-    CHECK(mz_zip_reader_open_buffer(
-                internalInfo->reader.value,
-                const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(buffer.GetData())),
-                static_cast<uint32>(buffer.GetLength()), // max 4GB
-                /* don't copy */ 0) == MZ_OK,
-          false,
-          "");
-    CHECK(mz_zip_reader_goto_first_entry(internalInfo->reader.value) == MZ_OK, false, "");
+    // minizip locates the end of central directory (and the zip64 locator) and reads only the central directory
+    CHECK(mz_zip_open(info->zip, stream, MZ_OPEN_MODE_READ) == MZ_OK, false, "");
+    CHECK(mz_zip_goto_first_entry(info->zip) == MZ_OK, false, "");
 
     do
     {
         mz_zip_file* zipFile{ nullptr };
-        CHECKBK(mz_zip_reader_entry_get_info(internalInfo->reader.value, &zipFile) == MZ_OK, "");
-        mz_zip_reader_set_pattern(internalInfo->reader.value, nullptr, 1); // do we need a pattern?
+        CHECKBK(mz_zip_entry_get_info(info->zip, &zipFile) == MZ_OK, "");
 
-        size_t entryIndex = internalInfo->entries.size();
-        auto& entry = internalInfo->entries.emplace_back();
+        _Entry entry;
+        ConvertZipFileInfoToEntry(info->zip, zipFile, entry);
+        entry.cdPosition = mz_zip_get_entry(info->zip);
 
-        ConvertZipFileInfoToEntry(zipFile, entry);
+        AddEntry(info, std::move(entry));
+    } while (mz_zip_goto_next_entry(info->zip) == MZ_OK);
 
-        std::u8string_view filename = entry.filename;
-        if (entry.type == EntryType::Directory && filename[filename.size() - 1] == '/') {
-            filename = { filename.data(), filename.size() - 1 };
-        }
+    return true;
+}
 
-        size_t offset = 0;
+bool GetInfo(std::u16string_view path, Info& info)
+{
+    auto internalInfo = reinterpret_cast<_Info*>(info.context);
+    CHECK(internalInfo, false, "");
 
-        while (true) {
-            size_t pos = filename.find_first_of('/', offset);
+    internalInfo->Reset();
 
-            CHECKBK(pos != std::string::npos, "");
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+    std::u16string p(path);
+    internalInfo->path = convert.to_bytes(p);
 
-            // add the parent as well if not already present
-            auto& entry         = internalInfo->entries[entryIndex];
-            auto parentFilename = entry.filename.substr(0, pos + 1);
+    internalInfo->fileStream = mz_stream_os_create();
+    CHECK(internalInfo->fileStream != nullptr, false, "");
+    CHECK(mz_stream_os_open(internalInfo->fileStream, internalInfo->path.c_str(), MZ_OPEN_MODE_READ) == MZ_OK, false, "");
 
-            auto it = std::find_if(
-                  internalInfo->entries.begin(), internalInfo->entries.end(), [&](const _Entry& e) -> bool { return e.filename == parentFilename; });
-            if (it == internalInfo->entries.end()) {
-                auto& parentEntry          = internalInfo->entries.emplace_back();
-                parentEntry.filename       = parentFilename;
-                parentEntry.filename_size  = parentFilename.size();
-                parentEntry.type           = EntryType::Directory;
-                parentEntry.version_madeby = entry.version_madeby;
-                parentEntry.version_needed = entry.version_needed;
-            }
+    return ReadCentralDirectory(internalInfo, internalInfo->fileStream);
+}
 
-            offset = pos + 1;
-        }
+bool GetInfo(Utils::DataCache& cache, Info& info)
+{
+    auto internalInfo = reinterpret_cast<_Info*>(info.context);
+    CHECK(internalInfo, false, "");
 
-        CHECKBK(mz_zip_reader_goto_next_entry(internalInfo->reader.value) == MZ_OK, "");
-    } while (true);
+    internalInfo->Reset();
 
-    return true;
+    // mz_zip_reader_set_password(reader, password.c_str()); // do we want to try a password?
+    // mz_zip_reader_set_encoding(reader.get(), 0);
+
+    internalInfo->cacheStream.base.vtbl = &cacheStreamVtbl;
+    internalInfo->cacheStream.cache     = &cache;
+    internalInfo->cacheStream.position  = 0;
+
+    return ReadCentralDirectory(internalInfo, &internalInfo->cacheStream);
 }
 
 } // namespace GView::ZIP
@@ -27,6 +27,11 @@ bool Matcher::Init(std::string_view expression, bool isUnicode, bool isCaseSensi
         .expression      = RE2(asv, options),
     };
 
+    if (!c->expression.ok()) {
+        delete c;
+        RETURNERROR(false, "Invalid regular expression");
+    }
+
     this->context = c;
 
     return true;
@@ -0,0 +1,475 @@
+#include <GView.hpp>
+#include <sqlite3.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace GView::SQLite3
+{
+namespace
+{
+    constexpr uint32 MAX_CACHED_PAGES = 16;
+    constexpr uint64 NO_PAGE          = 0xFFFFFFFFFFFFFFFFULL;
+
+    struct Value {
+        Column::Type type;
+        uint32 size; // bytes of a text or blob value
+        union {
+            int64 integer;
+            double real;
+            uint64 offset; // of a text or blob value in Page::bytes
+        };
+    };
+
+    struct Page {
+        uint64 index;
+        uint32 rowsCount;
+        std::vector<Value> values; // rowsCount x columns
+        std::vector<uint8> bytes;
+    };
+
+    // a read-only connection and the statements used on it; every thread works on a connection of its own
+    struct Connection {
+        sqlite3* db{ nullptr };
+        sqlite3_stmt* readPage{ nullptr };   // rowid > ?1 ORDER BY rowid LIMIT ?2 (or LIMIT ?2 OFFSET ?1)
+        sqlite3_stmt* locatePage{ nullptr }; // the rowid that ends the previous page, for jumps to pages not read yet
+
+        bool Open(const char* path)
+        {
+            if (sqlite3_open_v2(path, &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+                Close();
+                return false;
+            }
+            return true;
+        }
+        void Close()
+        {
+            sqlite3_finalize(readPage);
+            sqlite3_finalize(locatePage);
+            sqlite3_close_v2(db);
+            readPage   = nullptr;
+            locatePage = nullptr;
+            db         = nullptr;
+        }
+    };
+
+    struct CursorContext {
+        std::string name;
+        std::string table; // quoted identifier
+        uint32 pageSize;
+        bool hasRowid;
+        std::vector<std::string> columns;
+
+        Connection foreground;
+        Connection prefetch;
+        Connection count;
+
+        std::mutex lock;
+        std::condition_variable wake;
+        std::list<Page> pages;                         // most recently used first
+        std::unordered_map<uint64, int64> pageLastRowid; // keyset boundaries found so far
+        uint64 prefetchRequest{ NO_PAGE };
+        bool stop{ false };
+
+        std::atomic<int64> rowsCount{ -1 };
+        std::atomic<bool> rowsCountExact{ false };
+
+        std::thread prefetchWorker;
+        std::thread countWorker;
+
+        ~CursorContext()
+        {
+            {
+                std::scoped_lock guard(lock);
+                stop = true;
+            }
+            wake.notify_all();
+            // abort a COUNT(*) or a page read that is still running
+            if (count.db) {
+                sqlite3_interrupt(count.db);
+            }
+            if (prefetch.db) {
+                sqlite3_interrupt(prefetch.db);
+            }
+            if (countWorker.joinable()) {
+                countWorker.join();
+            }
+            if (prefetchWorker.joinable()) {
+                prefetchWorker.join();
+            }
+            foreground.Close();
+            prefetch.Close();
+            count.Close();
+        }
+
+        bool Prepare(Connection& connection)
+        {
+            std::string query;
+            if (hasRowid) {
+                // the rowid is selected after the table columns to keep the keyset boundary of the page
+                query = "SELECT *, rowid FROM " + table + " WHERE rowid > ?1 ORDER BY rowid LIMIT ?2;";
+            } else {
+                query = "SELECT * FROM " + table + " LIMIT ?2 OFFSET ?1;";
+            }
+            CHECK(sqlite3_prepare_v2(connection.db, query.c_str(), -1, &connection.readPage, nullptr) == SQLITE_OK, false, "");
+
+            if (hasRowid) {
+                query = "SELECT rowid FROM " + table + " ORDER BY rowid LIMIT 1 OFFSET ?1;";
+                CHECK(sqlite3_prepare_v2(connection.db, query.c_str(), -1, &connection.locatePage, nullptr) == SQLITE_OK, false, "");
+            }
+            return true;
+        }
+
+        Page* FindPage(uint64 index)
+        {
+            for (auto it = pages.begin(); it != pages.end(); it++) {
+                if (it->index == index) {
+                    pages.splice(pages.begin(), pages, it);
+                    return &pages.front();
+                }
+            }
+            return nullptr;
+        }
+
+        void StorePage(Page&& page)
+        {
+            if (FindPage(page.index)) {
+                return; // already read by the other thread
+            }
+            pages.push_front(std::move(page));
+            if (pages.size() > MAX_CACHED_PAGES) {
+                pages.pop_back();
+            }
+        }
+
+        // the rowid after which the page starts
+        bool GetPageStart(Connection& connection, uint64 index, int64& rowid)
+        {
+            if (index == 0) {
+                rowid = std::numeric_limits<int64>::min();
+                return true;
+            }
+            {
+                std::scoped_lock guard(lock);
+                if (auto it = pageLastRowid.find(index - 1); it != pageLastRowid.end()) {
+                    rowid = it->second;
+                    return true;
+                }
+            }
+
+            // a jump ahead: walk the rowid b-tree to the last row of the previous page
+            auto statement = connection.locatePage;
+            sqlite3_reset(statement);
+            sqlite3_bind_int64(statement, 1, (sqlite3_int64) (index * pageSize - 1));
+            CHECK(sqlite3_step(statement) == SQLITE_ROW, false, "");
+            rowid = sqlite3_column_int64(statement, 0);
+            sqlite3_reset(statement);
+
+            std::scoped_lock guard(lock);
+            pageLastRowid[index - 1] = rowid;
+            return true;
+        }
+
+        bool ReadPage(Connection& connection, uint64 index, Page& page)
+        {
+            const auto columnsCount = (uint32) columns.size();
+            auto statement          = connection.readPage;
+
+            int64 start = 0;
+            if (hasRowid) {
+                CHECK(GetPageStart(connection, index, start), false, "");
+            } else {
+                start = (int64) (index * pageSize);
+            }
+
+            sqlite3_reset(statement);
+            sqlite3_bind_int64(statement, 1, (sqlite3_int64) start);
+            sqlite3_bind_int64(statement, 2, (sqlite3_int64) pageSize);
+
+            page.index     = index;
+            page.rowsCount = 0;
+            page.values.clear();
+            page.bytes.clear();
+            page.values.reserve((size_t) pageSize * columnsCount);
+
+            int64 lastRowid = start;
+            int status;
+            while ((status = sqlite3_step(statement)) == SQLITE_ROW) {
+                for (auto i = 0u; i < columnsCount; i++) {
+                    auto& value = page.values.emplace_back();
+                    value.size  = 0;
+                    switch (sqlite3_column_type(statement, (int) i)) {
+                    case SQLITE_INTEGER:
+                        value.type    = Column::Type::Integer;
+                        value.integer = sqlite3_column_int64(statement, (int) i);
+                        break;
+                    case SQLITE_FLOAT:
+                        value.type = Column::Type::Float;
+                        value.real = sqlite3_column_double(statement, (int) i);
+                        break;
+                    case SQLITE_TEXT:
+                    case SQLITE_BLOB: {
+                        const bool isText = sqlite3_column_type(statement, (int) i) == SQLITE_TEXT;
+                        const auto data   = isText ? (const uint8*) sqlite3_column_text(statement, (int) i)
+                                                   : (const uint8*) sqlite3_column_blob(statement, (int) i);
+                        value.type   = isText ? Column::Type::Text : Column::Type::Blob;
+                        value.size   = (uint32) sqlite3_column_bytes(statement, (int) i);
+                        value.offset = page.bytes.size();
+                        page.bytes.insert(page.bytes.end(), data, data + value.size);
+                    } break;
+                    default:
+                        value.type    = Column::Type::Null;
+                        value.integer = 0;
+                        break;
+                    }
+                }
+                if (hasRowid) {
+                    lastRowid = sqlite3_column_int64(statement, (int) columnsCount);
+                }
+                page.rowsCount++;
+            }
+            sqlite3_reset(statement);
+            CHECK(status == SQLITE_DONE, false, "");
+
+            std::scoped_lock guard(lock);
+            if (hasRowid && page.rowsCount > 0) {
+                pageLastRowid[index] = lastRowid;
+            }
+            if (page.rowsCount < pageSize && (page.rowsCount > 0 || index == 0)) {
+                // reading past the last row gives the exact count for free
+                rowsCount      = (int64) (index * pageSize + page.rowsCount);
+                rowsCountExact = true;
+            }
+            return true;
+        }
+
+        void PrefetchLoop()
+        {
+            Page page;
+            while (true) {
+                uint64 index;
+                {
+                    std::unique_lock guard(lock);
+                    wake.wait(guard, [this] { return stop || prefetchRequest != NO_PAGE; });
+                    if (stop) {
+                        return;
+                    }
+                    index           = prefetchRequest;
+                    prefetchRequest = NO_PAGE;
+                    if (FindPage(index)) {
+                        continue;
+                    }
+                }
+                if (ReadPage(prefetch, index, page) && page.rowsCount > 0) {
+                    std::scoped_lock guard(lock);
+                    StorePage(std::move(page));
+                }
+            }
+        }
+
+        void CountRows()
+        {
+            sqlite3_stmt* statement = nullptr;
+
+            // ANALYZE keeps the rows count as the first number of the stat column
+            if (sqlite3_prepare_v2(count.db, "SELECT stat FROM sqlite_stat1 WHERE tbl = ?1 LIMIT 1;", -1, &statement, nullptr) == SQLITE_OK) {
+                sqlite3_bind_text(statement, 1, name.data(), (int) name.size(), SQLITE_TRANSIENT);
+                if (sqlite3_step(statement) == SQLITE_ROW) {
+                    const auto stat = (const char*) sqlite3_column_text(statement, 0);
+                    if (stat && *stat >= '0' && *stat <= '9') {
+                        int64 unknown = -1; // a page read may have found the exact count meanwhile
+                        rowsCount.compare_exchange_strong(unknown, (int64) std::strtoll(stat, nullptr, 10));
+                    }
+                }
+            }
+            sqlite3_finalize(statement);
+            statement = nullptr;
+
+            if (rowsCountExact) {
+                return;
+            }
+            const std::string query = "SELECT COUNT(*) FROM " + table + ";";
+            if (sqlite3_prepare_v2(count.db, query.c_str(), -1, &statement, nullptr) == SQLITE_OK && sqlite3_step(statement) == SQLITE_ROW) {
+                rowsCount      = (int64) sqlite3_column_int64(statement, 0);
+                rowsCountExact = true;
+            }
+            sqlite3_finalize(statement);
+        }
+    };
+
+    void BinaryToHex(const uint8* data, uint32 size, String& s)
+    {
+        constexpr char digits[] = "0123456789ABCDEF";
+        s.Clear();
+        for (auto i = 0u; i < size; i++) {
+            s.AddChar(digits[data[i] >> 4]);
+            s.AddChar(digits[data[i] & 0xF]);
+        }
+    }
+} // namespace
+
+Cursor Database::OpenCursor(std::string_view tableName, uint32 pageSize)
+{
+    Cursor result;
+    CHECK(handle, result, "");
+    CHECK(pageSize > 0, result, "");
+
+    const auto path = sqlite3_db_filename((sqlite3*) handle, "main");
+    CHECK(path && *path, result, "");
+
+    auto context      = std::make_unique<CursorContext>();
+    context->pageSize = pageSize;
+    context->name     = tableName;
+    context->table    = "\"";
+    for (auto ch : tableName) {
+        if (ch == '"') {
+            context->table += '"';
+        }
+        context->table += ch;
+    }
+    context->table += '"';
+
+    CHECK(context->foreground.Open(path), result, "");
+    CHECK(context->prefetch.Open(path), result, "");
+    CHECK(context->count.Open(path), result, "");
+
+    // views and WITHOUT ROWID tables have no rowid -> OFFSET paging
+    {
+        sqlite3_stmt* statement = nullptr;
+        const auto query        = "SELECT rowid FROM " + context->table + " LIMIT 0;";
+        context->hasRowid       = sqlite3_prepare_v2(context->foreground.db, query.c_str(), -1, &statement, nullptr) == SQLITE_OK;
+        sqlite3_finalize(statement);
+    }
+
+    CHECK(context->Prepare(context->foreground), result, "%s", sqlite3_errmsg(context->foreground.db));
+    CHECK(context->Prepare(context->prefetch), result, "");
+
+    const auto columnsCount = sqlite3_column_count(context->foreground.readPage) - (context->hasRowid ? 1 : 0);
+    for (auto i = 0; i < columnsCount; i++) {
+        const auto name = sqlite3_column_name(context->foreground.readPage, i);
+        context->columns.emplace_back(name ? name : "");
+    }
+
+    auto raw             = context.get();
+    raw->prefetchWorker = std::thread([raw] { raw->PrefetchLoop(); });
+    raw->countWorker    = std::thread([raw] { raw->CountRows(); });
+
+    result.context = context.release();
+    return result;
+}
+
+Cursor::Cursor(Cursor&& other) noexcept
+{
+    context       = other.context;
+    other.context = nullptr;
+}
+
+Cursor& Cursor::operator=(Cursor&& other) noexcept
+{
+    std::swap(context, other.context);
+    return *this;
+}
+
+Cursor::~Cursor()
+{
+    delete reinterpret_cast<CursorContext*>(context);
+    context = nullptr;
+}
+
+uint32 Cursor::GetColumnsCount() const
+{
+    CHECK(context, 0, "");
+    return (uint32) reinterpret_cast<CursorContext*>(context)->columns.size();
+}
+
+std::string_view Cursor::GetColumnName(uint32 column) const
+{
+    CHECK(context, "", "");
+    const auto& columns = reinterpret_cast<CursorContext*>(context)->columns;
+    CHECK(column < columns.size(), "", "");
+    return columns[column];
+}
+
+AppCUI::int64 Cursor::GetRowsCount(bool& exact) const
+{
+    exact = false;
+    CHECK(context, -1, "");
+    const auto ctx = reinterpret_cast<CursorContext*>(context);
+    exact          = ctx->rowsCountExact;
+    return ctx->rowsCount;
+}
+
+bool Cursor::HasRow(uint64 row)
+{
+    String value;
+    return GetColumnsCount() > 0 && GetCell(row, 0, value);
+}
+
+bool Cursor::GetCell(uint64 row, uint32 column, String& value)
+{
+    CHECK(context, false, "");
+    const auto ctx = reinterpret_cast<CursorContext*>(context);
+    CHECK(column < ctx->columns.size(), false, "");
+
+    if (ctx->rowsCountExact && (int64) row >= ctx->rowsCount) {
+        return false;
+    }
+
+    const auto index = row / ctx->pageSize;
+    const auto inner = (uint32) (row % ctx->pageSize);
+
+    std::unique_lock guard(ctx->lock);
+    auto page = ctx->FindPage(index);
+    if (!page) {
+        guard.unlock();
+        Page newPage;
+        CHECK(ctx->ReadPage(ctx->foreground, index, newPage), false, "Unable to read page %llu", index);
+        guard.lock();
+        ctx->StorePage(std::move(newPage));
+        page = ctx->FindPage(index);
+        CHECK(page, false, "");
+    }
+
+    // sequential scrolling will most likely need the next page as well
+    if (page->rowsCount == ctx->pageSize && ctx->prefetchRequest != index + 1) {
+        bool cached = false;
+        for (const auto& p : ctx->pages) {
+            cached |= p.index == index + 1;
+        }
+        if (!cached) {
+            ctx->prefetchRequest = index + 1;
+            ctx->wake.notify_one();
+        }
+    }
+
+    if (inner >= page->rowsCount) {
+        return false;
+    }
+
+    const auto& cell = page->values[(size_t) inner * ctx->columns.size() + column];
+    switch (cell.type) {
+    case Column::Type::Integer:
+        value.SetFormat("%lld", cell.integer);
+        break;
+    case Column::Type::Float:
+        value.SetFormat("%f", cell.real);
+        break;
+    case Column::Type::Text:
+        value.Set((const char*) page->bytes.data() + cell.offset, cell.size);
+        break;
+    case Column::Type::Blob:
+        BinaryToHex(page->bytes.data() + cell.offset, cell.size, value);
+        break;
+    default:
+        value.Set("NULL");
+        break;
+    }
+    return true;
+}
+} // namespace GView::SQLite3
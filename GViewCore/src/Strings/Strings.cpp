@@ -0,0 +1,262 @@
+#include "Internal.hpp"
+
+#include <thread>
+
+namespace GView::Strings
+{
+struct TableContext {
+    std::vector<Entry> entries;
+};
+
+Settings::Settings()
+{
+    for (uint32 i = 0; i < 256; i++)
+        charset[i] = (i >= 0x20 && i < 0x7F) || (i == '\t');
+}
+
+// Scans 'p' (that starts 2 bytes before the chunk, so that a string that starts right at the beginning of the chunk can be told apart
+// from one that started before it) and keeps only the strings that start in [from, to). Strings may continue up to the end of 'p',
+// which holds at least maxLength characters after 'to' -> a longer string is always cut to the same maxLength prefix, whatever the
+// chunk it starts in, and its rest is never reported on its own.
+static void ScanChunk(const uint8* p, uint32 size, uint32 from, uint32 to, uint64 base, const Settings& settings, std::vector<Entry>& output)
+{
+    const auto* cs       = settings.charset;
+    const auto minLength = std::max<uint32>(settings.minLength, 1);
+    const auto maxLength = settings.maxLength;
+
+    if (settings.HasEncoding(Encoding::Ascii)) {
+        uint32 i = 0;
+        while (i < to) {
+            while ((i < to) && (!cs[p[i]]))
+                i++;
+            if (i >= to)
+                break;
+            auto j = i;
+            while ((j < size) && (cs[p[j]]))
+                j++;
+            if ((i >= from) && (j - i >= minLength))
+                output.push_back({ base + i, std::min<uint32>(j - i, maxLength), Encoding::Ascii });
+            i = j;
+        }
+    }
+
+    // UTF-16 strings are checked on both alignments; 'lo' is the offset of the character byte within a code unit
+    for (auto encoding : { Encoding::UTF16LE, Encoding::UTF16BE }) {
+        if (!settings.HasEncoding(encoding))
+            continue;
+        const uint32 lo = encoding == Encoding::UTF16LE ? 0 : 1;
+        const uint32 hi = 1 - lo;
+        for (uint32 alignment = 0; alignment < 2; alignment++) {
+            uint32 i = alignment;
+            while ((i < to) && (i + 1 < size)) {
+                if ((!cs[p[i + lo]]) || (p[i + hi] != 0)) {
+                    i += 2;
+                    continue;
+                }
+                auto j = i;
+                while ((j + 1 < size) && (cs[p[j + lo]]) && (p[j + hi] == 0))
+                    j += 2;
+                if ((i >= from) && (((j - i) >> 1) >= minLength))
+                    output.push_back({ base + i, std::min<uint32>(j - i, maxLength * 2), encoding });
+                i = j;
+            }
+        }
+    }
+
+    std::sort(output.begin(), output.end(), [](const Entry& a, const Entry& b) {
+        if (a.offset == b.offset)
+            return a.encoding < b.encoding;
+        return a.offset < b.offset;
+    });
+}
+
+// the same UTF-16 text is usually also a (shifted by one byte) string of the other endianess --> keep only the longest one
+static void RemoveOverlappingUTF16(std::vector<Entry>& entries)
+{
+    size_t lastUTF16 = SIZE_MAX;
+    size_t out       = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto e = entries[i];
+        if (e.encoding != Encoding::Ascii && lastUTF16 != SIZE_MAX) {
+            const auto& last = entries[lastUTF16];
+            if ((last.encoding != e.encoding) && (e.offset < last.offset + last.size)) {
+                if (e.size > last.size)
+                    entries[lastUTF16] = e; // replace the previous (shorter) one
+                continue;
+            }
+        }
+        if (e.encoding != Encoding::Ascii)
+            lastUTF16 = out;
+        entries[out++] = e;
+    }
+    entries.resize(out);
+}
+
+Table::Table()
+{
+    context = new TableContext();
+}
+
+Table::~Table()
+{
+    delete reinterpret_cast<TableContext*>(context);
+    context = nullptr;
+}
+
+void Table::Clear()
+{
+    reinterpret_cast<TableContext*>(context)->entries.clear();
+}
+
+bool Table::Build(Utils::DataCache& cache, const Settings& settings, uint64 offset, uint64 size)
+{
+    auto ctx = reinterpret_cast<TableContext*>(context);
+    ctx->entries.clear();
+
+    const auto fileSize = cache.GetSize();
+    CHECK(offset <= fileSize, false, "Invalid offset (%llu)", offset);
+    size            = std::min<uint64>(size, fileSize - offset);
+    const auto end  = offset + size;
+    CHECK(settings.chunkSize > 0, false, "Invalid chunk size");
+    CHECK(settings.maxLength >= std::max<uint32>(settings.minLength, 1), false, "Invalid maximum length (%u)", settings.maxLength);
+    CHECK(settings.encodings != Encoding::None, false, "No encoding selected");
+
+    auto workers = settings.threadsCount;
+    if (workers == 0)
+        workers = std::max<uint32>(std::thread::hardware_concurrency(), 1);
+
+    const auto overlap = settings.maxLength * 2;
+    std::vector<Buffer> buffers(workers);
+    std::vector<std::vector<Entry>> results(workers);
+    std::vector<uint64> bases(workers);
+    std::vector<uint32> starts(workers), ends(workers);
+
+    for (uint64 batchStart = offset; batchStart < end;) {
+        // read a batch of chunks (DataCache is not thread safe, so all the reads happen here)
+        uint32 count = 0;
+        for (; (count < workers) && (batchStart < end); count++) {
+            const auto chunkEnd  = std::min<uint64>(end, batchStart + settings.chunkSize);
+            const auto readStart = batchStart - std::min<uint64>(batchStart - offset, 2);
+            const auto readEnd   = std::min<uint64>(end, chunkEnd + overlap);
+            buffers[count]       = cache.CopyToBuffer(readStart, static_cast<uint32>(readEnd - readStart), false);
+            CHECK(buffers[count].IsValid(), false, "Fail to read %llu bytes from %llu", readEnd - readStart, readStart);
+            bases[count]  = readStart;
+            starts[count] = static_cast<uint32>(batchStart - readStart);
+            ends[count]   = static_cast<uint32>(std::min<uint64>(chunkEnd - readStart, buffers[count].GetLength()));
+            results[count].clear();
+            batchStart = chunkEnd;
+        }
+
+        // classify them in parallel
+        auto scan = [&](uint32 index) {
+            ScanChunk(buffers[index].GetData(),
+                      static_cast<uint32>(buffers[index].GetLength()),
+                      starts[index],
+                      ends[index],
+                      bases[index],
+                      settings,
+                      results[index]);
+        };
+        if (count == 1) {
+            scan(0);
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(count);
+            for (uint32 index = 0; index < count; index++)
+                threads.emplace_back(scan, index);
+            for (auto& t : threads)
+                t.join();
+        }
+
+        // chunks are in order and each one is sorted --> appending keeps the table sorted
+        for (uint32 index = 0; index < count; index++)
+            ctx->entries.insert(ctx->entries.end(), results[index].begin(), results[index].end());
+    }
+
+    RemoveOverlappingUTF16(ctx->entries);
+    return true;
+}
+
+uint64 Table::GetCount() const
+{
+    return reinterpret_cast<TableContext*>(context)->entries.size();
+}
+
+bool Table::GetEntry(uint64 index, Entry& entry) const
+{
+    auto ctx = reinterpret_cast<TableContext*>(context);
+    CHECK(index < ctx->entries.size(), false, "Invalid index: %llu", index);
+    entry = ctx->entries[index];
+    return true;
+}
+
+bool Table::GetText(Utils::DataCache& cache, const Entry& entry, std::string& text) const
+{
+    text.clear();
+    CHECK(entry.size > 0, false, "");
+    const auto buf = cache.Get(entry.offset, entry.size, true);
+    CHECK(buf.IsValid(), false, "Fail to read %u bytes from %llu", entry.size, entry.offset);
+
+    switch (entry.encoding) {
+    case Encoding::Ascii:
+        text.assign(reinterpret_cast<const char*>(buf.GetData()), buf.GetLength());
+        return true;
+    case Encoding::UTF16LE:
+    case Encoding::UTF16BE: {
+        const uint32 lo = entry.encoding == Encoding::UTF16LE ? 0 : 1;
+        text.reserve(entry.GetLength());
+        for (uint32 i = 0; i + 1 < buf.GetLength(); i += 2)
+            text.push_back(static_cast<char>(buf[i + lo]));
+        return true;
+    }
+    default:
+        RETURNERROR(false, "Invalid encoding");
+    }
+}
+
+bool Table::WriteTo(Utils::DataCache& cache, std::u16string_view path) const
+{
+    auto ctx = reinterpret_cast<TableContext*>(context);
+
+    AppCUI::OS::File f;
+    CHECK(f.Create(path, true), false, "Fail to create output file");
+
+    // entries are formatted into a buffer that is flushed to disk each time it gets big enough
+    constexpr size_t FLUSH_SIZE = 0x100000;
+    std::string out;
+    out.reserve(FLUSH_SIZE + 0x1000);
+    std::string text;
+    LocalString<64> tmp;
+
+    for (const auto& e : ctx->entries) {
+        if (!GetText(cache, e, text))
+            continue;
+        out.append(tmp.Format("%016llX\t%s\t", e.offset, GetEncodingName(e.encoding).data()));
+        out.append(text);
+        out.push_back('\n');
+        if (out.size() >= FLUSH_SIZE) {
+            CHECK(f.Write(out.data(), static_cast<uint32>(out.size())), false, "Fail to write to output file");
+            out.clear();
+        }
+    }
+    if (!out.empty()) {
+        CHECK(f.Write(out.data(), static_cast<uint32>(out.size())), false, "Fail to write to output file");
+    }
+    f.Close();
+    return true;
+}
+
+std::string_view Table::GetEncodingName(Encoding encoding)
+{
+    switch (encoding) {
+    case Encoding::Ascii:
+        return "Ascii";
+    case Encoding::UTF16LE:
+        return "UTF-16LE";
+    case Encoding::UTF16BE:
+        return "UTF-16BE";
+    default:
+        return "Unknown";
+    }
+}
+} // namespace GView::Strings
@@ -5,7 +5,67 @@ using namespace AppCUI::Graphics;
 
 struct ZonesListContext {
     std::vector<Zone> zones{};
-    std::vector<Zone> cache{};
+
+    // lookup index built on demand after zones are added:
+    // sorted  -> zones sorted by (low asc, high desc)
+    // maxHigh -> segment tree over sorted: maxHigh[node] = max(interval.high) of the zones under node (leaves start at 'leaves')
+    std::vector<Zone> sorted{};
+    std::vector<uint64> maxHigh{};
+    size_t leaves{ 0 };
+    bool indexIsValid{ false };
+
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+    void BuildIndex()
+    {
+        if (indexIsValid) {
+            return;
+        }
+
+        sorted = zones;
+        std::sort(sorted.begin(), sorted.end(), [](const Zone& a, const Zone& b) {
+            if (a.interval.low == b.interval.low) {
+                return a.interval.high > b.interval.high;
+            }
+            return a.interval.low < b.interval.low;
+        });
+
+        leaves = 1;
+        while (leaves < sorted.size()) {
+            leaves <<= 1;
+        }
+        maxHigh.assign(leaves * 2, 0);
+        for (size_t i = 0; i < sorted.size(); i++) {
+            maxHigh[leaves + i] = sorted[i].interval.high;
+        }
+        for (size_t node = leaves - 1; node > 0; node--) {
+            maxHigh[node] = std::max<>(maxHigh[node * 2], maxHigh[node * 2 + 1]);
+        }
+
+        indexIsValid = true;
+    }
+
+    // the greatest index in [0, count) of a zone that ends at or after position (NOT_FOUND if there is none)
+    size_t FindLast(size_t node, size_t nodeStart, size_t nodeSize, size_t count, uint64 position) const
+    {
+        if ((nodeStart >= count) || (maxHigh[node] < position)) {
+            return NOT_FOUND;
+        }
+        if (nodeSize == 1) {
+            return nodeStart;
+        }
+        const auto half  = nodeSize / 2;
+        const auto found = FindLast(node * 2 + 1, nodeStart + half, half, count, position);
+        return found != NOT_FOUND ? found : FindLast(node * 2, nodeStart, half, count, position);
+    }
+
+    // index of the first zone whose start is greater than position
+    size_t UpperBound(uint64 position) const
+    {
+        const auto it = std::upper_bound(
+              sorted.begin(), sorted.end(), position, [](uint64 value, const Zone& zone) { return value < zone.interval.low; });
+        return static_cast<size_t>(it - sorted.begin());
+    }
 };
 
 ZonesList::ZonesList()
@@ -13,6 +73,19 @@ ZonesList::ZonesList()
     context = new ZonesListContext;
 }
 
+ZonesList::ZonesList(const ZonesList& other)
+{
+    context = new ZonesListContext(*reinterpret_cast<ZonesListContext*>(other.context));
+}
+
+ZonesList& ZonesList::operator=(const ZonesList& other)
+{
+    if (this != &other) {
+        *reinterpret_cast<ZonesListContext*>(context) = *reinterpret_cast<ZonesListContext*>(other.context);
+    }
+    return *this;
+}
+
 ZonesList::~ZonesList()
 {
     if (context != nullptr) {
@@ -25,6 +98,7 @@ bool ZonesList::Add(uint64 s, uint64 e, ColorPair c, std::string_view txt)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(s, e, c, txt);
+    ctx->indexIsValid = false;
     return true;
 }
 
@@ -33,6 +107,7 @@ bool ZonesList::Add(const Zone& zone)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(zone);
+    ctx->indexIsValid = false;
     return true;
 }
 
@@ -40,36 +115,37 @@ std::optional<Zone> ZonesList::OffsetToZone(uint64 position) const
 {
     CHECK(context != nullptr, std::nullopt, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+    ctx->BuildIndex();
 
-    for (const auto& zone : ctx->cache) {
-        if (zone.interval.low <= position && position <= zone.interval.high) {
-            return zone;
-        }
+    // among the zones that start at or before position, the last one (greatest start -> innermost) that still reaches it
+    const auto index = ctx->FindLast(1, 0, ctx->leaves, ctx->UpperBound(position), position);
+    if (index == ZonesListContext::NOT_FOUND) {
+        return std::nullopt;
     }
-
-    return std::nullopt;
+    return ctx->sorted[index];
 }
 
-bool ZonesList::SetCache(const Zone::Interval& interval)
+std::optional<Zone> ZonesList::OffsetToNextZone(uint64 position) const
 {
-    CHECK(context != nullptr, false, "");
+    CHECK(context != nullptr, std::nullopt, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+    ctx->BuildIndex();
 
-    ctx->cache.clear();
-
-    for (const auto& zone : ctx->zones) {
-        if ((zone.interval.low >= interval.low && zone.interval.low <= interval.high) ||
-            interval.low >= zone.interval.low && interval.low <= zone.interval.high) {
-            ctx->cache.push_back(zone);
-        }
+    // no zone after position is not an error (the cursor is after the last zone)
+    const auto index = ctx->UpperBound(position);
+    if (index >= ctx->sorted.size()) {
+        return std::nullopt;
     }
+    return ctx->sorted[index];
+}
 
-    std::sort(ctx->cache.begin(), ctx->cache.end(), [](const Zone& a, const Zone& b) {
-        if (a.interval.low == b.interval.low) {
-            return a.interval.high < b.interval.high;
-        }
-        return a.interval.low > b.interval.low;
-    });
+bool ZonesList::SetCache(const Zone::Interval&)
+{
+    CHECK(context != nullptr, false, "");
+    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+
+    // the index already answers any lookup in O(log n); we only make sure it is built before the paint starts
+    ctx->BuildIndex();
 
     return true;
 }
@@ -80,7 +156,10 @@ void ZonesList::Clear()
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
     ctx->zones.clear();
-    ctx->cache.clear();
+    ctx->sorted.clear();
+    ctx->maxHigh.clear();
+    ctx->leaves       = 0;
+    ctx->indexIsValid = false;
 }
 
 uint32 ZonesList::GetCount() const
@@ -2,6 +2,8 @@
 
 #include "Internal.hpp"
 
+#include <unordered_map>
+
 namespace GView::View::BufferViewer
 {
 using namespace AppCUI;
@@ -67,6 +69,55 @@ struct Config {
     void Initialize();
 };
 
+class StringsMap
+{
+  public:
+    struct Run {
+        uint64 start; // first byte of the run
+        uint64 end;   // first byte after the run
+        StringType type;
+
+        inline uint64 GetMiddle() const
+        {
+            return start + ((end - start) >> 1);
+        }
+    };
+
+  private:
+    // the object is indexed lazily, one block at a time; a run belongs to the block where it starts. Strings are searched
+    // independently inside each SEGMENT_SIZE part of the object (a longer string is split at the segment boundary),
+    // which bounds how far before or after a block has to be read to find the runs that cross it.
+    static constexpr uint32 BLOCK_SIZE        = 0x10000;
+    static constexpr uint32 BLOCK_LOOKBACK    = 0x1000;
+    static constexpr uint32 BLOCK_EXTRA       = 0x10000;
+    static constexpr uint32 SEGMENT_SIZE      = 0x100000;
+    static constexpr uint64 MAX_SEARCH_BLOCKS = 0x100; // blocks visited by GetNextRun / GetPreviousRun
+
+    struct Block {
+        std::vector<Run> runs;
+        Run carried{ 0, 0, StringType::None }; // a run that started in a previous block and covers the first byte of this one
+    };
+
+    std::unordered_map<uint64, Block> blocks;
+    bool asciiMask[256]{};
+    uint32 minCount{ 0 };
+    bool showAscii{ false };
+    bool showUnicode{ false };
+
+    const Block& GetBlock(GView::Utils::DataCache& cache, uint64 blockIndex);
+    bool ScanBuffer(const uint8* p, uint32 size, uint32 from, uint32 startLimit, uint32 endLimit, uint64 base, Block& block) const;
+
+  public:
+    void Clear();
+    void Update(const bool mask[256], uint32 minCount, bool showAscii, bool showUnicode);
+
+    // returns the run that contains 'offset' or (with StringType::None) the gap between two runs that contains it
+    Run OffsetToRun(GView::Utils::DataCache& cache, uint64 offset);
+    // both look at most MAX_SEARCH_BLOCKS blocks away from 'offset'
+    std::optional<Run> GetNextRun(GView::Utils::DataCache& cache, uint64 offset);
+    std::optional<Run> GetPreviousRun(GView::Utils::DataCache& cache, uint64 offset);
+};
+
 class FindDialog : public Window, public Handlers::OnCheckInterface
 {
   private:
@@ -242,14 +293,13 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     } cursor;
 
     struct {
-        uint64 start, end, middle;
         uint32 minCount{ 4 };
         bool AsciiMask[256];
-        StringType type;
         String asciiMaskRepr;
         bool showAscii{ true };
         bool showUnicode{ true };
     } StringInfo;
+    StringsMap stringsMap;
 
     struct {
         ColorPair Normal, Line, Highlighted;
@@ -270,6 +320,30 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
         }
     } CurrentSelection;
 
+    enum class TextKind : uint8 { Byte, UnicodeCharacter, UnicodeBlank };
+    struct ViewCharacterInfo {
+        ColorPair color;
+        TextKind kind;
+        uint8 unicodeCharacter;
+    };
+    struct {
+        std::vector<ViewCharacterInfo> characters;
+        std::vector<BufferColor> typeSpans;
+        Buffer bytes;
+        uint64 start{ GView::Utils::INVALID_OFFSET };
+        uint64 cursorPosition{ GView::Utils::INVALID_OFFSET };
+        bool valid{ false };
+
+        inline void Invalidate()
+        {
+            valid = false;
+        }
+        inline const ViewCharacterInfo& Get(uint64 offset) const
+        {
+            return characters[offset - start];
+        }
+    } ViewColors;
+
     bool showSyncCompare{ false };
     bool moveInSync{ false };
     bool showTypeObjects{ true };
@@ -313,13 +387,13 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     void MoveTillEndBlock(bool selected);
     void MoveTillNextBlock(bool select, int dir);
 
-    void UpdateStringInfo(uint64 offset);
     void ResetStringInfo();
+    void MoveToString(bool next, bool select);
     std::string_view GetAsciiMaskStringRepresentation();
     bool SetStringAsciiMask(string_view stringRepresentation);
 
     ColorPair OffsetToColorZone(uint64 offset);
-    ColorPair OffsetToColor(uint64 offset);
+    void ComputeViewColors();
 
     void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
@@ -411,6 +485,7 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     bool SetZones(const GView::Utils::ZonesList& zones) override
     {
         this->settings->zListObjects.Clear();
+        this->ViewColors.Invalidate();
 
         for (uint32 i = 0; i < zones.GetCount(); i++) {
             const auto zone = zones.GetZone(i);
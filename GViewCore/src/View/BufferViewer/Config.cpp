@@ -221,6 +221,7 @@ bool Instance::GetPropertyValue(uint32 id, PropertyValue& value)
 }
 bool Instance::SetPropertyValue(uint32 id, const PropertyValue& value, String& error)
 {
+    this->ViewColors.Invalidate();
     uint32 tmpValue;
     switch (static_cast<PropertyID>(id)) {
     case PropertyID::Columns:
@@ -73,6 +73,7 @@ bool Instance::SetOnStartViewMoveCallback(Reference<OnStartViewMoveInterface> cb
 bool Instance::SetBufferColorProcessorCallback(Reference<BufferColorInterface> cbk)
 {
     this->settings->bufferColorCallback = cbk;
+    this->ViewColors.Invalidate();
     return true;
 }
 
@@ -141,6 +142,7 @@ void Instance::OpenCurrentSelection()
 }
 void Instance::UpdateCurrentSelection()
 {
+    this->ViewColors.Invalidate();
     this->CurrentSelection.size  = 0;
     this->CurrentSelection.start = GView::Utils::INVALID_OFFSET;
     this->CurrentSelection.end   = GView::Utils::INVALID_OFFSET;
@@ -352,6 +354,9 @@ void Instance::MoveToZone(bool startOfZone, bool select)
 {
     if (auto z = settings->zList.OffsetToZone(this->cursor.GetCurrentPosition())) {
         MoveTo(startOfZone ? z->interval.low : z->interval.high, select);
+    } else if (auto next = settings->zList.OffsetToNextZone(this->cursor.GetCurrentPosition())) {
+        // not inside a zone --> jump to the closest zone that follows the cursor
+        MoveTo(next->interval.low, select);
     }
 }
 
@@ -404,102 +409,17 @@ bool Instance::ShowDissasmDialog()
 
 void Instance::ResetStringInfo()
 {
-    StringInfo.start  = GView::Utils::INVALID_OFFSET;
-    StringInfo.end    = GView::Utils::INVALID_OFFSET;
-    StringInfo.middle = GView::Utils::INVALID_OFFSET;
-    StringInfo.type   = StringType::None;
+    this->stringsMap.Clear();
+    this->ViewColors.Invalidate();
 }
-void Instance::UpdateStringInfo(uint64 offset)
+void Instance::MoveToString(bool next, bool select)
 {
-    auto buf = this->obj->GetData().Get(offset, 1024, false);
-    if (!buf.IsValid()) {
-        ResetStringInfo();
-        return;
-    }
-
-    // check for ascii
-    if (this->StringInfo.showAscii) {
-        auto* s = buf.GetData();
-        auto* e = s + buf.GetLength();
-
-        if (StringInfo.AsciiMask[*s]) {
-            while ((s < e) && (StringInfo.AsciiMask[*s]))
-                s++;
-            if (s - buf.GetData() >= StringInfo.minCount) {
-                // ascii string found
-                StringInfo.start = offset;
-                StringInfo.end   = offset + (s - buf.GetData());
-                StringInfo.type  = StringType::Ascii;
-                return;
-            }
-        }
-    }
-
-    // check for unicode
-    if (this->StringInfo.showUnicode) {
-        auto* s = (char16*) buf.GetData();
-        auto* e = s + buf.GetLength() / 2;
-        if ((s < e) && ((*s) < 256) && (StringInfo.AsciiMask[*s])) {
-            while ((s < e) && ((*s) < 256) && (StringInfo.AsciiMask[*s]))
-                s++;
-            if (s - (char16*) buf.GetData() >= StringInfo.minCount) {
-                // ascii string found
-                StringInfo.start  = offset;
-                StringInfo.end    = offset + ((const uint8*) s - buf.GetData());
-                StringInfo.middle = offset + (s - (char16*) buf.GetData());
-                StringInfo.type   = StringType::Unicode;
-                return;
-            }
-        }
-    }
-
-    // compute the size of non-string data
-    StringInfo.start  = offset;
-    StringInfo.middle = GView::Utils::INVALID_OFFSET;
-    StringInfo.type   = StringType::None;
-
-    {
-        auto* s = buf.GetData();
-        auto* e = s + buf.GetLength();
-
-        while (s < e) {
-            while ((s < e) && (!StringInfo.AsciiMask[*s]))
-                s++;
-            if (s == e)
-                break;
-            // reached a possible string --> check for minim size
-            auto* s_s = s;
-            auto* s_e = s + StringInfo.minCount;
-            if (s_e <= e) {
-                while ((s_s < s_e) && (StringInfo.AsciiMask[*s_s]))
-                    s_s++;
-                if (s_s == s_e) {
-                    // found a possible string at 's' position --> stop before 's'
-                    StringInfo.end = offset + (s - buf.GetData());
-                    return;
-                }
-            }
-            // check if not an unicode string
-            auto* u_s = (char16_t*) s;
-            auto* u_e = u_s + StringInfo.minCount;
-            if ((((const uint8*) u_e) + 1) <= e) {
-                while ((u_s < u_e) && (*u_s < 256) && (StringInfo.AsciiMask[*u_s]))
-                    u_s++;
-                if (u_s == u_e) {
-                    // found a possible unicode at 's' position --> stop before 's'
-                    StringInfo.end = offset + (s - buf.GetData());
-                    return;
-                }
-            }
-            // no possible string found --> advance to next non_ascii character
-            if (s_s > s)
-                s = s_s;
-            else
-                s++; // move to next
-        }
+    this->stringsMap.Update(StringInfo.AsciiMask, StringInfo.minCount, StringInfo.showAscii, StringInfo.showUnicode);
+    const auto pos = this->cursor.GetCurrentPosition();
+    const auto run = next ? this->stringsMap.GetNextRun(this->obj->GetData(), pos) : this->stringsMap.GetPreviousRun(this->obj->GetData(), pos);
+    if (run.has_value()) {
+        MoveTo(run->start, select);
     }
-    // all buffer was process and nothing was found
-    StringInfo.end = offset + buf.GetLength();
 }
 std::string_view Instance::GetAsciiMaskStringRepresentation()
 {
@@ -527,91 +447,142 @@ ColorPair Instance::OffsetToColorZone(uint64 offset)
 
     return Cfg.Text.Inactive;
 }
-ColorPair Instance::OffsetToColor(uint64 offset)
+void Instance::ComputeViewColors()
 {
-    // current selection
-    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight)) {
-        if ((offset >= this->CurrentSelection.start) && (offset < this->CurrentSelection.end))
-            return Cfg.Selection.SimilarText;
-
-        auto b = this->obj->GetData().Get(offset, this->CurrentSelection.size, true);
-        if (b.IsValid()) {
-            if (b[0] == this->CurrentSelection.buffer[0]) {
-                if (memcmp(b.begin(), this->CurrentSelection.buffer, this->CurrentSelection.size) == 0) {
-                    this->CurrentSelection.start = offset;
-                    this->CurrentSelection.end   = offset + this->CurrentSelection.size;
-                    return Cfg.Selection.SimilarText;
-                }
-            }
-        }
+    const auto startView = cursor.GetStartView();
+    const auto fileSize  = obj->GetData().GetSize();
+    const auto viewSize  = std::min<uint64>(static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows, fileSize - std::min<>(startView, fileSize));
+    const bool useByteCallback = (showCodeExecution || showSyncCompare) && settings && settings->bufferColorCallback;
+
+    if (ViewColors.valid && ViewColors.start == startView && ViewColors.characters.size() == viewSize &&
+        (!useByteCallback || ViewColors.cursorPosition == cursor.GetCurrentPosition())) {
+        return; // nothing changed since the last paint
+    }
+
+    ViewColors.start          = startView;
+    ViewColors.cursorPosition = cursor.GetCurrentPosition();
+    ViewColors.characters.resize(viewSize);
+    ViewColors.typeSpans.clear();
+    ViewColors.valid = true;
+    if (viewSize == 0) {
+        return;
     }
 
-    // color
-    if (settings) {
-        if (showObjectsHighlighting) {
-            if (auto z = this->settings->zListObjects.OffsetToZone(offset)) {
-                return z->color;
+    // one copy of the visible bytes (plus some extra bytes for patterns that start in view and end outside it)
+    const auto toRead = static_cast<uint32>(std::min<uint64>(viewSize + sizeof(CurrentSelection.buffer), fileSize - startView));
+    ViewColors.bytes  = obj->GetData().CopyToBuffer(startView, toRead, false);
+    const auto* bytes = ViewColors.bytes.GetData();
+    const auto bytesCount = static_cast<uint32>(ViewColors.bytes.GetLength());
+
+    // all type object colors for the view in a single call
+    if (showTypeObjects && settings && settings->positionToColorCallback && !showObjectsHighlighting) {
+        settings->positionToColorCallback->GetColorsForBuffer(
+              startView,
+              BufferView(bytes, std::min<uint32>(bytesCount, static_cast<uint32>(viewSize) + 15)),
+              static_cast<uint32>(viewSize),
+              ViewColors.typeSpans);
+    }
+    auto typeSpan        = ViewColors.typeSpans.cbegin();
+    const auto typeSpanE = ViewColors.typeSpans.cend();
+
+    const ViewData vd{ .viewStartOffset   = startView,
+                       .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
+                       .cursorStartOffset = cursor.GetCurrentPosition(),
+                       .byte              = 0 };
+    BufferColor byteColor;
+    byteColor.Reset();
+
+    const bool showStrings = this->StringInfo.showAscii || this->StringInfo.showUnicode;
+    this->stringsMap.Update(StringInfo.AsciiMask, StringInfo.minCount, StringInfo.showAscii, StringInfo.showUnicode);
+    StringsMap::Run stringRun{ GView::Utils::INVALID_OFFSET, GView::Utils::INVALID_OFFSET, StringType::None };
+
+    for (uint32 index = 0; index < viewSize; index++) {
+        const auto offset = startView + index;
+        auto& info        = ViewColors.characters[index];
+        info.kind         = TextKind::Byte;
+        info.color        = Cfg.Text.Inactive;
+
+        // current selection
+        if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight)) {
+            if ((offset >= this->CurrentSelection.start) && (offset < this->CurrentSelection.end)) {
+                info.color = Cfg.Selection.SimilarText;
+                continue;
+            }
+            if ((index < bytesCount) && (bytes[index] == this->CurrentSelection.buffer[0]) &&
+                (index + this->CurrentSelection.size <= bytesCount) &&
+                (memcmp(bytes + index, this->CurrentSelection.buffer, this->CurrentSelection.size) == 0)) {
+                this->CurrentSelection.start = offset;
+                this->CurrentSelection.end   = offset + this->CurrentSelection.size;
+                info.color                   = Cfg.Selection.SimilarText;
+                continue;
             }
-            return Cfg.Text.Inactive;
         }
 
-        if ((showCodeExecution || showSyncCompare) && settings->bufferColorCallback) {
-            if ((offset >= bufColor.start) && (offset <= bufColor.end))
-                return bufColor.color;
-
-            if (cursor.GetStartView() <= offset) {
-                auto b = this->obj->GetData().Get(offset, 1, true);
-                if (b.IsValid()) {
-                    if (settings->bufferColorCallback->GetColorForByteAt(
-                              offset,
-                              ViewData{ .viewStartOffset   = cursor.GetStartView(),
-                                        .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
-                                        .cursorStartOffset = cursor.GetCurrentPosition(),
-                                        .byte              = b.GetData()[0] },
-                              bufColor.color)) {
-                        bufColor.start = offset;
-                        bufColor.end   = offset;
-                        return bufColor.color;
-                    }
+        if (settings) {
+            if (showObjectsHighlighting) {
+                if (auto z = this->settings->zListObjects.OffsetToZone(offset)) {
+                    info.color = z->color;
                 }
+                continue;
             }
-            // no color provided for the specific buffer --> check show types
-        }
 
-        if (showTypeObjects && settings->positionToColorCallback) {
-            if ((offset >= bufColor.start) && (offset <= bufColor.end))
-                return bufColor.color;
-            if (settings->positionToColorCallback->GetColorForBuffer(offset, this->obj->GetData().Get(offset, 16, false), bufColor))
-                return bufColor.color;
+            if (useByteCallback && index < bytesCount) {
+                if ((offset >= byteColor.start) && (offset <= byteColor.end)) {
+                    info.color = byteColor.color;
+                    continue;
+                }
+                auto byteVD = vd;
+                byteVD.byte = bytes[index];
+                if (settings->bufferColorCallback->GetColorForByteAt(offset, byteVD, byteColor.color)) {
+                    byteColor.start = offset;
+                    byteColor.end   = offset;
+                    info.color      = byteColor.color;
+                    continue;
+                }
+                // no color provided for the specific buffer --> check show types
+            }
 
+            while ((typeSpan != typeSpanE) && (typeSpan->end < offset)) {
+                typeSpan++;
+            }
+            if ((typeSpan != typeSpanE) && (offset >= typeSpan->start)) {
+                info.color = typeSpan->color;
+                continue;
+            }
             // no color provided for the specific buffer --> check strings and zones
         }
-    }
 
-    // check strings
-    if (this->StringInfo.showAscii || this->StringInfo.showUnicode) {
-        if ((offset >= StringInfo.start) && (offset < StringInfo.end)) {
-            switch (StringInfo.type) {
+        // check strings
+        if (showStrings) {
+            if ((offset < stringRun.start) || (offset >= stringRun.end)) {
+                stringRun = this->stringsMap.OffsetToRun(obj->GetData(), offset);
+                if (stringRun.type == StringType::Unicode) {
+                    // make sure that the characters that will be displayed are in the cache
+                    const auto first = stringRun.start + ((offset - stringRun.start) << 1);
+                    if (first < stringRun.end) {
+                        obj->GetData().Get(first, static_cast<uint32>(std::min<uint64>(stringRun.end - first, obj->GetData().GetCacheSize())), false);
+                    }
+                }
+            }
+            switch (stringRun.type) {
             case StringType::Ascii:
-                return config.Colors.Ascii;
+                info.color = config.Colors.Ascii;
+                continue;
             case StringType::Unicode:
-                return config.Colors.Unicode;
-            }
-        } else {
-            UpdateStringInfo(offset);
-            if ((offset >= StringInfo.start) && (offset < StringInfo.end)) {
-                switch (StringInfo.type) {
-                case StringType::Ascii:
-                    return config.Colors.Ascii;
-                case StringType::Unicode:
-                    return config.Colors.Unicode;
+                info.color = config.Colors.Unicode;
+                if (offset >= stringRun.GetMiddle()) {
+                    info.kind = TextKind::UnicodeBlank;
+                } else {
+                    info.kind             = TextKind::UnicodeCharacter;
+                    info.unicodeCharacter = obj->GetData().GetFromCache(((offset - stringRun.start) << 1) + stringRun.start);
                 }
+                continue;
             }
         }
-    }
 
-    // not a string --> check the zone
-    return OffsetToColorZone(offset);
+        // not a string --> check the zone
+        info.color = OffsetToColorZone(offset);
+    }
 }
 
 void Instance::UpdateViewSizes()
@@ -823,16 +794,20 @@ void Instance::WriteLineTextToChars(DrawLineInfo& dli)
         const auto startCh  = dli.chText;
         const auto ofsStart = dli.offset;
         while (dli.start < dli.end) {
-            cp = OffsetToColor(dli.offset);
+            const auto& info = ViewColors.Get(dli.offset);
+            cp               = info.color;
             if (selection.Contains(dli.offset))
                 cp = Cfg.Selection.Editor;
-            if (StringInfo.type == StringType::Unicode) {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            } else {
+            switch (info.kind) {
+            case TextKind::UnicodeBlank:
+                dli.chText->Code = ' ';
+                break;
+            case TextKind::UnicodeCharacter:
+                dli.chText->Code = codePage[info.unicodeCharacter];
+                break;
+            default:
                 dli.chText->Code = codePage[*dli.start];
+                break;
             }
             dli.chText->Color = cp;
             dli.chText++;
@@ -864,7 +839,7 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
 
     while (dli.start < dli.end) {
         if (active) {
-            cp = OffsetToColor(dli.offset);
+            cp = ViewColors.Get(dli.offset).color;
 
             if (selection.Contains(dli.offset)) {
                 cp = Cfg.Selection.Editor;
@@ -987,13 +962,17 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
         c++;
 
         if (active) {
-            if (StringInfo.type == StringType::Unicode) {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
-            } else {
+            const auto& info = ViewColors.Get(dli.offset);
+            switch (info.kind) {
+            case TextKind::UnicodeBlank:
+                dli.chText->Code = ' ';
+                break;
+            case TextKind::UnicodeCharacter:
+                dli.chText->Code = codePage[info.unicodeCharacter];
+                break;
+            default:
                 dli.chText->Code = codePage[*dli.start];
+                break;
             }
         } else {
             dli.chText->Code = codePage[*dli.start];
@@ -1037,6 +1016,9 @@ void Instance::Paint(Renderer& renderer)
     } else {
         settings->zList.SetCache({ startView, ((uint64) Layout.charactersPerLine) * (Layout.visibleRows - 1ull) + startView });
     }
+    if (this->showColorNotFocused || this->HasFocus()) {
+        ComputeViewColors();
+    }
 
     DrawLineInfo dli;
     for (uint32 tr = 0; tr < Layout.visibleRows; tr++) {
@@ -1056,6 +1038,7 @@ void Instance::Paint(Renderer& renderer)
 }
 void Instance::OnAfterResize(int width, int height)
 {
+    this->ViewColors.Invalidate();
     this->UpdateViewSizes();
 }
 bool Instance::OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar)
@@ -1248,6 +1231,13 @@ bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 charCode)
         MoveTillNextBlock(select, 1);
         return true;
 
+    case Key::Alt | Key::Left:
+        MoveToString(false, select);
+        return true;
+    case Key::Alt | Key::Right:
+        MoveToString(true, select);
+        return true;
+
     case Key::Alt | Key::N1:
         MoveToSelection(0);
         return true;
@@ -1311,6 +1301,7 @@ bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 charCode)
 bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 {
     CHECK(eventType == Event::Command, false, "");
+    this->ViewColors.Invalidate();
 
     switch (ID) {
     case BUFFERVIEW_CMD_CHANGECOL:
@@ -1463,10 +1454,12 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 void Instance::OnFocus()
 {
     cursor.SetStartView(cursor.GetStartView()); // invalidate delta;
+    this->ViewColors.Invalidate();                // colors provided by plugins might have changed meanwhile
 }
 void Instance::OnLoseFocus()
 {
     cursor.SetStartView(cursor.GetStartView()); // invalidate delta;
+    this->ViewColors.Invalidate();                // colors provided by plugins might have changed meanwhile
 }
 
 bool Instance::UpdateKeys(KeyboardControlsInterface* interface)
@@ -0,0 +1,184 @@
+#include "BufferViewer.hpp"
+
+using namespace GView::View::BufferViewer;
+
+void StringsMap::Clear()
+{
+    blocks.clear();
+}
+
+void StringsMap::Update(const bool mask[256], uint32 _minCount, bool _showAscii, bool _showUnicode)
+{
+    if ((memcmp(asciiMask, mask, sizeof(asciiMask)) == 0) && (minCount == _minCount) && (showAscii == _showAscii) && (showUnicode == _showUnicode))
+        return;
+
+    // string definition changed --> everything that was indexed so far is obsolete
+    memcpy(asciiMask, mask, sizeof(asciiMask));
+    minCount    = std::max<uint32>(_minCount, 1);
+    showAscii   = _showAscii;
+    showUnicode = _showUnicode;
+    blocks.clear();
+}
+
+// returns true if a sequence of string characters reaches the end of the buffer (the data after it is needed to know where it ends)
+bool StringsMap::ScanBuffer(const uint8* p, uint32 size, uint32 from, uint32 startLimit, uint32 endLimit, uint64 base, Block& block) const
+{
+    bool reachedEnd = false;
+    const auto add  = [&](uint32 start, uint32 end, StringType type) {
+        if (start >= startLimit)
+            block.runs.push_back({ base + start, base + end, type });
+        else if (end > startLimit)
+            block.carried = { base + start, base + end, type };
+    };
+
+    auto i = from;
+    while (i < endLimit) {
+        // fast skip over bytes that can not start a string
+        while ((i < endLimit) && (!asciiMask[p[i]]))
+            i++;
+        if (i >= endLimit)
+            break;
+
+        uint32 asciiLen = 0;
+        if (showAscii) {
+            auto j = i;
+            while ((j < size) && (asciiMask[p[j]]))
+                j++;
+            reachedEnd |= j == size;
+            asciiLen = j - i;
+            if (asciiLen >= minCount) {
+                add(i, j, StringType::Ascii);
+                i = j;
+                continue;
+            }
+        }
+        if (showUnicode) {
+            auto j = i;
+            while ((j + 1 < size) && (asciiMask[p[j]]) && (p[j + 1] == 0))
+                j += 2;
+            reachedEnd |= j + 1 >= size;
+            if (((j - i) >> 1) >= minCount) {
+                add(i, j, StringType::Unicode);
+                i = j;
+                continue;
+            }
+        }
+        // a shorter ascii sequence can only be followed by an unicode string that starts on its last character
+        i = std::max<>(i + 1, i + asciiLen - (asciiLen > 0 ? 1 : 0));
+    }
+    return reachedEnd;
+}
+
+const StringsMap::Block& StringsMap::GetBlock(GView::Utils::DataCache& cache, uint64 blockIndex)
+{
+    if (auto it = blocks.find(blockIndex); it != blocks.end())
+        return it->second;
+
+    auto& block           = blocks[blockIndex];
+    const auto fileSize   = cache.GetSize();
+    const auto blockStart = blockIndex * BLOCK_SIZE;
+    if ((blockStart >= fileSize) || ((!showAscii) && (!showUnicode)))
+        return block;
+
+    const auto segmentStart = blockStart - blockStart % SEGMENT_SIZE;
+    const auto segmentEnd   = std::min<uint64>(fileSize, segmentStart + SEGMENT_SIZE);
+    uint64 lookback         = BLOCK_LOOKBACK;
+    uint64 extra            = BLOCK_EXTRA;
+    while (true) {
+        const auto readStart = std::max<uint64>(segmentStart, blockStart - std::min<uint64>(blockStart, lookback));
+        const auto readEnd   = std::min<uint64>(segmentEnd, blockStart + BLOCK_SIZE + extra);
+        const auto buf       = cache.CopyToBuffer(readStart, static_cast<uint32>(readEnd - readStart), false);
+        if (!buf.IsValid())
+            return block;
+
+        const auto* p    = buf.GetData();
+        const auto size  = static_cast<uint32>(buf.GetLength());
+        const auto start = static_cast<uint32>(blockStart - readStart);
+        const auto end   = std::min<uint32>(size, start + BLOCK_SIZE);
+
+        // find a byte before the block that can not be part of any string (not a string character and not the
+        // high byte of an unicode character) --> scanning from there gives the same runs as scanning from the
+        // beginning of the segment
+        uint32 from = 0;
+        bool found  = readStart == segmentStart;
+        for (auto i = start; i > 0; i--) {
+            const auto c = p[i - 1];
+            if (asciiMask[c])
+                continue;
+            if ((c == 0) && (i >= 2) && (asciiMask[p[i - 2]]))
+                continue;
+            if ((c == 0) && (i < 2) && (readStart > segmentStart))
+                break; // the byte before it was not read
+            from  = i;
+            found = true;
+            break;
+        }
+        if (!found) {
+            // the block starts inside a long string
+            lookback <<= 1;
+            continue;
+        }
+
+        block.runs.clear();
+        block.carried = { 0, 0, StringType::None };
+        if (ScanBuffer(p, size, from, start, end, readStart, block) && (readEnd < segmentEnd)) {
+            // a string goes on after the data that was read
+            extra <<= 1;
+            continue;
+        }
+        return block;
+    }
+}
+
+StringsMap::Run StringsMap::OffsetToRun(GView::Utils::DataCache& cache, uint64 offset)
+{
+    const auto blockIndex = offset / BLOCK_SIZE;
+    const auto blockStart = blockIndex * BLOCK_SIZE;
+    Run gap{ blockStart, blockStart + BLOCK_SIZE, StringType::None };
+
+    const auto& block = GetBlock(cache, blockIndex);
+    if (block.carried.type != StringType::None) {
+        if (offset < block.carried.end)
+            return block.carried;
+        gap.start = block.carried.end;
+    }
+
+    const auto& runs = block.runs;
+    auto it          = std::upper_bound(runs.begin(), runs.end(), offset, [](uint64 value, const Run& run) { return value < run.start; });
+    if (it != runs.end())
+        gap.end = it->start;
+    if (it != runs.begin()) {
+        const auto& run = *(it - 1);
+        if (offset < run.end)
+            return run;
+        gap.start = run.end;
+    }
+    return gap;
+}
+
+std::optional<StringsMap::Run> StringsMap::GetNextRun(GView::Utils::DataCache& cache, uint64 offset)
+{
+    const auto blocksCount = (cache.GetSize() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const auto firstBlock  = offset / BLOCK_SIZE;
+    const auto lastBlock   = std::min<uint64>(blocksCount, firstBlock + MAX_SEARCH_BLOCKS);
+    for (auto blockIndex = firstBlock; blockIndex < lastBlock; blockIndex++) {
+        const auto& runs = GetBlock(cache, blockIndex).runs;
+        auto it = std::upper_bound(runs.begin(), runs.end(), offset, [](uint64 value, const Run& run) { return value < run.start; });
+        if (it != runs.end())
+            return *it;
+    }
+    return std::nullopt;
+}
+
+std::optional<StringsMap::Run> StringsMap::GetPreviousRun(GView::Utils::DataCache& cache, uint64 offset)
+{
+    const auto lastBlock = (offset / BLOCK_SIZE) + 1;
+    const auto limit     = lastBlock > MAX_SEARCH_BLOCKS ? lastBlock - MAX_SEARCH_BLOCKS : 0;
+    for (auto blockIndex = lastBlock; blockIndex > limit; blockIndex--) {
+        const auto& runs = GetBlock(cache, blockIndex - 1).runs;
+        auto it = std::lower_bound(runs.begin(), runs.end(), offset, [](const Run& run, uint64 value) { return run.start < value; });
+        if (it != runs.begin())
+            return *(it - 1);
+    }
+    return std::nullopt;
+}
@@ -18,6 +18,8 @@ constexpr uint32 COMMAND_SAVE_DISSASM_CACHE     = 110;
 constexpr uint32 COMMAND_QUERY_FUNCTION_NAME    = 111;
 constexpr uint32 COMMAND_QUERY_MITRE_TECHNIQUE  = 112;
 constexpr uint32 COMMAND_RENAME_LABEL           = 113;
+constexpr uint32 COMMAND_GOTO_NEXT_FUNCTION     = 114;
+constexpr uint32 COMMAND_FIND_CALLERS           = 115;
 
 using AppCUI::int32;
 // TODO: reenable
@@ -174,11 +176,18 @@ namespace View
                 Input::Key::Ctrl | Input::Key::S, "SaveCache", "Save dissasm cache (will automatically save on ESCAPE)", COMMAND_SAVE_DISSASM_CACHE
             };
 
+            inline static KeyboardControl GoToNextFunctionCommand = {
+                Input::Key::Alt | Input::Key::Down, "GoToNextFunction", "Go to the start of the next function", COMMAND_GOTO_NEXT_FUNCTION
+            };
+            inline static KeyboardControl FindCallersCommand = {
+                Input::Key::Ctrl | Input::Key::R, "FindCallers", "Go to the next call site of the current function", COMMAND_FIND_CALLERS
+            };
+
             inline static std::array<std::reference_wrapper<KeyboardControl>, 3> KeyDownCommands = { AddOrEditCommentCommand,
                                                                                                      RemoveCommentCommand,
                                                                                                      RenameLabelCommand };
 
-            inline static std::array<std::reference_wrapper<KeyboardControl>, 11> AllKeyboardCommands = {
+            inline static std::array<std::reference_wrapper<KeyboardControl>, 13> AllKeyboardCommands = {
                 /*AddNewTypeCommand,*/ ShowOnlyDissasmCommand,
                 /*ShowOrHideFileContentCommand,*/ AsmExportFileContentCommand,
                 JumpBackCommand,
@@ -190,7 +199,9 @@ namespace View
                 RenameLabelCommand,
                 SaveCacheCommand,
                 CommandQueryFunctionName,
-                CommandQueryMITRETechnique
+                CommandQueryMITRETechnique,
+                GoToNextFunctionCommand,
+                FindCallersCommand
             };
             bool Loaded;
 
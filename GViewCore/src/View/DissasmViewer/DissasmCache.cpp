@@ -13,19 +13,38 @@ void DissasmCache::ClearCache(bool forceClear)
     if (!hasCache && !forceClear)
         return;
     zonesData.clear();
+    regions.clear();
+    analyzedFileSize = 0;
+    analyzedDataHash.clear();
     cacheFile.Close();
 }
 
 bool DissasmCache::AddRegion(std::string regionName, const std::byte* data, AppCUI::uint32 size)
 {
-    if (zonesData.contains(regionName))
-        return false;
     DissasmCacheEntry entry = { std::make_unique<std::byte[]>(size), size };
     memcpy(entry.data.get(), data, size);
     zonesData[std::move(regionName)] = std::move(entry);
     return true;
 }
 
+const DissasmCacheEntry* DissasmCache::GetRegion(const std::string& regionName)
+{
+    const auto it = zonesData.find(regionName);
+    if (it != zonesData.end())
+        return &it->second;
+
+    const auto region = regions.find(regionName);
+    if (region == regions.end())
+        return nullptr;
+    DissasmCacheEntry entry = { std::make_unique<std::byte[]>(region->second.size), region->second.size };
+    if (!cacheFile.SetCurrentPos(region->second.offset))
+        return nullptr;
+    if (!cacheFile.Read(reinterpret_cast<char*>(entry.data.get()), entry.size))
+        return nullptr;
+    regions.erase(region);
+    return &(zonesData[regionName] = std::move(entry));
+}
+
 std::filesystem::path DissasmCache::GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile)
 {
     constexpr char16 currentLoc  = '.';
@@ -35,28 +54,70 @@ std::filesystem::path DissasmCache::GetCacheFilePath(std::u16string_view fileLoc
     path += ".dissasm.cache";
     return path;
 }
-    
+
 bool DissasmCache::SaveCacheFile(std::u16string_view location)
 {
-    if (zonesData.empty())
+    if (zonesData.empty() || analyzedDataHash.size() > MAX_HASH_SIZE)
         return false;
+
+    // the whole file is built in memory and written at once
+    size_t totalSize = HEADER_SIZE;
+    for (const auto& [name, entry] : zonesData)
+        totalSize += entry.size + sizeof(uint32) + name.size() + sizeof(uint64) + sizeof(uint32);
+    std::vector<std::byte> content;
+    content.reserve(totalSize);
+    content.resize(HEADER_SIZE);
+
+    std::vector<std::pair<const std::string*, uint64>> offsets;
+    offsets.reserve(zonesData.size());
+    for (const auto& [name, entry] : zonesData) {
+        offsets.emplace_back(&name, content.size());
+        content.insert(content.end(), entry.data.get(), entry.data.get() + entry.size);
+    }
+    const uint64 directoryOffset = content.size();
+    for (const auto& [name, offset] : offsets) {
+        append_string(content, *name);
+        append_bytes(content, offset);
+        append_bytes(content, zonesData[*name].size);
+    }
+
+    std::vector<std::byte> header;
+    header.reserve(HEADER_SIZE);
+    append_bytes(header, FILE_MAGIC);
+    append_bytes(header, FILE_VERSION);
+    append_bytes(header, analyzedFileSize);
+    append_bytes(header, (uint32) analyzedDataHash.size());
+    header.insert(header.end(), (const std::byte*) analyzedDataHash.data(), (const std::byte*) analyzedDataHash.data() + analyzedDataHash.size());
+    header.resize(HEADER_SIZE - sizeof(uint32) - sizeof(uint64));
+    append_bytes(header, (uint32) zonesData.size());
+    append_bytes(header, directoryOffset);
+    memcpy(content.data(), header.data(), HEADER_SIZE);
+
+    // write a temporary file and replace the old cache only once it is complete
     const std::filesystem::path filePath(location.begin(), location.end());
-    bool created = cacheFile.Create(filePath, true);
-    if (!created)
-        return false;
-    const uint32 zonesCount = (uint32) zonesData.size();
-    uint32 entrySize;
-    cacheFile.Write((const char*) &zonesCount, sizeof(zonesCount));
-    for (auto& [name, entry] : zonesData) {
-        entrySize = (uint32) name.size();
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(name.data(), entrySize);
-
-        entrySize = entry.size;
-        cacheFile.Write((const char*) &entrySize, sizeof(entrySize));
-        cacheFile.Write(reinterpret_cast<const char*>(entry.data.get()), entry.size);
+    std::filesystem::path tempPath = filePath;
+    tempPath += ".tmp";
+
+    AppCUI::OS::File tempFile;
+    if (!tempFile.Create(tempPath, true))
+        return false;
+    const bool written = tempFile.Write(reinterpret_cast<const char*>(content.data()), (uint32) content.size());
+    tempFile.Close();
+
+    std::error_code ec;
+    if (!written) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
     }
+
+    // all the regions are in memory, the old file is no longer needed (and it can not be replaced while opened on some systems)
     cacheFile.Close();
+    regions.clear();
+    std::filesystem::rename(tempPath, filePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
     return true;
 }
 
@@ -67,53 +128,64 @@ bool DissasmCache::LoadCacheFile(std::u16string_view location)
     if (!opened)
         return false;
     const auto fileSize = cacheFile.GetSize();
-    if (fileSize == (uint64)-1)
+    if (fileSize == (uint64) -1 || fileSize < HEADER_SIZE)
         return false;
-    if (fileSize == 0)
-        return true;
-    std::vector<uint8> buffer;
-    buffer.resize((uint32) fileSize);
-    cacheFile.Read(reinterpret_cast<char*>(buffer.data()), (uint32)fileSize);
-    cacheFile.Close();
 
-    if (fileSize < sizeof(uint32))
+    // only the header and the directory are read now, regions are read when first requested
+    std::byte headerData[HEADER_SIZE];
+    if (!cacheFile.Read(reinterpret_cast<char*>(headerData), HEADER_SIZE))
         return false;
 
-    uint32 offset     = 0;
-    uint32 zonesCount = 0;
-    memcpy(&zonesCount, buffer.data() + offset, sizeof(zonesCount));
-    offset += sizeof(zonesCount);
+    const std::byte* ptr = headerData;
+    const std::byte* end = headerData + HEADER_SIZE;
+    uint32 magic = 0, version = 0, hashSize = 0, regionsCount = 0;
+    uint64 directoryOffset = 0;
+    if (!read_primitive(ptr, end, magic) || magic != FILE_MAGIC)
+        return false;
+    if (!read_primitive(ptr, end, version) || version != FILE_VERSION)
+        return false;
+    if (!read_primitive(ptr, end, analyzedFileSize))
+        return false;
+    if (!read_primitive(ptr, end, hashSize) || hashSize > MAX_HASH_SIZE)
+        return false;
+    analyzedDataHash.assign((const char*) ptr, hashSize);
+    ptr += MAX_HASH_SIZE;
+    if (!read_primitive(ptr, end, regionsCount) || !read_primitive(ptr, end, directoryOffset))
+        return false;
+    if (directoryOffset < HEADER_SIZE || directoryOffset > fileSize || fileSize - directoryOffset > 0xFFFFFFFF)
+        return false;
 
-    while (offset < buffer.size()) {
-        if (zonesCount-- == 0)
-            return false;
-        uint32 entrySize;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
+    const auto directorySize = static_cast<uint32>(fileSize - directoryOffset);
+    std::vector<std::byte> directory(directorySize);
+    if (directorySize > 0) {
+        if (!cacheFile.SetCurrentPos(directoryOffset))
             return false;
-        const auto entryDataName = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
+        if (!cacheFile.Read(reinterpret_cast<char*>(directory.data()), directorySize))
             return false;
-        std::string_view entryName = { (const char*) entryDataName, entrySize };
+    }
+
+    // every entry takes at least its name size, offset and size -> a count the directory can not hold is corrupt
+    constexpr uint32 MIN_ENTRY_SIZE = sizeof(uint32) + sizeof(DissasmCacheRegion::offset) + sizeof(DissasmCacheRegion::size);
+    if (regionsCount > directorySize / MIN_ENTRY_SIZE)
+        return false;
 
-        if (offset + sizeof(uint32) > buffer.size())
+    ptr = directory.data();
+    end = directory.data() + directory.size();
+    regions.reserve(regionsCount);
+    while (regionsCount > 0) {
+        uint32 nameSize       = 0;
+        const std::byte* name = nullptr;
+        DissasmCacheRegion region{};
+        if (!read_string_with_size(ptr, end, nameSize, name))
             return false;
-        memcpy(&entrySize, buffer.data() + offset, sizeof(entrySize));
-        offset += sizeof(entrySize);
-        if (offset + entrySize > buffer.size())
+        if (!read_primitive(ptr, end, region.offset) || !read_primitive(ptr, end, region.size))
             return false;
-        const auto entryData = buffer.data() + offset;
-        offset += entrySize;
-        if (offset > buffer.size())
+        if (region.offset < HEADER_SIZE || region.offset + region.size > directoryOffset)
             return false;
-
-        auto newCacheEntry = DissasmCacheEntry{ std::make_unique<std::byte[]>(entrySize), entrySize };
-        memcpy(newCacheEntry.data.get(), entryData, entrySize);
-        zonesData.emplace(entryName, std::move(newCacheEntry));
+        regions.emplace(std::string((const char*) name, nameSize), region);
+        --regionsCount;
     }
-    return true;
+    return ptr == end;
 }
 
 bool DisassemblyZone::ToBuffer(std::vector<std::byte>& buffer, Reference<GView::Object> obj) const
@@ -152,7 +224,6 @@ void Instance::SaveCacheData()
 {
     if (!config.EnableDeepScanDissasmOnStart)
         return;
-    cacheData.ClearCache(); // TODO: optimise this better? maybe clear cache after loading
     if (!settings->SaveToCache(cacheData, obj))
         return;
 
@@ -162,9 +233,14 @@ void Instance::SaveCacheData()
         if (zone->zoneType != DissasmParseZoneType::DissasmCodeParseZone)
             continue;
         const auto* dissasmZone = (DissasmCodeZone*) zone.get();
+        zoneName.SetFormat("DissasmParseZoneType.%llu", zone->startLineIndex);
+        if (!dissasmZone->isInit) {
+            // zone never shown -> keep the data from the previous cache file (if any)
+            cacheData.GetRegion(zoneName.GetText());
+            continue;
+        }
         if (!dissasmZone->ToBuffer(buffer))
             return;
-        zoneName.SetFormat("DissasmParseZoneType.%llu", zone->startLineIndex);
         if (!cacheData.AddRegion(zoneName.GetText(), buffer.data(), (uint32) buffer.size()))
             return;
     }
@@ -173,43 +249,42 @@ void Instance::SaveCacheData()
     cacheData.SaveCacheFile(path.u16string());
 }
 
-bool SettingsData::SaveToCache(DissasmCache& cache, Reference<GView::Object> obj)
+bool SettingsData::ComputeCacheHash(Reference<GView::Object> obj, std::string& hash)
 {
+    Hashes::OpenSSLHash hashAllZones(Hashes::OpenSSLHashKind::Md5);
     std::vector<std::byte> buffer;
-    LocalString<64> zoneName;
     for (auto& [start, zone] : disassemblyZones) {
         if (!zone.ToBuffer(buffer, obj))
             return false;
-        zoneName.SetFormat("DisassemblyZone.%llu", start);
-        if (!cache.AddRegion(zoneName.GetText(), buffer.data(), (uint32) buffer.size()))
+        if (!hashAllZones.Update(buffer.data(), (uint32) buffer.size()))
             return false;
     }
-    return true;
+    hash = hashAllZones.GetHexValue();
+    return !hash.empty();
+}
+
+bool SettingsData::SaveToCache(DissasmCache& cache, Reference<GView::Object> obj)
+{
+    cache.analyzedFileSize = obj->GetData().GetSize();
+    return ComputeCacheHash(obj, cache.analyzedDataHash);
 }
 
 bool SettingsData::ValidateCacheData(DissasmCache& cache, Reference<GView::Object> obj)
 {
-    std::vector<std::byte> buffer;
-    LocalString<64> zoneName;
-    for (auto& [start, zone] : disassemblyZones) {
-        zoneName.SetFormat("DisassemblyZone.%llu", start);
-        if (!cache.zonesData.contains(zoneName.GetText()))
-            return false;
-        const auto& entry = cache.zonesData[zoneName.GetText()];
-        if (!zone.ToBuffer(buffer, obj))
-            return false;
-        if (entry.size != buffer.size())
-            return false;
-        if (memcmp(entry.data.get(), buffer.data(), buffer.size()) != 0)
-            return false;
-    }
-    return true;
+    // the size is checked first, hashing the zones is needed only if it matches
+    if (cache.analyzedFileSize != obj->GetData().GetSize())
+        return false;
+    std::string hash;
+    if (!ComputeCacheHash(obj, hash))
+        return false;
+    return hash == cache.analyzedDataHash;
 }
 
 bool DissasmCodeZone::ToBuffer(std::vector<std::byte>& buffer) const
 {
     uint32 reserveSize = dissasmType.commentsData.GetRequiredSizeForSerialization();
     reserveSize += dissasmType.annotations.GetRequiredSizeForSerialization();
+    buffer.clear();
     buffer.reserve(reserveSize);
 
     // comments
@@ -228,11 +303,11 @@ bool DissasmCodeZone::TryLoadDataFromCache(DissasmCache& cache)
     LocalString<64> zoneName;
     zoneName.SetFormat("DissasmParseZoneType.%llu", startLineIndex);
 
-    auto it = cache.zonesData.find(zoneName.GetText());
-    if (it == cache.zonesData.end())
+    const auto entry = cache.GetRegion(zoneName.GetText());
+    if (!entry)
         return false;
-    const std::byte* dataPtr    = it->second.data.get();
-    const std::byte* dataPtrEnd = dataPtr + it->second.size;
+    const std::byte* dataPtr    = entry->data.get();
+    const std::byte* dataPtrEnd = dataPtr + entry->size;
 
     if (dataPtr + sizeof(uint32) > dataPtrEnd)
         return false;
@@ -11,19 +11,42 @@ struct DissasmCacheEntry
     AppCUI::uint32 size;
 };
 
+// location of a region inside the cache file (read only when the region is first requested)
+struct DissasmCacheRegion
+{
+    AppCUI::uint64 offset;
+    AppCUI::uint32 size;
+};
+
+/*
+ * Cache file layout (little endian):
+ *   header    : magic, version, analyzed file size, analyzed data hash, regions count, directory offset
+ *   regions   : the data of every region
+ *   directory : for every region -> name, offset and size
+ */
 struct DissasmCache {
+    static constexpr AppCUI::uint32 FILE_MAGIC    = 0x43445647; // GVDC
+    static constexpr AppCUI::uint32 FILE_VERSION  = 1;
+    static constexpr AppCUI::uint32 MAX_HASH_SIZE = 64;
+    static constexpr AppCUI::uint32 HEADER_SIZE   = 4 + 4 + 8 + 4 + MAX_HASH_SIZE + 4 + 8;
+
     bool hasCache;
     AppCUI::OS::File cacheFile;
     std::unordered_map<std::string, DissasmCacheEntry> zonesData;
+    std::unordered_map<std::string, DissasmCacheRegion> regions;
+
+    AppCUI::uint64 analyzedFileSize;
+    std::string analyzedDataHash;
 
     void ClearCache(bool forceClear = false);
 
     static std::filesystem::path GetCacheFilePath(std::u16string_view fileLocation, bool cacheSameLocationAsAnalyzedFile);
     bool AddRegion(std::string regionName, const std::byte* data, AppCUI::uint32 size);
+    const DissasmCacheEntry* GetRegion(const std::string& regionName);
 
     bool SaveCacheFile(std::u16string_view location);
     bool LoadCacheFile(std::u16string_view location);
 };
 
 
-} // namespace GView::View::DissasmViewer
\ No newline at end of file
+} // namespace GView::View::DissasmViewer
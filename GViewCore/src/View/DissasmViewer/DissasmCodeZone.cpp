@@ -1,6 +1,9 @@
 #include "DissasmCodeZone.hpp"
 #include "DissasmFunctionUtils.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using namespace GView::View::DissasmViewer;
 
 constexpr size_t DISSASM_INSTRUCTION_OFFSET_MARGIN = 500;
@@ -147,7 +150,6 @@ inline bool ExtractCallsToInsertFunctionNames(
             auto& annotations = zone->dissasmType.annotations;
             annotations.insert({ diffLines + extraLines, { call.second, callValue - offsets[0].offset } });
             annotations.add_initial_name(call.second);
-            cs_free(callInsn, 1);
             extraLines++;
         }
     }
@@ -159,7 +161,12 @@ inline bool ExtractCallsToInsertFunctionNames(
 }
 
 inline bool populateOffsetsVector(
-      vector<AsmOffsetLine>& offsets, DisassemblyZone& zoneDetails, GView::Object& obj, int internalArchitecture, uint32& totalLines)
+      vector<AsmOffsetLine>& offsets,
+      DissasmInstructionIndex& index,
+      DisassemblyZone& zoneDetails,
+      GView::Object& obj,
+      int internalArchitecture,
+      uint32& totalLines)
 {
     csh handle;
     const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
@@ -278,11 +285,14 @@ inline bool populateOffsetsVector(
     uint32 lineIndex = 0;
     offsets.clear();
     offsets.push_back({ minimalValue, 0 });
+    index.Clear();
+    index.sizes.reserve(zoneDetails.size / 4);
 
     constexpr uint32 alOpStr         = 7102752u; //* (uint32*) " al";
     uint32 continuousAddInstructions = 0;
 
     while (cs_disasm_iter(handle, &data, &size, &address, insn)) {
+        index.Add(insn->address + zoneDetails.startingZonePoint, static_cast<uint8>(insn->size));
         lineIndex++;
         if (address - lastOffset >= DISSASM_INSTRUCTION_OFFSET_MARGIN) {
             lastOffset                = address;
@@ -293,6 +303,7 @@ inline bool populateOffsetsVector(
         if (*(uint32*) insn->mnemonic == addOP && insn->op_str[0] == 'b' && *(uint32*) &insn->op_str[15] == alOpStr) {
             if (++continuousAddInstructions == addInstructionsStop) {
                 lineIndex -= continuousAddInstructions;
+                index.Truncate(lineIndex);
                 break;
             }
         } else
@@ -328,8 +339,15 @@ bool GView::View::DissasmViewer::DissasmCodeZone::InitZone(DissasmCodeZoneInitDa
     }
     }
 
+    instructionCache.Clear();
+    const auto resCode = instructionCache.Open(internalArchitecture);
+    if (resCode != CS_ERR_OK) {
+        initData.dli->WriteErrorToScreen(cs_strerror(resCode));
+        return false;
+    }
+
     uint32 totalLines = 0;
-    if (!populateOffsetsVector(cachedCodeOffsets, zoneDetails, initData.obj, internalArchitecture, totalLines)) {
+    if (!populateOffsetsVector(cachedCodeOffsets, instructionIndex, zoneDetails, initData.obj, internalArchitecture, totalLines)) {
         initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
         return false;
     }
@@ -338,6 +356,9 @@ bool GView::View::DissasmViewer::DissasmCodeZone::InitZone(DissasmCodeZoneInitDa
         initData.dli->WriteErrorToScreen("ERROR: failed to populate offsets vector!");
         return false;
     }
+    const auto zoneData = initData.obj->GetData().Get(zoneDetails.startingZonePoint, static_cast<uint32>(zoneDetails.size), false);
+    if (!xrefIndex.Build(zoneData, zoneDetails, instructionIndex, internalArchitecture))
+        xrefIndex.Clear(); // not fatal, only the navigation by functions / callers is unavailable
     totalLines++; //+1 for title
     initData.adjustedZoneSize = totalLines;
     initData.hasAdjustedSize  = true;
@@ -451,4 +472,258 @@ bool DissasmCodeZone::ResetTypesReferenceList()
     levels.push_back(0);
     ResetZoneCaching();
     return true;
-}
\ No newline at end of file
+}
+DissasmInstructionCache::~DissasmInstructionCache()
+{
+    Close();
+}
+
+cs_err DissasmInstructionCache::Open(int internalArchitecture)
+{
+    if (iteratorInsn && architecture == internalArchitecture)
+        return CS_ERR_OK;
+    Close();
+
+    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle);
+    if (resCode != CS_ERR_OK) {
+        handle = 0;
+        return resCode;
+    }
+    iteratorInsn = cs_malloc(handle);
+    if (!iteratorInsn) {
+        cs_close(&handle);
+        handle = 0;
+        return CS_ERR_MEM;
+    }
+    architecture = internalArchitecture;
+    return CS_ERR_OK;
+}
+
+void DissasmInstructionCache::Close()
+{
+    Clear();
+    if (iteratorInsn) {
+        cs_free(iteratorInsn, 1);
+        iteratorInsn = nullptr;
+    }
+    if (handle) {
+        cs_close(&handle);
+        handle = 0;
+    }
+    architecture = -1;
+}
+
+void DissasmInstructionCache::Clear()
+{
+    instructions.clear();
+    lines.clear();
+}
+
+const cs_insn* DissasmInstructionCache::Find(uint32 line)
+{
+    const auto it = lines.find(line);
+    if (it == lines.end())
+        return nullptr;
+    instructions.splice(instructions.begin(), instructions, it->second);
+    return &it->second->second;
+}
+
+const cs_insn* DissasmInstructionCache::Add(uint32 line, const cs_insn& insn)
+{
+    const auto it = lines.find(line);
+    if (it != lines.end()) {
+        it->second->second = insn;
+        instructions.splice(instructions.begin(), instructions, it->second);
+        return &it->second->second;
+    }
+    if (instructions.size() >= MAX_CACHED_INSTRUCTIONS) {
+        lines.erase(instructions.back().first);
+        instructions.pop_back();
+    }
+    // detail mode is never enabled, so the instruction does not own any memory and can be copied as it is
+    instructions.emplace_front(line, insn);
+    instructions.front().second.detail = nullptr;
+    lines[line] = instructions.begin();
+    return &instructions.front().second;
+}
+
+void DissasmInstructionIndex::Clear()
+{
+    blockOffsets.clear();
+    sizes.clear();
+}
+
+void DissasmInstructionIndex::Add(uint64 offset, uint8 size)
+{
+    if (sizes.size() % BLOCK_LINES == 0)
+        blockOffsets.push_back(offset);
+    sizes.push_back(size);
+}
+
+void DissasmInstructionIndex::Truncate(uint32 linesCount)
+{
+    if (linesCount >= sizes.size())
+        return;
+    sizes.resize(linesCount);
+    blockOffsets.resize((static_cast<size_t>(linesCount) + BLOCK_LINES - 1) / BLOCK_LINES);
+}
+
+uint64 DissasmInstructionIndex::GetOffset(uint32 line) const
+{
+    assert(line < sizes.size());
+    const uint32 block = line / BLOCK_LINES;
+    uint64 offset      = blockOffsets[block];
+    for (uint32 i = block * BLOCK_LINES; i < line; i++)
+        offset += sizes[i];
+    return offset;
+}
+
+uint32 DissasmInstructionIndex::GetLine(uint64 offset) const
+{
+    if (sizes.empty())
+        return 0;
+    const auto it = std::upper_bound(blockOffsets.begin(), blockOffsets.end(), offset);
+    if (it == blockOffsets.begin())
+        return 0;
+    const uint32 block = static_cast<uint32>(it - blockOffsets.begin()) - 1;
+    uint32 line        = block * BLOCK_LINES;
+    const uint32 end   = std::min<uint32>((block + 1) * BLOCK_LINES, static_cast<uint32>(sizes.size()));
+    uint64 current     = blockOffsets[block];
+    while (line + 1 < end && current + sizes[line] <= offset) {
+        current += sizes[line];
+        line++;
+    }
+    return line;
+}
+
+// direct call / jump targets are printed by capstone as a single hex value: "0x1234"
+static bool ExtractDirectBranchTarget(const char* op_str, uint64& target)
+{
+    if (op_str[0] != '0' || op_str[1] != 'x')
+        return false;
+    target          = 0;
+    const char* ptr = op_str + 2;
+    for (; *ptr; ptr++) {
+        if (*ptr >= '0' && *ptr <= '9')
+            target = target * 16 + (*ptr - '0');
+        else if (*ptr >= 'a' && *ptr <= 'f')
+            target = target * 16 + (*ptr - 'a' + 10);
+        else
+            return false;
+    }
+    return ptr != op_str + 2;
+}
+
+void DissasmXrefIndex::Clear()
+{
+    xrefs.clear();
+    functionStarts.clear();
+}
+
+bool DissasmXrefIndex::Build(BufferView zoneData, const DisassemblyZone& zoneDetails, const DissasmInstructionIndex& index, int internalArchitecture)
+{
+    Clear();
+    const uint32 linesCount = index.GetLinesCount();
+    if (!zoneData.IsValid() || linesCount == 0)
+        return false;
+
+    // lines are split in equal parts, each one starts on an instruction boundary known from the index
+    constexpr uint32 MIN_LINES_PER_WORKER = 0x4000;
+    const uint32 workersCount             = std::clamp<uint32>(linesCount / MIN_LINES_PER_WORKER, 1, std::max<uint32>(std::thread::hardware_concurrency(), 1));
+
+    std::vector<std::vector<Xref>> results(workersCount);
+    std::vector<uint8> succeeded(workersCount, 0); // not vector<bool>: every worker writes its own element
+    // the view can be shorter than the zone (truncated read) -> only the bytes it holds are decoded
+    const uint64 zoneStart = zoneDetails.startingZonePoint;
+    const uint64 zoneEnd   = zoneStart + std::min<uint64>(zoneData.GetLength(), zoneDetails.size);
+
+    auto worker = [&](uint32 workerIndex) {
+        const uint32 firstLine = static_cast<uint32>(static_cast<uint64>(linesCount) * workerIndex / workersCount);
+        const uint32 lastLine  = static_cast<uint32>(static_cast<uint64>(linesCount) * (workerIndex + 1) / workersCount);
+        uint32 linesToDecode   = lastLine - firstLine;
+
+        uint64 address = index.GetOffset(firstLine); // absolute file offsets are used as addresses
+        if (address < zoneStart || address >= zoneEnd) {
+            // the lines of this worker are past the end of the view
+            succeeded[workerIndex] = 1;
+            return;
+        }
+
+        csh handle;
+        if (cs_open(CS_ARCH_X86, static_cast<cs_mode>(internalArchitecture), &handle) != CS_ERR_OK)
+            return;
+        cs_insn* insn = cs_malloc(handle);
+
+        const uint8* data = zoneData.GetData() + (address - zoneStart);
+        size_t size       = static_cast<size_t>(zoneEnd - address);
+        uint64 target     = 0;
+        auto& output      = results[workerIndex];
+        while (linesToDecode > 0 && cs_disasm_iter(handle, &data, &size, &address, insn)) {
+            linesToDecode--;
+            const bool isCall = *(uint32*) insn->mnemonic == callOP;
+            if (!isCall && insn->mnemonic[0] != 'j')
+                continue;
+            if (!ExtractDirectBranchTarget(insn->op_str, target) || target < zoneStart || target >= zoneEnd)
+                continue;
+            output.push_back({ target, insn->address, isCall ? XrefType::Call : XrefType::Jump });
+        }
+
+        cs_free(insn, 1);
+        cs_close(&handle);
+        succeeded[workerIndex] = 1;
+    };
+
+    if (workersCount == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> threads;
+        threads.reserve(workersCount);
+        for (uint32 i = 0; i < workersCount; i++)
+            threads.emplace_back(worker, i);
+        for (auto& t : threads)
+            t.join();
+    }
+
+    size_t totalXrefs = 0;
+    for (uint32 i = 0; i < workersCount; i++) {
+        if (!succeeded[i])
+            return false;
+        totalXrefs += results[i].size();
+    }
+    xrefs.reserve(totalXrefs);
+    for (auto& result : results)
+        xrefs.insert(xrefs.end(), result.begin(), result.end());
+    std::sort(xrefs.begin(), xrefs.end(), [](const Xref& a, const Xref& b) { return a.target < b.target || a.target == b.target && a.source < b.source; });
+
+    functionStarts.push_back(zoneDetails.entryPoint);
+    for (const auto& xref : xrefs)
+        if (xref.type == XrefType::Call && xref.target != functionStarts.back())
+            functionStarts.push_back(xref.target);
+    std::sort(functionStarts.begin(), functionStarts.end());
+    functionStarts.erase(std::unique(functionStarts.begin(), functionStarts.end()), functionStarts.end());
+    return true;
+}
+
+std::pair<const DissasmXrefIndex::Xref*, const DissasmXrefIndex::Xref*> DissasmXrefIndex::GetXrefsTo(uint64 target) const
+{
+    const auto range = std::equal_range(xrefs.begin(), xrefs.end(), Xref{ target, 0, XrefType::Call }, [](const Xref& a, const Xref& b) {
+        return a.target < b.target;
+    });
+    return { xrefs.data() + (range.first - xrefs.begin()), xrefs.data() + (range.second - xrefs.begin()) };
+}
+
+std::optional<uint64> DissasmXrefIndex::GetFunctionStart(uint64 offset) const
+{
+    const auto it = std::upper_bound(functionStarts.begin(), functionStarts.end(), offset);
+    if (it == functionStarts.begin())
+        return {};
+    return *(it - 1);
+}
+
+std::optional<uint64> DissasmXrefIndex::GetNextFunctionStart(uint64 offset) const
+{
+    const auto it = std::upper_bound(functionStarts.begin(), functionStarts.end(), offset);
+    if (it == functionStarts.end())
+        return {};
+    return *it;
+}
@@ -4,6 +4,67 @@
 
 namespace GView::View::DissasmViewer
 {
+// start offset of every instruction of a zone: the absolute offset once every BLOCK_LINES lines + the size of each instruction
+struct DissasmInstructionIndex {
+    static constexpr uint32 BLOCK_LINES = 64;
+
+    std::vector<uint64> blockOffsets;
+    std::vector<uint8> sizes;
+
+    void Clear();
+    void Add(uint64 offset, uint8 size);
+    void Truncate(uint32 linesCount);
+    uint32 GetLinesCount() const
+    {
+        return static_cast<uint32>(sizes.size());
+    }
+    uint64 GetOffset(uint32 line) const;
+    uint32 GetLine(uint64 offset) const; // line of the instruction that contains the offset
+};
+
+// calls and jumps with a direct target inside the zone (sorted by target) + the function starts derived from them
+struct DissasmXrefIndex {
+    enum class XrefType : uint8 { Call, Jump };
+    struct Xref {
+        uint64 target;
+        uint64 source;
+        XrefType type;
+    };
+
+    std::vector<Xref> xrefs;
+    std::vector<uint64> functionStarts; // entry point + every call target
+
+    void Clear();
+    bool Build(BufferView zoneData, const DisassemblyZone& zoneDetails, const DissasmInstructionIndex& index, int internalArchitecture);
+
+    std::pair<const Xref*, const Xref*> GetXrefsTo(uint64 target) const;
+    std::optional<uint64> GetFunctionStart(uint64 offset) const;
+    std::optional<uint64> GetNextFunctionStart(uint64 offset) const;
+};
+
+// capstone handle kept open for the lifetime of the zone + the last decoded instructions (by asm line)
+struct DissasmInstructionCache {
+    static constexpr uint32 MAX_CACHED_INSTRUCTIONS = 1024;
+
+    csh handle            = 0;
+    int architecture      = -1;
+    cs_insn* iteratorInsn = nullptr; // used by cs_disasm_iter
+
+    std::list<std::pair<uint32, cs_insn>> instructions; // most recently used first
+    std::unordered_map<uint32, std::list<std::pair<uint32, cs_insn>>::iterator> lines;
+
+    DissasmInstructionCache() = default;
+    DissasmInstructionCache(const DissasmInstructionCache&)            = delete;
+    DissasmInstructionCache& operator=(const DissasmInstructionCache&) = delete;
+    ~DissasmInstructionCache();
+
+    cs_err Open(int internalArchitecture);
+    void Close();
+    void Clear();
+    const cs_insn* Find(uint32 line);
+    const cs_insn* Add(uint32 line, const cs_insn& insn);
+};
+
 struct DissasmCodeZone : public ParseZone {
     enum class CollapseExpandType : uint8 { Collapse, Expand, NegateCurrentState };
     uint32 lastDrawnLine; // optimization not to recompute buffer every time
@@ -24,6 +85,9 @@ struct DissasmCodeZone : public ParseZone {
     DissasmAsmPreCacheData asmPreCacheData;
 
     std::vector<AsmOffsetLine> cachedCodeOffsets;
+    DissasmInstructionIndex instructionIndex;
+    DissasmXrefIndex xrefIndex;
+    DissasmInstructionCache instructionCache;
     DisassemblyZone zoneDetails;
     int internalArchitecture; // used for dissasm libraries
     bool isInit;
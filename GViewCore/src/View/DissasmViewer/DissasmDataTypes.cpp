@@ -145,7 +145,8 @@ bool AnnotationContainer::LoadFromBuffer(const std::byte*& start, const std::byt
         if (!read_primitive(start, end, callValue))
             return false;
         std::string annName((const char*) annotation, annotationSize);
-        mappings[offset] = { std::move(annName), callValue };
+        mappings[offset]   = { std::move(annName), callValue };
+        sorted_lines_dirty = true;
         --annotationsCount;
     }
 
@@ -72,6 +72,10 @@ namespace View
             MapNameLinkType initial_name_to_current_name;
             MapNameLinkType current_name_to_initial_name;
 
+            // sorted annotation lines, rebuilt by count_in_range after any change of the annotations
+            mutable std::vector<AnnoationLineNumberType> sorted_lines;
+            mutable bool sorted_lines_dirty{ true };
+
             std::size_t size() const
             {
                 return mappings.size();
@@ -89,27 +93,32 @@ namespace View
 
             std::pair<iterator, bool> insert(const value_type& v)
             {
+                sorted_lines_dirty = true;
                 return mappings.insert(v);
             }
 
             template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
             std::pair<iterator, bool> insert(P&& v)
             {
+                sorted_lines_dirty = true;
                 return mappings.insert(std::forward<P>(v));
             }
 
             template <class InputIt>
             void insert(InputIt first, InputIt last)
             {
+                sorted_lines_dirty = true;
                 mappings.insert(first, last);
             }
 
             mapped_type& operator[](const key_type& k)
             {
+                sorted_lines_dirty = true;
                 return mappings[k];
             }
             mapped_type& operator[](key_type&& k)
             {
+                sorted_lines_dirty = true;
                 return mappings[std::move(k)];
             }
 
@@ -118,6 +127,21 @@ namespace View
                 return mappings.contains(k);
             }
 
+            // number of annotations placed on lines between [first, last]
+            uint32 count_in_range(key_type first, key_type last) const
+            {
+                if (sorted_lines_dirty) {
+                    sorted_lines.clear();
+                    sorted_lines.reserve(mappings.size());
+                    for (const auto& entry : mappings)
+                        sorted_lines.push_back(entry.first);
+                    sorted_lines_dirty = false;
+                }
+                const auto start = std::lower_bound(sorted_lines.begin(), sorted_lines.end(), first);
+                const auto end   = std::upper_bound(start, sorted_lines.end(), last);
+                return static_cast<uint32>(end - start);
+            }
+
             iterator find(const key_type& k)
             {
                 return mappings.find(k);
@@ -173,6 +197,7 @@ namespace View
 
             void populate_annotations_from_other_storage(const AnnotationContainer& other)
             {
+                sorted_lines_dirty = true;
                 mappings.insert(other.mappings.begin(), other.mappings.end());
                 initial_name_to_current_name.insert(other.initial_name_to_current_name.begin(), other.initial_name_to_current_name.end());
                 current_name_to_initial_name.insert(other.current_name_to_initial_name.begin(), other.current_name_to_initial_name.end());
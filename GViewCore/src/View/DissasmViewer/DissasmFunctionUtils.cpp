@@ -151,11 +151,18 @@ AsmOffsetLine SearchForClosestAsmOffsetLineByOffset(const std::vector<AsmOffsetL
     return values[left];
 }
 
-cs_insn* GetCurrentInstructionByOffset(
+const cs_insn* GetCurrentInstructionByOffset(
       uint64 offsetToReach, DissasmCodeZone* zone, Reference<GView::Object> obj, uint32& diffLines, DrawLineInfo* dli)
 {
-    const auto closestData = SearchForClosestAsmOffsetLineByOffset(zone->cachedCodeOffsets, offsetToReach);
+    AsmOffsetLine closestData;
+    if (zone->instructionIndex.GetLinesCount() > 0) {
+        const uint32 line = zone->instructionIndex.GetLine(offsetToReach);
+        closestData       = { zone->instructionIndex.GetOffset(line), line };
+    } else {
+        closestData = SearchForClosestAsmOffsetLineByOffset(zone->cachedCodeOffsets, offsetToReach);
+    }
     zone->lastClosestLine  = closestData.line;
+    zone->lastDrawnLine    = UINT32_MAX; // the iterator is moved to an unknown line
     zone->asmAddress       = closestData.offset - zone->cachedCodeOffsets[0].offset;
     zone->asmSize          = zone->zoneDetails.size - zone->asmAddress;
 
@@ -171,32 +178,26 @@ cs_insn* GetCurrentInstructionByOffset(
 
     zone->asmData = const_cast<uint8*>(zone->lastData.GetData());
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
+    const auto resCode = zone->instructionCache.Open(zone->internalArchitecture);
     if (resCode != CS_ERR_OK) {
         if (dli)
             dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
         return nullptr;
     }
 
     diffLines     = 0;
-    cs_insn* insn = cs_malloc(handle);
+    cs_insn* insn = zone->instructionCache.iteratorInsn;
     if (offsetToReach >= zone->cachedCodeOffsets[0].offset)
         offsetToReach -= zone->cachedCodeOffsets[0].offset;
     while (zone->asmAddress <= offsetToReach) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!cs_disasm_iter(zone->instructionCache.handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
             return nullptr;
         }
         diffLines++;
     }
     diffLines += closestData.line - 1;
-    cs_close(&handle);
     return insn;
 }
 
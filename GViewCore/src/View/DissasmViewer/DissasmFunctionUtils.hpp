@@ -12,7 +12,8 @@ constexpr uint32 retOP  = 7628146u;    //*((uint32*) "ret");
 bool CheckExtractInsnHexValue(const char* op_str, AppCUI::uint64& value, AppCUI::uint64 maxSize);
 AppCUI::Utils::LocalString<64> FormatFunctionName(AppCUI::uint64 functionAddress, const char* prefix);
 
-cs_insn* GetCurrentInstructionByOffset(
+// the returned instruction is owned by the zone instruction cache and is valid until the next decode
+const cs_insn* GetCurrentInstructionByOffset(
       uint64 offsetToReach,
       GView::View::DissasmViewer::DissasmCodeZone* zone,
       Reference<GView::Object> obj,
@@ -264,6 +264,16 @@ bool Instance::OnKeyEvent(AppCUI::Input::Key keyCode, char16 charCode)
         return true;
     }
 
+    if (keyCode == Config::GoToNextFunctionCommand.Key) {
+        CommandGoToNextFunction();
+        return true;
+    }
+
+    if (keyCode == Config::FindCallersCommand.Key) {
+        CommandFindCallers();
+        return true;
+    }
+
     if (keyCode == Config::SaveCacheCommand.Key) {
         SaveCacheData();
         return true;
@@ -358,6 +368,12 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
             ProcessSpaceKey(true);
             return true;
         }
+        case COMMAND_GOTO_NEXT_FUNCTION:
+            CommandGoToNextFunction();
+            return true;
+        case COMMAND_FIND_CALLERS:
+            CommandFindCallers();
+            return true;
         case COMMAND_AVAILABLE_KEYS: {
             {
                 KeyConfigDisplayWindow windows;
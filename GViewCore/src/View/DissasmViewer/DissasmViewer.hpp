@@ -102,6 +102,8 @@ namespace View
             bool isCollapsed;
 
             DissasmParseZoneType zoneType;
+
+            virtual ~ParseZone() = default;
         };
 
         struct DissasmParseStructureZone : public ParseZone {
@@ -406,6 +408,7 @@ namespace View
             std::unordered_map<TypeID, DissasmStructureType> userDesignedTypes; // user defined types
             Reference<BufferViewer::OffsetTranslateInterface> offsetTranslateCallback;
 
+            bool ComputeCacheHash(Reference<GView::Object> obj, std::string& hash);
             bool SaveToCache(DissasmCache& cache, Reference<GView::Object> obj);
             bool ValidateCacheData(DissasmCache& cache, Reference<GView::Object> obj);
             SettingsData();
@@ -570,6 +573,11 @@ namespace View
 
             AsmData asmData;
             JumpsHolder jumps_holder;
+            struct {
+                uint64 functionStart; // function whose callers are visited with FindCallersCommand
+                uint64 lastCallSite;
+                uint32 nextCaller;
+            } callersNavigation = {};
             DissasmCache cacheData;
             CommonInterfaces::QueryInterface* queryInterface;
 
@@ -624,6 +632,9 @@ namespace View
             void ProcessSpaceKey(bool goToEntryPoint = false);
             void CommandExecuteCollapsibleZoneOperation(CollapsibleZoneOperation operation);
             void DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, uint64* offsetToReach = nullptr);
+            bool GetCurrentDissasmCodeZoneOffset(DissasmCodeZone*& zone, uint32& zoneLine, uint64& offset);
+            void CommandGoToNextFunction();
+            void CommandFindCallers();
 
             void EditDissasmCodeZoneCommand();
             void QuerySmartAssistant(QueryTypeSmartAssistant queryType);
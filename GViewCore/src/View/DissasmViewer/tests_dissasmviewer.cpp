@@ -3,6 +3,8 @@
 #include "x86_x64/DissasmX86.hpp"
 #include "DissasmFunctionUtils.hpp"
 #include <array>
+#include <filesystem>
+#include <fstream>
 
 using namespace GView::View::DissasmViewer;
 
@@ -906,4 +908,179 @@ TEST_CASE("ValidatingComments", "[Dissasm]Comments")
         REQUIRE(dissasmInstance.RemoveComment(5));
         REQUIRE(!dissasmInstance.HasComment(5));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("AnnotationsCountInRange", "[Dissasm]Annotations")
+{
+    AnnotationContainer annotations;
+    REQUIRE(annotations.count_in_range(0, 100) == 0);
+
+    annotations.insert({ 2, { "sub_2", 2 } });
+    annotations.insert({ 5, { "sub_5", 5 } });
+    annotations.insert({ 10, { "sub_10", 10 } });
+    REQUIRE(annotations.count_in_range(0, 100) == 3);
+    REQUIRE(annotations.count_in_range(2, 10) == 3);
+    REQUIRE(annotations.count_in_range(3, 9) == 1);
+    REQUIRE(annotations.count_in_range(6, 9) == 0);
+    REQUIRE(annotations.count_in_range(11, 100) == 0);
+
+    // every change after a count has to be seen by the next one
+    annotations[7] = { "sub_7", 7 };
+    REQUIRE(annotations.count_in_range(3, 9) == 2);
+
+    annotations.insert(std::make_pair(4u, AnnotationContainer::AnnotationDetails{ "sub_4", 4 }));
+    REQUIRE(annotations.count_in_range(3, 9) == 3);
+
+    AnnotationContainer other;
+    other.insert({ 8, { "sub_8", 8 } });
+    annotations.populate_annotations_from_other_storage(other);
+    REQUIRE(annotations.count_in_range(3, 9) == 4);
+    REQUIRE(annotations.count_in_range(0, 100) == 6);
+
+    SECTION("serialization")
+    {
+        std::vector<std::byte> buffer;
+        annotations.ToBuffer(buffer);
+        REQUIRE(buffer.size() == annotations.GetRequiredSizeForSerialization());
+
+        AnnotationContainer loaded;
+        REQUIRE(loaded.count_in_range(0, 100) == 0);
+        const std::byte* start = buffer.data();
+        REQUIRE(loaded.LoadFromBuffer(start, buffer.data() + buffer.size()));
+        REQUIRE(start == buffer.data() + buffer.size());
+        REQUIRE(loaded.size() == annotations.size());
+        REQUIRE(loaded.count_in_range(0, 100) == 6);
+        REQUIRE(loaded.count_in_range(3, 9) == 4);
+    }
+}
+
+TEST_CASE("InstructionIndexLookups", "[Dissasm]InstructionIndex")
+{
+    constexpr uint64 START_OFFSET = 0x1000;
+    constexpr uint32 LINES        = 200;
+
+    DissasmInstructionIndex index;
+    std::vector<uint64> offsets;
+    std::vector<uint8> sizes;
+    uint64 offset = START_OFFSET;
+    for (uint32 i = 0; i < LINES; i++) {
+        const auto size = static_cast<uint8>(i % 7 + 1);
+        offsets.push_back(offset);
+        sizes.push_back(size);
+        index.Add(offset, size);
+        offset += size;
+    }
+    REQUIRE(index.GetLinesCount() == LINES);
+    REQUIRE(index.blockOffsets.size() == (LINES + DissasmInstructionIndex::BLOCK_LINES - 1) / DissasmInstructionIndex::BLOCK_LINES);
+
+    for (uint32 line = 0; line < LINES; line++) {
+        REQUIRE(index.GetOffset(line) == offsets[line]);
+        REQUIRE(index.GetLine(offsets[line]) == line);
+        REQUIRE(index.GetLine(offsets[line] + sizes[line] - 1) == line);
+    }
+    REQUIRE(index.GetLine(0) == 0);
+    REQUIRE(index.GetLine(offset + 0x100) == LINES - 1);
+
+    SECTION("truncate and continue")
+    {
+        index.Truncate(DissasmInstructionIndex::BLOCK_LINES);
+        REQUIRE(index.GetLinesCount() == DissasmInstructionIndex::BLOCK_LINES);
+        REQUIRE(index.blockOffsets.size() == 1);
+        REQUIRE(index.GetLine(offsets[100]) == DissasmInstructionIndex::BLOCK_LINES - 1);
+
+        // the next line starts a new block again
+        index.Add(offsets[DissasmInstructionIndex::BLOCK_LINES], sizes[DissasmInstructionIndex::BLOCK_LINES]);
+        REQUIRE(index.blockOffsets.size() == 2);
+        REQUIRE(index.GetOffset(DissasmInstructionIndex::BLOCK_LINES) == offsets[DissasmInstructionIndex::BLOCK_LINES]);
+        REQUIRE(index.GetLine(offsets[DissasmInstructionIndex::BLOCK_LINES]) == DissasmInstructionIndex::BLOCK_LINES);
+
+        index.Truncate(10);
+        REQUIRE(index.GetLinesCount() == 10);
+        REQUIRE(index.GetOffset(9) == offsets[9]);
+        REQUIRE(index.GetLine(offsets[50]) == 9);
+    }
+}
+
+TEST_CASE("CacheFileRoundTrip", "[Dissasm]Cache")
+{
+    DissasmTestInstance dissasmInstance(exampleTest1BinaryCode, exampleTest1BinaryCodeSize);
+    Reference<GView::Object> obj = &dissasmInstance.objects[0];
+
+    SettingsData settings;
+    settings.disassemblyZones[0] = { 0, 5120, 10, DisassemblyLanguage::x86 };
+
+    const auto path = std::filesystem::temp_directory_path() / "gview_tests_dissasm.cache";
+    const std::array<std::byte, 5> region1 = { std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 }, std::byte{ 4 }, std::byte{ 5 } };
+    const std::array<std::byte, 2> region2 = { std::byte{ 0xAA }, std::byte{ 0xBB } };
+
+    {
+        DissasmCache cache{};
+        REQUIRE(settings.SaveToCache(cache, obj));
+        REQUIRE(cache.AddRegion("zone.1", region1.data(), (uint32) region1.size()));
+        REQUIRE(cache.AddRegion("zone.2", region2.data(), (uint32) region2.size()));
+        REQUIRE(cache.SaveCacheFile(path.u16string()));
+    }
+
+    {
+        DissasmCache cache{};
+        REQUIRE(cache.LoadCacheFile(path.u16string()));
+        REQUIRE(cache.regions.size() == 2);
+        REQUIRE(settings.ValidateCacheData(cache, obj));
+
+        const auto* entry = cache.GetRegion("zone.1");
+        REQUIRE(entry);
+        REQUIRE(entry->size == region1.size());
+        REQUIRE(memcmp(entry->data.get(), region1.data(), region1.size()) == 0);
+        entry = cache.GetRegion("zone.2");
+        REQUIRE(entry);
+        REQUIRE(entry->size == region2.size());
+        REQUIRE(memcmp(entry->data.get(), region2.data(), region2.size()) == 0);
+        REQUIRE(!cache.GetRegion("zone.3"));
+
+        // a different analyzed file
+        cache.analyzedDataHash[0] ^= 1;
+        REQUIRE(!settings.ValidateCacheData(cache, obj));
+        cache.analyzedDataHash[0] ^= 1;
+        cache.analyzedFileSize++;
+        REQUIRE(!settings.ValidateCacheData(cache, obj));
+        cache.ClearCache(true);
+    }
+
+    std::vector<char> content;
+    {
+        std::ifstream file(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    REQUIRE(content.size() > DissasmCache::HEADER_SIZE);
+
+    const auto loadCorrupted = [&](size_t position, const auto value) {
+        auto corrupted = content;
+        memcpy(corrupted.data() + position, &value, sizeof(value));
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(corrupted.data(), (std::streamsize) corrupted.size());
+        }
+        DissasmCache cache{};
+        const bool loaded = cache.LoadCacheFile(path.u16string());
+        cache.ClearCache(true);
+        return loaded;
+    };
+    constexpr size_t VERSION_POSITION       = 4;
+    constexpr size_t HASH_SIZE_POSITION     = 4 + 4 + 8;
+    constexpr size_t REGIONS_COUNT_POSITION = DissasmCache::HEADER_SIZE - 8 - 4;
+    constexpr size_t DIRECTORY_POSITION     = DissasmCache::HEADER_SIZE - 8;
+    uint32 regionsCount                     = 0;
+    memcpy(&regionsCount, content.data() + REGIONS_COUNT_POSITION, sizeof(regionsCount));
+    REQUIRE(regionsCount == 2);
+
+    REQUIRE(loadCorrupted(REGIONS_COUNT_POSITION, regionsCount)); // unchanged
+    REQUIRE(!loadCorrupted(0, DissasmCache::FILE_MAGIC + 1));
+    REQUIRE(!loadCorrupted(VERSION_POSITION, DissasmCache::FILE_VERSION + 1));
+    REQUIRE(!loadCorrupted(HASH_SIZE_POSITION, DissasmCache::MAX_HASH_SIZE + 1));
+    REQUIRE(!loadCorrupted(REGIONS_COUNT_POSITION, 0xFFFFFFFFu));
+    REQUIRE(!loadCorrupted(REGIONS_COUNT_POSITION, 1u));
+    REQUIRE(!loadCorrupted(DIRECTORY_POSITION, (uint64) content.size() + 1));
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
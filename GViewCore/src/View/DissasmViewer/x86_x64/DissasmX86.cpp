@@ -228,24 +228,38 @@ inline void DissasmAddColorsToInstruction(
     // string.SetFormat("0x%" PRIx64 ":           %s %s", insn[j].address, insn[j].mnemonic, insn[j].op_str);
 }
 
-inline cs_insn* GetCurrentInstructionByLine(
+// the returned instruction is owned by the zone instruction cache (do not free it)
+inline const cs_insn* GetCurrentInstructionByLine(
       uint32 lineToReach, DissasmCodeZone* zone, Reference<GView::Object> obj, uint32& diffLines, DrawLineInfo* dli = nullptr)
 {
+    if (diffLines != 1) {
+        // repaints and small scrolls ask for the same lines over and over
+        if (const auto cachedInsn = zone->instructionCache.Find(lineToReach))
+            return cachedInsn;
+    }
+
     uint32 lineDifferences = 1;
     // TODO: first or be transformed into an abs ?
     const bool lineIsAtMargin = lineToReach >= zone->offsetCacheMaxLine;
     if (lineToReach < zone->lastDrawnLine || lineToReach - zone->lastDrawnLine > 1 || lineIsAtMargin) {
-        // TODO: can be inlined as function
-        uint32 codeOffsetIndex      = 0;
-        const auto closestData      = SearchForClosestAsmOffsetLineByLine(zone->cachedCodeOffsets, lineToReach, &codeOffsetIndex);
+        AsmOffsetLine closestData;
+        if (lineToReach < zone->instructionIndex.GetLinesCount()) {
+            // every line is indexed -> start decoding right from the searched line
+            closestData              = { zone->instructionIndex.GetOffset(lineToReach), lineToReach };
+            zone->offsetCacheMaxLine = UINT32_MAX;
+        } else {
+            // TODO: can be inlined as function
+            uint32 codeOffsetIndex = 0;
+            closestData            = SearchForClosestAsmOffsetLineByLine(zone->cachedCodeOffsets, lineToReach, &codeOffsetIndex);
+            if (static_cast<size_t>(codeOffsetIndex) + 1u < zone->cachedCodeOffsets.size())
+                zone->offsetCacheMaxLine = zone->cachedCodeOffsets[static_cast<size_t>(codeOffsetIndex) + 1u].line;
+            else
+                zone->offsetCacheMaxLine = UINT32_MAX;
+        }
         const bool samePreviousZone = closestData.line == zone->lastClosestLine;
         zone->lastClosestLine       = closestData.line;
         zone->asmAddress            = closestData.offset - zone->cachedCodeOffsets[0].offset;
         zone->asmSize               = zone->zoneDetails.size - zone->asmAddress;
-        if (static_cast<size_t>(codeOffsetIndex) + 1u < zone->cachedCodeOffsets.size())
-            zone->offsetCacheMaxLine = zone->cachedCodeOffsets[static_cast<size_t>(codeOffsetIndex) + 1u].line;
-        else
-            zone->offsetCacheMaxLine = UINT32_MAX;
 
         if (!samePreviousZone) {
             // TODO: maybe get less data ?
@@ -269,31 +283,27 @@ inline cs_insn* GetCurrentInstructionByLine(
         return nullptr;
     }
 
-    // TODO: keep the handle open and insn open until the program ends
-    csh handle;
-    const auto resCode = cs_open(CS_ARCH_X86, static_cast<cs_mode>(zone->internalArchitecture), &handle);
+    const auto resCode = zone->instructionCache.Open(zone->internalArchitecture);
     if (resCode != CS_ERR_OK) {
         if (dli)
             dli->WriteErrorToScreen(cs_strerror(resCode));
-        cs_close(&handle);
         return nullptr;
     }
 
-    cs_insn* insn = cs_malloc(handle);
-
+    cs_insn* insn = zone->instructionCache.iteratorInsn;
+    // the iterator position is no longer known until the line is reached
+    zone->lastDrawnLine = UINT32_MAX;
     while (lineDifferences > 0) {
-        if (!cs_disasm_iter(handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
+        if (!cs_disasm_iter(zone->instructionCache.handle, &zone->asmData, (size_t*) &zone->asmSize, &zone->asmAddress, insn)) {
             if (dli)
                 dli->WriteErrorToScreen("Failed to dissasm!");
-            cs_free(insn, 1);
-            cs_close(&handle);
             return nullptr;
         }
         lineDifferences--;
     }
 
-    cs_close(&handle);
-    return insn;
+    zone->lastDrawnLine = lineToReach;
+    return zone->instructionCache.Add(lineToReach, *insn);
 }
 
 inline const MemoryMappingEntry* TryExtractMemoryMapping(const Pointer<SettingsData>& settings, uint64 initialLocation, const uint64 possibleLocationAdjustment)
@@ -374,17 +384,13 @@ std::optional<uint32> DissasmGetCurrentAsmLineAndPrepareCodeZone(DissasmCodeZone
     }
 
     DissasmCodeInternalType& currentType = zone->types.back();
-    // TODO: do a faster search using a binary search using the annotations and start from there
-    // TODO: maybe use some caching here?
     if (reAdapt || levelNow < levelToReach && levelNow + 1 != levelToReach || levelNow > levelToReach && levelNow - 1 != levelToReach) {
         currentType.textLinesPassed = 0;
         currentType.asmLinesPassed  = 0;
-        for (uint32 i = currentType.indexZoneStart; i <= levelToReach; i++) {
-            if (currentType.annotations.contains(i)) {
-                currentType.textLinesPassed++;
-                continue;
-            }
-            currentType.asmLinesPassed++;
+        if (currentType.indexZoneStart <= levelToReach) {
+            const uint32 linesCount     = levelToReach - currentType.indexZoneStart + 1;
+            currentType.textLinesPassed = currentType.annotations.count_in_range(currentType.indexZoneStart, levelToReach);
+            currentType.asmLinesPassed  = linesCount - currentType.textLinesPassed;
         }
     } else {
         if (currentType.annotations.contains(levelToReach))
@@ -438,8 +444,8 @@ bool DissasmAsmPreCacheLine::TryGetDataFromAnnotations(const DissasmCodeInternal
 
 bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& params)
 {
-    uint32 diffLines = 0;
-    cs_insn* insn    = GetCurrentInstructionByLine(params.asmLine, params.zone, params.obj, diffLines, params.dli);
+    uint32 diffLines    = 0;
+    const cs_insn* insn = GetCurrentInstructionByLine(params.asmLine, params.zone, params.obj, diffLines, params.dli);
     if (!insn)
         return false;
 
@@ -452,7 +458,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str      = strdup(params.zoneName->c_str());
         op_str_size = static_cast<uint32>(params.zoneName->size());
         strncpy(mnemonic, "collapsed", std::min<uint32>(sizeof(mnemonic), 9));
-        cs_free(insn, 1);
         return true;
     }
 
@@ -475,7 +480,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
     }
@@ -493,7 +497,7 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
     if (params.zone->asmPreCacheData.HasAnyFlag(params.asmLine))
         alreadyInitComment = true;
 
-    const uint64 finalIndex = params.zone->asmAddress + params.settings->offsetTranslateCallback->TranslateFromFileOffset(
+    const uint64 finalIndex = insn->address + insn->size + params.settings->offsetTranslateCallback->TranslateFromFileOffset(
                                                               params.zone->zoneDetails.entryPoint, (uint32) DissasmPEConversionType::RVA);
     auto& lastZone          = params.zone->types.back().get();
     bool shouldConsiderCall = false;
@@ -559,7 +563,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
             op_str      = strdup(insn->op_str);
             op_str_size = static_cast<uint32>(strlen(op_str));
             // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-            cs_free(insn, 1);
             return true;
         }
 
@@ -586,7 +589,6 @@ bool DissasmAsmPreCacheLine::TryGetDataFromInsn(DissasmInsnExtractLineParams& pa
         op_str_size = (uint32) strlen(op_str);
     }
     // params.zone->asmPreCacheData.cachedAsmLines.push_back(std::move(asmCacheLine));
-    cs_free(insn, 1);
     return true;
 }
 
@@ -958,7 +960,7 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
 {
     uint32 diffLines     = 0;
     uint64 computedValue = 0;
-    cs_insn* insn;
+    const cs_insn* insn;
     if (!offsetToReach) {
         if (line <= 1)
             return;
@@ -983,7 +985,7 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
         }
         if (insn->mnemonic[0] == 'j' || insn->mnemonic[0] == 'c' && *(uint32*) insn->mnemonic == callOP) {
             if (insn->op_str[0] == '0' && insn->op_str[1] == 'x') {
-                char* val = &insn->op_str[2];
+                const char* val = &insn->op_str[2];
 
                 while (*val && *val != ',' && *val != ' ') {
                     if (*val >= '0' && *val <= '9')
@@ -1000,12 +1002,9 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
             } else if (insn->op_str[0] >= '0' && insn->op_str[0] <= '9' && insn->op_str[1] == '\0') {
                 computedValue = zone->cachedCodeOffsets[0].offset + (insn->op_str[0] - '0');
             } else {
-                cs_free(insn, 1);
                 return;
             }
-            cs_free(insn, 1);
         } else {
-            cs_free(insn, 1);
             return;
         }
     } else
@@ -1025,7 +1024,6 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
         Dialogs::MessageBox::ShowNotification("Warning", "There was an error reaching that line!");
         return;
     }
-    cs_free(insn, 1);
 
     // diffLines++; // increased because of the menu bar
 
@@ -1060,6 +1058,98 @@ void Instance::DissasmZoneProcessSpaceKey(DissasmCodeZone* zone, uint32 line, ui
     Cursor.hasMovedView  = true;
 }
 
+bool Instance::GetCurrentDissasmCodeZoneOffset(DissasmCodeZone*& zone, uint32& zoneLine, uint64& offset)
+{
+    const auto zonesFound = GetZonesIndexesFromLinePosition(Cursor.ToLinePosition().line);
+    if (zonesFound.empty() || zonesFound.size() != 1) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please make a selection on a single zone!");
+        return false;
+    }
+    const auto& parseZone = settings->parseZones[zonesFound[0].zoneIndex];
+    if (parseZone->zoneType != DissasmParseZoneType::DissasmCodeParseZone || parseZone->isCollapsed) {
+        Dialogs::MessageBox::ShowNotification("Warning", "Please make a selection on an expanded dissasm zone!");
+        return false;
+    }
+
+    zone     = static_cast<DissasmCodeZone*>(parseZone.get());
+    zoneLine = zonesFound[0].startingLine;
+    if (zoneLine <= 1) {
+        offset = zone->zoneDetails.entryPoint;
+        return true;
+    }
+
+    const decltype(DissasmCodeZone::structureIndex) index = zone->structureIndex;
+    decltype(DissasmCodeZone::types) types                = zone->types;
+    decltype(DissasmCodeZone::levels) levels              = zone->levels;
+
+    auto asmLine = DissasmGetCurrentAsmLineAndPrepareCodeZone(zone, zoneLine - 2);
+    if (!asmLine.has_value()) // annotation line -> the instruction that follows it
+        asmLine = zone->types.back().get().GetCurrentAsmLine();
+
+    zone->structureIndex = index;
+    zone->types          = std::move(types);
+    zone->levels         = std::move(levels);
+
+    const uint32 linesCount = zone->instructionIndex.GetLinesCount();
+    if (linesCount == 0)
+        return false;
+    offset = zone->instructionIndex.GetOffset(std::min(asmLine.value(), linesCount - 1));
+    return true;
+}
+
+void Instance::CommandGoToNextFunction()
+{
+    DissasmCodeZone* zone;
+    uint32 zoneLine;
+    uint64 offset;
+    if (!GetCurrentDissasmCodeZoneOffset(zone, zoneLine, offset))
+        return;
+
+    auto nextFunction = zone->xrefIndex.GetNextFunctionStart(offset);
+    if (!nextFunction.has_value()) {
+        Dialogs::MessageBox::ShowNotification("Info", "There are no more functions in this zone!");
+        return;
+    }
+    DissasmZoneProcessSpaceKey(zone, zoneLine, &nextFunction.value());
+}
+
+void Instance::CommandFindCallers()
+{
+    DissasmCodeZone* zone;
+    uint32 zoneLine;
+    uint64 offset;
+    if (!GetCurrentDissasmCodeZoneOffset(zone, zoneLine, offset))
+        return;
+
+    // pressing the key again on the call site reached previously continues with the next caller of the same function
+    if (callersNavigation.nextCaller == 0 || offset != callersNavigation.lastCallSite) {
+        const auto functionStart = zone->xrefIndex.GetFunctionStart(offset);
+        if (!functionStart.has_value()) {
+            Dialogs::MessageBox::ShowNotification("Info", "The cursor is not inside a known function!");
+            return;
+        }
+        callersNavigation.functionStart = functionStart.value();
+        callersNavigation.nextCaller    = 0;
+    }
+
+    std::vector<uint64> callSites;
+    const auto [start, end] = zone->xrefIndex.GetXrefsTo(callersNavigation.functionStart);
+    for (auto xref = start; xref != end; ++xref)
+        if (xref->type == DissasmXrefIndex::XrefType::Call)
+            callSites.push_back(xref->source);
+    if (callSites.empty()) {
+        LocalString<64> message;
+        message.SetFormat("No calls found to the function 0x%" PRIx64 "!", callersNavigation.functionStart);
+        Dialogs::MessageBox::ShowNotification("Info", message);
+        return;
+    }
+
+    const uint32 callerIndex       = callersNavigation.nextCaller % static_cast<uint32>(callSites.size());
+    callersNavigation.lastCallSite = callSites[callerIndex];
+    callersNavigation.nextCaller   = callerIndex + 1;
+    DissasmZoneProcessSpaceKey(zone, zoneLine, &callersNavigation.lastCallSite);
+}
+
 void Instance::EditDissasmCodeZoneCommand()
 {
     AppCUI::Dialogs::MessageBox::ShowError("Error", "Not implemented yet !");
@@ -1334,7 +1424,6 @@ DissasmAsmPreCacheLine DissasmCodeZone::GetCurrentAsmLine(uint32 currentLine, Re
 
     const auto isValidData = asmCacheLine.TryGetDataFromInsn(*paramsPtr);
     assert(isValidData);
-    lastDrawnLine = asmLine;
 
     // uint32 difflines = 0;
     // auto insn        = GetCurrentInstructionByLine(value - 1, this, obj, difflines);
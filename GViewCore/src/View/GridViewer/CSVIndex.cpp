@@ -0,0 +1,331 @@
+#include "GridViewer.hpp"
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define GRIDVIEWER_CSV_SSE2
+#endif
+
+using namespace GView::View::GridViewer;
+
+namespace
+{
+constexpr uint32 BLOCK_SIZE   = 64;
+constexpr uint64 NO_LINE_FEED = 0xFFFFFFFFFFFFFFFFULL;
+constexpr uint64 INVALID_ROW  = 0xFFFFFFFFFFFFFFFFULL;
+
+struct BlockMasks {
+    uint64 separator;
+    uint64 quote;
+    uint64 lineBreak; // '\n' and '\r'
+};
+
+// one bit for every byte of the block that matches
+void ClassifyBlock(const uint8* data, uint32 size, char separator, BlockMasks& masks)
+{
+#ifdef GRIDVIEWER_CSV_SSE2
+    if (size == BLOCK_SIZE) {
+        const auto separators = _mm_set1_epi8(separator);
+        const auto quotes     = _mm_set1_epi8('"');
+        const auto lineFeeds  = _mm_set1_epi8('\n');
+        const auto carriages  = _mm_set1_epi8('\r');
+        masks                 = {};
+        for (auto i = 0U; i < BLOCK_SIZE; i += 16) {
+            const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            masks.separator |= static_cast<uint64>(static_cast<uint16>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, separators)))) << i;
+            masks.quote |= static_cast<uint64>(static_cast<uint16>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quotes)))) << i;
+            masks.lineBreak |= static_cast<uint64>(static_cast<uint16>(
+                                     _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, lineFeeds), _mm_cmpeq_epi8(bytes, carriages)))))
+                               << i;
+        }
+        return;
+    }
+#endif
+    // portable path (and the tail of the file); written so that compilers can vectorize it
+    masks = {};
+    for (auto i = 0U; i < size; i++) {
+        const auto ch = static_cast<char>(data[i]);
+        masks.separator |= static_cast<uint64>(ch == separator) << i;
+        masks.quote |= static_cast<uint64>(ch == '"') << i;
+        masks.lineBreak |= static_cast<uint64>(ch == '\n' || ch == '\r') << i;
+    }
+}
+
+// bits [from, to) of a block
+uint64 BitRange(uint32 from, uint32 to)
+{
+    const auto high = to < BLOCK_SIZE ? ~(~0ULL << to) : ~0ULL;
+    return (~0ULL << from) & high;
+}
+
+/*
+ * Walks the rows in [offset, fileSize); offset must not be inside a quoted field.
+ * getChunk(position, length) returns the bytes to classify (every chunk but the last one is a multiple of BLOCK_SIZE).
+ * onField(rowStart, fieldEnd) is called for every field, onRow(rowStart, rowEnd) after the last field of a row;
+ * the scan stops when onRow returns false. "\r\n" is a single line break.
+ */
+template <typename GetChunk, typename OnField, typename OnRow>
+bool ScanRows(uint64 offset, uint64 fileSize, uint64 chunkSize, char separator, GetChunk&& getChunk, OnField&& onField, OnRow&& onRow)
+{
+    uint64 rowStart   = offset;
+    uint64 lineFeed   = NO_LINE_FEED; // a '\n' at this offset completes the "\r\n" of the previous row
+    uint64 inQuotes   = 0;            // all bits set while inside a quoted field
+    uint64 fieldStart = 1;            // 1 if the first byte of the next block starts a field
+    uint64 reopen     = NO_LINE_FEED; // a quote at this offset follows a closing quote ("" inside a quoted field)
+    BlockMasks masks;
+
+    for (auto position = offset; position < fileSize;) {
+        const auto length = static_cast<uint32>(std::min<uint64>(chunkSize, fileSize - position));
+        const auto view   = getChunk(position, length);
+        CHECK(view.IsValid(), false, "Unable to read %u bytes from %llu", length, position);
+        const auto data = view.GetData();
+
+        for (auto block = 0U; block < length; block += BLOCK_SIZE) {
+            const auto size = std::min<uint32>(BLOCK_SIZE, length - block);
+            ClassifyBlock(data + block, size, separator, masks);
+
+            // a quote opens a quoted field only if it is the first character of the field (or it follows the closing quote of
+            // an escaped "" pair); a stray quote inside an unquoted field is plain data
+            auto quoted = inQuotes;
+            if (masks.quote) {
+                const auto fieldStarts = ((masks.separator | masks.lineBreak) << 1) | fieldStart;
+                auto quotes            = masks.quote;
+                auto from              = 0U;
+                quoted                 = 0;
+                while (quotes) {
+                    const auto bit = static_cast<uint32>(std::countr_zero(quotes));
+                    quotes &= quotes - 1;
+
+                    const auto at = position + block + bit;
+                    if (inQuotes) {
+                        quoted |= BitRange(from, bit);
+                        inQuotes = 0;
+                        reopen   = at + 1;
+                    } else if (((fieldStarts >> bit) & 1) || at == reopen) {
+                        from     = bit;
+                        inQuotes = ~0ULL;
+                    }
+                }
+                if (inQuotes) {
+                    quoted |= BitRange(from, BLOCK_SIZE);
+                }
+            }
+            fieldStart = ((masks.separator | masks.lineBreak) >> (BLOCK_SIZE - 1)) & 1;
+
+            auto structural = (masks.separator | masks.lineBreak) & ~quoted;
+            while (structural) {
+                const auto bit = std::countr_zero(structural);
+                structural &= structural - 1;
+
+                const auto at = position + block + bit;
+                const auto ch = static_cast<char>(data[block + bit]);
+                if (ch == separator) {
+                    onField(rowStart, at);
+                } else if (at == lineFeed && ch == '\n') {
+                    rowStart = at + 1;
+                } else {
+                    onField(rowStart, at);
+                    if (!onRow(rowStart, at)) {
+                        return true;
+                    }
+                    rowStart = at + 1;
+                    lineFeed = ch == '\r' ? at + 1 : NO_LINE_FEED;
+                }
+            }
+        }
+        position += length;
+    }
+
+    // the last row has no line break
+    if (rowStart < fileSize) {
+        onField(rowStart, fileSize);
+        onRow(rowStart, fileSize);
+    }
+    return true;
+}
+
+template <typename OnField, typename OnRow>
+bool ScanRows(GView::Utils::DataCache& cache, uint64 offset, char separator, OnField&& onField, OnRow&& onRow)
+{
+    const auto chunkSize = std::max<uint64>(cache.GetCacheSize() & ~static_cast<uint64>(BLOCK_SIZE - 1), BLOCK_SIZE);
+    const auto getChunk  = [&cache](uint64 position, uint32 length) { return cache.Get(position, length, true); };
+    return ScanRows(offset, cache.GetSize(), chunkSize, separator, getChunk, onField, onRow);
+}
+} // namespace
+
+void CSVIndex::Clear()
+{
+    rowOffsets.clear();
+    fieldsStart.clear();
+    fieldEnds.clear();
+    rowsCount          = 0;
+    columnsCount       = 0;
+    checkpointInterval = 0;
+}
+
+bool CSVIndex::Build(GView::Utils::DataCache& cache, char separator, uint32 checkpointInterval)
+{
+    Clear();
+    this->separator          = separator;
+    this->checkpointInterval = checkpointInterval;
+
+    uint32 fieldsInRow = 0;
+    bool valid         = true;
+
+    const auto onField = [&](uint64 rowStart, uint64 fieldEnd) {
+        fieldsInRow++;
+        if (checkpointInterval == 0) {
+            // a row longer than 4GB can not be indexed with 32 bit field offsets
+            valid &= fieldEnd - rowStart <= 0xFFFFFFFFULL;
+            fieldEnds.push_back(static_cast<uint32>(fieldEnd - rowStart));
+        }
+    };
+    const auto onRow = [&](uint64 rowStart, uint64 rowEnd) {
+        if (checkpointInterval == 0) {
+            rowOffsets.push_back(rowStart);
+            fieldsStart.push_back(fieldEnds.size() - fieldsInRow);
+        } else if (rowsCount % checkpointInterval == 0) {
+            rowOffsets.push_back(rowStart);
+        }
+        columnsCount = std::max(columnsCount, fieldsInRow);
+        fieldsInRow  = 0;
+        rowsCount++;
+        return valid;
+    };
+
+    CHECK(ScanRows(cache, 0, separator, onField, onRow), false, "");
+    CHECK(valid, false, "Row %llu is too long to be indexed", rowsCount);
+
+    if (checkpointInterval == 0) {
+        fieldsStart.push_back(fieldEnds.size());
+    }
+    rowOffsets.shrink_to_fit();
+    fieldsStart.shrink_to_fit();
+    fieldEnds.shrink_to_fit();
+    return true;
+}
+
+bool CSVIndex::GetRow(GView::Utils::DataCache& cache, uint64 row, std::vector<std::pair<uint64, uint64>>& fields) const
+{
+    fields.clear();
+    CHECK(row < rowsCount, false, "");
+
+    if (checkpointInterval == 0) {
+        const auto rowStart = rowOffsets[row];
+        auto fieldStart     = rowStart;
+        for (auto i = fieldsStart[row]; i < fieldsStart[row + 1]; i++) {
+            const auto fieldEnd = rowStart + fieldEnds[i];
+            fields.emplace_back(fieldStart, fieldEnd);
+            fieldStart = fieldEnd + 1;
+        }
+        return true;
+    }
+
+    // tokenize forward from the closest checkpoint
+    auto remaining  = row % checkpointInterval;
+    auto fieldStart = rowOffsets[row / checkpointInterval];
+    const auto onField = [&](uint64 rowStart, uint64 fieldEnd) {
+        if (fields.empty()) {
+            fieldStart = rowStart;
+        }
+        fields.emplace_back(fieldStart, fieldEnd);
+        fieldStart = fieldEnd + 1;
+    };
+    const auto onRow = [&](uint64, uint64) {
+        if (remaining == 0) {
+            return false;
+        }
+        remaining--;
+        fields.clear();
+        return true;
+    };
+
+    CHECK(ScanRows(cache, rowOffsets[row / checkpointInterval], separator, onField, onRow), false, "");
+    return remaining == 0;
+}
+
+CSVDataSource::CSVDataSource(Reference<GView::Object> obj, const CSVIndex& index) : obj(obj), index(index), fieldsRow(INVALID_ROW)
+{
+}
+
+uint64 CSVDataSource::GetRowsCount()
+{
+    return index.GetRowsCount();
+}
+
+bool CSVDataSource::HasRow(uint64 row)
+{
+    return row < index.GetRowsCount();
+}
+
+uint32 CSVDataSource::GetColumnsCount()
+{
+    return index.GetColumnsCount();
+}
+
+bool CSVDataSource::GetColumnName(uint32 column, String& name)
+{
+    return false;
+}
+
+bool CSVDataSource::GetCell(uint64 row, uint32 column, String& value)
+{
+    // cells are asked row by row -> tokenize each row once
+    if (fieldsRow != row) {
+        fieldsRow = INVALID_ROW;
+        CHECK(index.GetRow(obj->GetData(), row, fields), false, "");
+        fieldsRow = row;
+    }
+    if (column >= fields.size()) {
+        value.Clear();
+        return true;
+    }
+
+    const auto& [start, end] = fields[column];
+    const auto token         = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
+    return value.Set(reinterpret_cast<const char*>(token.GetData()), static_cast<uint32>(token.GetLength()));
+}
+
+void CSVIndex::GetBatches(uint64 fileSize, uint64 batchSize, std::vector<RowsBatch>& batches) const
+{
+    batches.clear();
+    CHECKRET(rowsCount > 0, "");
+
+    // full mode can split at any row, sparse mode only at checkpoints
+    const auto rowsPerOffset = checkpointInterval == 0 ? 1ULL : static_cast<uint64>(checkpointInterval);
+    size_t first             = 0;
+    while (first < rowOffsets.size()) {
+        const auto limit = rowOffsets[first] + std::max<uint64>(batchSize, 1);
+        auto next        = static_cast<size_t>(std::upper_bound(rowOffsets.begin() + first + 1, rowOffsets.end(), limit) - rowOffsets.begin());
+        // a row (or checkpoint interval) larger than batchSize is a batch of its own
+        next = std::max(next, first + 1);
+
+        RowsBatch batch;
+        batch.firstRow = first * rowsPerOffset;
+        batch.start    = rowOffsets[first];
+        batch.end      = next < rowOffsets.size() ? rowOffsets[next] : fileSize;
+        batch.rows     = std::min<uint64>(next * rowsPerOffset, rowsCount) - batch.firstRow;
+        batches.push_back(batch);
+        first = next;
+    }
+}
+
+bool CSVIndex::ForEachRow(BufferView buffer, char separator, const std::function<bool(const std::vector<std::pair<uint32, uint32>>&)>& onRow)
+{
+    std::vector<std::pair<uint32, uint32>> fields;
+    uint32 fieldStart  = 0;
+    const auto onField = [&](uint64 rowStart, uint64 fieldEnd) {
+        if (fields.empty()) {
+            fieldStart = static_cast<uint32>(rowStart);
+        }
+        fields.emplace_back(fieldStart, static_cast<uint32>(fieldEnd));
+        fieldStart = static_cast<uint32>(fieldEnd + 1);
+    };
+    const auto onRowEnd = [&](uint64, uint64) {
+        const auto result = onRow(fields);
+        fields.clear();
+        return result;
+    };
+    const auto getChunk = [&buffer](uint64 position, uint32 length) { return BufferView{ buffer.GetData() + position, length }; };
+    return ScanRows(0, buffer.GetLength(), buffer.GetLength(), separator, getChunk, onField, onRowEnd);
+}
@@ -0,0 +1,351 @@
+#include "GridViewer.hpp"
+#include <bit>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+using namespace GView::View::GridViewer;
+
+namespace
+{
+constexpr uint64 BATCH_SIZE    = 4 * 1024 * 1024;
+constexpr auto PROGRESS_PERIOD = std::chrono::milliseconds(100);
+constexpr uint32 HLL_BITS      = 12;
+constexpr uint32 HLL_REGISTERS = 1U << HLL_BITS;
+
+// distinct values estimate in HLL_REGISTERS bytes (~1.6% standard error)
+class HyperLogLog
+{
+    std::vector<uint8> registers;
+
+  public:
+    HyperLogLog() : registers(HLL_REGISTERS, 0)
+    {
+    }
+
+    void Add(uint64 hash)
+    {
+        const auto index = static_cast<uint32>(hash >> (64 - HLL_BITS));
+        const auto rest  = hash << HLL_BITS;
+        const auto rank  = static_cast<uint8>(rest ? std::countl_zero(rest) + 1 : 64 - HLL_BITS + 1);
+        registers[index] = std::max(registers[index], rank);
+    }
+    void Merge(const HyperLogLog& other)
+    {
+        for (auto i = 0U; i < HLL_REGISTERS; i++) {
+            registers[i] = std::max(registers[i], other.registers[i]);
+        }
+    }
+    uint64 Estimate() const
+    {
+        constexpr double m     = HLL_REGISTERS;
+        constexpr double alpha = 0.7213 / (1.0 + 1.079 / m);
+
+        double sum   = 0;
+        uint32 zeros = 0;
+        for (const auto value : registers) {
+            sum += std::ldexp(1.0, -static_cast<int>(value));
+            zeros += value == 0;
+        }
+        auto estimate = alpha * m * m / sum;
+        // few values -> linear counting is more precise
+        if (estimate <= 2.5 * m && zeros > 0) {
+            estimate = m * std::log(m / zeros);
+        }
+        return static_cast<uint64>(std::llround(estimate));
+    }
+};
+
+uint64 Hash(std::string_view value)
+{
+    // FNV-1a followed by a 64 bit finalizer, so that the top bits (the register index) are well mixed
+    uint64 hash = 0xCBF29CE484222325ULL;
+    for (const auto ch : value) {
+        hash = (hash ^ static_cast<uint8>(ch)) * 0x100000001B3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+std::string_view Unquote(std::string_view value)
+{
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        return value.substr(1, value.size() - 2);
+    }
+    return value;
+}
+
+struct ColumnState
+{
+    ColumnProfile profile;
+    HyperLogLog distinct;
+
+    ColumnState()
+    {
+        profile               = {};
+        profile.type          = ColumnProfile::Type::Empty;
+        profile.minimum       = std::numeric_limits<double>::infinity();
+        profile.maximum       = -std::numeric_limits<double>::infinity();
+        profile.minimumLength = std::numeric_limits<uint32>::max();
+    }
+
+    void Add(std::string_view value)
+    {
+        value = Unquote(value);
+        if (value.empty()) {
+            profile.empty++;
+            return;
+        }
+
+        profile.values++;
+        profile.minimumLength = std::min(profile.minimumLength, static_cast<uint32>(value.size()));
+        profile.maximumLength = std::max(profile.maximumLength, static_cast<uint32>(value.size()));
+        distinct.Add(Hash(value));
+
+        const auto end = value.data() + value.size();
+        auto type      = ColumnProfile::Type::Text;
+        double number  = 0;
+        int64 integer  = 0;
+        if (auto result = std::from_chars(value.data(), end, integer); result.ec == std::errc() && result.ptr == end) {
+            type   = ColumnProfile::Type::Integer;
+            number = static_cast<double>(integer);
+        } else if (auto result = std::from_chars(value.data(), end, number); result.ec == std::errc() && result.ptr == end) {
+            type = ColumnProfile::Type::Float;
+        }
+
+        if (type != ColumnProfile::Type::Text) {
+            profile.numeric++;
+            profile.minimum = std::min(profile.minimum, number);
+            profile.maximum = std::max(profile.maximum, number);
+        }
+        profile.type = std::max(profile.type, type);
+    }
+
+    void Merge(const ColumnState& other)
+    {
+        profile.type          = std::max(profile.type, other.profile.type);
+        profile.values        += other.profile.values;
+        profile.empty         += other.profile.empty;
+        profile.numeric       += other.profile.numeric;
+        profile.minimum       = std::min(profile.minimum, other.profile.minimum);
+        profile.maximum       = std::max(profile.maximum, other.profile.maximum);
+        profile.minimumLength = std::min(profile.minimumLength, other.profile.minimumLength);
+        profile.maximumLength = std::max(profile.maximumLength, other.profile.maximumLength);
+        distinct.Merge(other.distinct);
+    }
+};
+
+uint32 GetWorkersCount()
+{
+    return std::max<uint32>(std::thread::hardware_concurrency(), 1);
+}
+
+/*
+ * Reads up to 'workers' batches at a time, starting with the first batch at or after position, and gives each of them to a
+ * thread: work(worker, batch, buffer, stop) runs on the workers (and should return early once stop is set), afterRound(firstBatch,
+ * count, used) on the calling thread once they are done. afterRound returns false to stop and sets used to the number of batches
+ * it consumed; position is moved past them, so that a later call resumes with the next batch.
+ * Returns false on errors and if onProgress canceled the pass.
+ */
+template <typename Work, typename AfterRound>
+bool ForEachBatch(
+      GView::Utils::DataCache& cache,
+      const CSVIndex& index,
+      uint32 workers,
+      uint64& position,
+      Work&& work,
+      AfterRound&& afterRound,
+      const ColumnEngine::ProgressCallback& onProgress)
+{
+    std::vector<CSVIndex::RowsBatch> batches;
+    index.GetBatches(cache.GetSize(), BATCH_SIZE, batches);
+
+    std::vector<Buffer> buffers(workers);
+    std::atomic<bool> stop = false;
+    std::mutex lock;
+    std::condition_variable done;
+
+    const auto startsBefore = [](const CSVIndex::RowsBatch& batch, uint64 value) { return batch.start < value; };
+    auto next               = static_cast<size_t>(std::lower_bound(batches.begin(), batches.end(), position, startsBefore) - batches.begin());
+    while (next < batches.size()) {
+        const auto count = static_cast<uint32>(std::min<size_t>(workers, batches.size() - next));
+
+        // DataCache is not thread safe, so all the reads happen here
+        for (auto i = 0U; i < count; i++) {
+            const auto& batch = batches[next + i];
+            CHECK(batch.end - batch.start <= 0xFFFFFFFFULL, false, "Batch of %llu bytes is too large", batch.end - batch.start);
+            buffers[i] = cache.CopyToBuffer(batch.start, static_cast<uint32>(batch.end - batch.start), true);
+            CHECK(buffers[i].IsValid(), false, "Unable to read %llu bytes from %llu", batch.end - batch.start, batch.start);
+        }
+
+        uint32 running = count;
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (auto i = 0U; i < count; i++) {
+            threads.emplace_back([&, i]() {
+                work(i, batches[next + i], buffers[i], stop);
+                std::lock_guard<std::mutex> guard(lock);
+                running--;
+                done.notify_one();
+            });
+        }
+        // the calling thread (the UI) keeps reporting progress while the workers run
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (!done.wait_for(guard, PROGRESS_PERIOD, [&running]() { return running == 0; })) {
+                guard.unlock();
+                if (!stop && !onProgress(batches[next].start, cache.GetSize())) {
+                    stop = true;
+                }
+                guard.lock();
+            }
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        if (stop || !onProgress(batches[next + count - 1].end, cache.GetSize())) {
+            return false;
+        }
+
+        auto used       = count;
+        const auto more = afterRound(next, count, used);
+        if (used > 0) {
+            position = batches[next + used - 1].end;
+        }
+        if (!more) {
+            return true;
+        }
+        next += count;
+    }
+    position = cache.GetSize();
+    return true;
+}
+} // namespace
+
+bool ColumnEngine::Profile(
+      GView::Utils::DataCache& cache, const CSVIndex& index, uint64 firstRow, std::vector<ColumnProfile>& profiles, const ProgressCallback& onProgress)
+{
+    const auto workers   = GetWorkersCount();
+    const auto columns   = index.GetColumnsCount();
+    const auto separator = index.GetSeparator();
+
+    std::vector<std::vector<ColumnState>> states(workers, std::vector<ColumnState>(columns));
+    const auto work = [&](uint32 worker, const CSVIndex::RowsBatch& batch, const Buffer& buffer, const std::atomic<bool>& stop) {
+        auto& columnStates = states[worker];
+        auto row           = batch.firstRow;
+        const auto data    = reinterpret_cast<const char*>(buffer.GetData());
+        CSVIndex::ForEachRow(buffer, separator, [&](const std::vector<std::pair<uint32, uint32>>& fields) {
+            if (row++ < firstRow) {
+                return true;
+            }
+            for (auto i = 0U; i < fields.size() && i < columns; i++) {
+                columnStates[i].Add({ data + fields[i].first, fields[i].second - fields[i].first });
+            }
+            // short rows -> the missing fields are empty
+            for (auto i = static_cast<uint32>(fields.size()); i < columns; i++) {
+                columnStates[i].profile.empty++;
+            }
+            return !stop;
+        });
+    };
+    uint64 position = 0;
+    if (!ForEachBatch(cache, index, workers, position, work, [](size_t, uint32, uint32&) { return true; }, onProgress)) {
+        return false;
+    }
+
+    profiles.clear();
+    for (auto i = 0U; i < columns; i++) {
+        for (auto worker = 1U; worker < workers; worker++) {
+            states[0][i].Merge(states[worker][i]);
+        }
+        auto& profile    = profiles.emplace_back(states[0][i].profile);
+        profile.distinct = profile.values > 0 ? std::min(states[0][i].distinct.Estimate(), profile.values) : 0;
+        if (profile.values == 0) {
+            profile.minimumLength = 0;
+        }
+    }
+    return true;
+}
+
+bool ColumnEngine::Search(
+      GView::Utils::DataCache& cache,
+      const CSVIndex& index,
+      uint64 firstRow,
+      std::string_view text,
+      bool isRegex,
+      bool ignoreCase,
+      uint64& position,
+      const std::function<bool(const std::vector<SearchHit>&)>& onHits,
+      const ProgressCallback& onProgress)
+{
+    CHECK(!text.empty(), false, "");
+
+    const auto workers   = GetWorkersCount();
+    const auto separator = index.GetSeparator();
+
+    // one matcher per worker, the regex context is not shared between threads
+    // Matcher::Match reports the first capturing group -> the whole expression is wrapped in one
+    std::unique_ptr<GView::Regex::Matcher[]> matchers;
+    if (isRegex) {
+        const auto expression = "(" + std::string(text) + ")";
+        matchers.reset(new GView::Regex::Matcher[workers]);
+        for (auto i = 0U; i < workers; i++) {
+            CHECK(matchers[i].Init(expression, false, !ignoreCase), false, "Invalid regular expression");
+        }
+    }
+
+    const auto lower      = [](char ch) { return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch | 0x20) : ch; };
+    const auto equalsCase = [&](char a, char b) { return lower(a) == lower(b); };
+
+    std::vector<std::vector<SearchHit>> hits(workers);
+    const auto work = [&](uint32 worker, const CSVIndex::RowsBatch& batch, const Buffer& buffer, const std::atomic<bool>& stop) {
+        auto& workerHits = hits[worker];
+        auto row         = batch.firstRow;
+        const auto data  = reinterpret_cast<const char*>(buffer.GetData());
+        workerHits.clear();
+        CSVIndex::ForEachRow(buffer, separator, [&](const std::vector<std::pair<uint32, uint32>>& fields) {
+            if (row < firstRow) {
+                row++;
+                return true;
+            }
+            for (auto i = 0U; i < fields.size(); i++) {
+                const std::string_view value{ data + fields[i].first, fields[i].second - fields[i].first };
+                bool found;
+                if (isRegex) {
+                    uint64 start, end;
+                    found = matchers[worker].Match(BufferView{ value.data(), value.size() }, start, end);
+                } else if (ignoreCase) {
+                    found = std::search(value.begin(), value.end(), text.begin(), text.end(), equalsCase) != value.end();
+                } else {
+                    found = value.find(text) != std::string_view::npos;
+                }
+                if (found) {
+                    workerHits.push_back({ row, i });
+                }
+            }
+            row++;
+            return !stop;
+        });
+    };
+    // batches of a round are consecutive -> delivering them in worker order keeps the hits sorted by row
+    const auto afterRound = [&](size_t, uint32 count, uint32& used) {
+        for (auto i = 0U; i < count; i++) {
+            if (!hits[i].empty() && !onHits(hits[i])) {
+                // the hits of this batch were delivered -> a later search resumes with the next one
+                used = i + 1;
+                return false;
+            }
+        }
+        return true;
+    };
+    return ForEachBatch(cache, index, workers, position, work, afterRound, onProgress);
+}
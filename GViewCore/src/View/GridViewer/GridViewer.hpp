@@ -17,6 +17,10 @@ namespace View
             constexpr uint32 COMMAND_ID_VIEW_CELL_CONTENT           = 0x1003;
             constexpr uint32 COMMAND_ID_EXPORT_CELL_CONTENT         = 0x1004;
             constexpr uint32 COMMAND_ID_EXPORT_COLUMN_CONTENT       = 0x1005;
+            constexpr uint32 COMMAND_ID_NEXT_PAGE                   = 0x1006;
+            constexpr uint32 COMMAND_ID_PREVIOUS_PAGE               = 0x1007;
+            constexpr uint32 COMMAND_ID_PROFILE_COLUMNS             = 0x1008;
+            constexpr uint32 COMMAND_ID_FIND_ALL                    = 0x1009;
 
             static KeyboardControl ReplaceHeader = { Key::Space, "ReplaceHeader", "Replace header with first row", COMMAND_ID_REPLACE_HEADER_WITH_1ST_ROW };
 
@@ -34,15 +38,163 @@ namespace View
                 Key::Ctrl | Key::Alt | Key::S, "ExportColumnContent", "Export the content of the current column", COMMAND_ID_EXPORT_COLUMN_CONTENT
             };
 
-            static std::array AllGridCommands = { &ReplaceHeader, &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent, &ExportCellContent, &ExportColumnContent };
+            static KeyboardControl NextPage     = { Key::Alt | Key::PageDown, "NextPage", "Show the next page of rows", COMMAND_ID_NEXT_PAGE };
+            static KeyboardControl PreviousPage = { Key::Alt | Key::PageUp, "PreviousPage", "Show the previous page of rows", COMMAND_ID_PREVIOUS_PAGE };
+
+            static KeyboardControl ProfileColumns = {
+                Key::Ctrl | Key::P, "ProfileColumns", "Show the type, range and distinct values of every column", COMMAND_ID_PROFILE_COLUMNS
+            };
+            static KeyboardControl FindAll = { Key::Ctrl | Key::Shift | Key::F, "FindAll", "List all the cells that match a text or regex", COMMAND_ID_FIND_ALL };
+
+            static std::array AllGridCommands = { &ReplaceHeader,     &ToggleHorizontalLines, &ToggleVerticalLines, &ViewCellContent,
+                                                  &ExportCellContent, &ExportColumnContent,   &NextPage,            &PreviousPage,
+                                                  &ProfileColumns,    &FindAll };
         }
 
 
+        /*
+         * Row and field boundaries of a separated values file. The file is classified 64 bytes at a time into
+         * separator / quote / line break bitmasks; quoted regions are removed from the masks with a prefix XOR.
+         * Full mode keeps the start of every row and the end of every field (relative to its row) in flat arrays;
+         * sparse mode keeps only the start of every checkpointInterval-th row and tokenizes the others on demand.
+         */
+        class CSVIndex
+        {
+          public:
+            static constexpr uint32 DEFAULT_CHECKPOINT_INTERVAL = 1024;
+
+          private:
+            std::vector<uint64> rowOffsets;  // full mode: start of every row, sparse mode: start of every checkpoint row
+            std::vector<uint64> fieldsStart; // full mode: index in fieldEnds of the first field of every row (+ end)
+            std::vector<uint32> fieldEnds;   // full mode: end of every field, relative to the start of its row
+            uint64 rowsCount{ 0 };
+            uint32 columnsCount{ 0 };
+            uint32 checkpointInterval{ 0 }; // 0 -> full mode
+            char separator{ ',' };
+
+          public:
+            // consecutive rows that start and end on row boundaries; [start, end) includes the final line break
+            struct RowsBatch
+            {
+                uint64 firstRow;
+                uint64 rows;
+                uint64 start;
+                uint64 end;
+            };
+
+            bool Build(GView::Utils::DataCache& cache, char separator, uint32 checkpointInterval = 0);
+            void Clear();
+
+            // splits all the rows in batches of about batchSize bytes (sparse indexes split only at checkpoints)
+            void GetBatches(uint64 fileSize, uint64 batchSize, std::vector<RowsBatch>& batches) const;
+            // tokenizes a buffer that starts on a row boundary; fields are [start, end) offsets in the buffer
+            static bool ForEachRow(BufferView buffer, char separator, const std::function<bool(const std::vector<std::pair<uint32, uint32>>&)>& onRow);
+            char GetSeparator() const
+            {
+                return separator;
+            }
+
+            // [start, end) of every field of the row, quotes included
+            bool GetRow(GView::Utils::DataCache& cache, uint64 row, std::vector<std::pair<uint64, uint64>>& fields) const;
+
+            uint64 GetRowsCount() const
+            {
+                return rowsCount;
+            }
+            uint32 GetColumnsCount() const
+            {
+                return columnsCount;
+            }
+            bool IsSparse() const
+            {
+                return checkpointInterval != 0;
+            }
+        };
+
+        struct ColumnProfile
+        {
+            enum class Type : uint8
+            {
+                Empty,
+                Integer,
+                Float,
+                Text,
+            };
+
+            Type type; // the widest type of the values of the column
+            uint64 values;
+            uint64 empty;
+            uint64 numeric;  // values that parse as numbers (minimum / maximum are valid if > 0)
+            uint64 distinct; // HyperLogLog estimate
+            double minimum;
+            double maximum;
+            uint32 minimumLength;
+            uint32 maximumLength;
+        };
+
+        struct SearchHit
+        {
+            uint64 row;
+            uint32 column;
+        };
+
+        /*
+         * Parallel passes over the rows of a CSVIndex. Rows are read in batches on the calling thread (DataCache is not
+         * thread safe) and every batch is split between the worker threads. Rows before firstRow (a header) are skipped.
+         * While the workers run, onProgress(scannedBytes, totalBytes) is called on the calling thread every few milliseconds;
+         * returning false cancels the pass.
+         */
+        class ColumnEngine
+        {
+          public:
+            using ProgressCallback = std::function<bool(uint64, uint64)>;
+
+            // false if the pass failed or was canceled
+            static bool Profile(
+                  GView::Utils::DataCache& cache,
+                  const CSVIndex& index,
+                  uint64 firstRow,
+                  std::vector<ColumnProfile>& profiles,
+                  const ProgressCallback& onProgress);
+
+            // scans the rows that start at or after position; onHits gets the hits of every batch, in row order, as soon as the
+            // batch is done and returning false stops the search. On return position is the offset where a later call resumes
+            // the search (the size of the file once all of it was searched).
+            static bool Search(
+                  GView::Utils::DataCache& cache,
+                  const CSVIndex& index,
+                  uint64 firstRow,
+                  std::string_view text,
+                  bool isRegex,
+                  bool ignoreCase,
+                  uint64& position,
+                  const std::function<bool(const std::vector<SearchHit>&)>& onHits,
+                  const ProgressCallback& onProgress);
+        };
+
+        // the default data source: the cells of a separated values file, read through its CSVIndex
+        class CSVDataSource : public DataSourceInterface
+        {
+            Reference<GView::Object> obj;
+            const CSVIndex& index;
+            std::vector<std::pair<uint64, uint64>> fields; // of the last row read
+            uint64 fieldsRow;
+
+          public:
+            CSVDataSource(Reference<GView::Object> obj, const CSVIndex& index);
+
+            uint64 GetRowsCount() override;
+            bool HasRow(uint64 row) override;
+            uint32 GetColumnsCount() override;
+            bool GetColumnName(uint32 column, String& name) override;
+            bool GetCell(uint64 row, uint32 column, String& value) override;
+        };
+
         struct SettingsData
         {
             String name;
-            std::map<uint64, std::pair<uint64, uint64>> lines;
-            std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
+            CSVIndex index;
+            std::unique_ptr<DataSourceInterface> dataSource;
             char separator[2]{ "," };
             uint64 rows           = 0;
             uint64 cols           = 0;
@@ -99,6 +251,53 @@ namespace View
             bool SetDescription();
             bool Update();
             std::u16string GetFilterValue();
+            bool IsRegex()
+            {
+                return textRegex->IsChecked();
+            }
+            bool IgnoreCase()
+            {
+                return ignoreCase->IsChecked();
+            }
+        };
+
+        class ProfileDialog : public Window
+        {
+          public:
+            ProfileDialog(const std::vector<ColumnProfile>& profiles, const std::vector<std::string>& names);
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+        };
+
+        // the hits are added batch after batch; "More" asks onMore to search further (it returns false once nothing is left)
+        class HitsDialog : public Window, public Handlers::OnListViewItemPressedInterface
+        {
+            DataSourceInterface& source;
+            const std::vector<std::string>& names;
+            std::function<bool(HitsDialog&)> onMore;
+            Reference<Label> status;
+            Reference<ListView> list;
+            Reference<Button> more;
+            uint64 selectedRow;
+            size_t hitsCount;
+
+          public:
+            HitsDialog(DataSourceInterface& source, const std::vector<std::string>& names, std::function<bool(HitsDialog&)> onMore);
+
+            void AddHits(const std::vector<SearchHit>& hits);
+            void UpdateStatus(bool finished);
+            size_t GetHitsCount() const
+            {
+                return hitsCount;
+            }
+
+            virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
+            virtual void OnListViewItemPressed(Reference<Controls::ListView> lv, Controls::ListViewItem item) override;
+
+            uint64 GetSelectedRow() const
+            {
+                return selectedRow;
+            }
         };
 
         struct Config
@@ -124,6 +323,10 @@ namespace View
             Reference<GView::Object> obj;
             Reference<AppCUI::Controls::Grid> grid;
             Pointer<SettingsData> settings;
+            uint64 firstRow; // of the page loaded in the grid
+            bool populated;  // false until the grid asks its data source for the first page
+            std::vector<ColumnProfile> profiles;
+            bool profilesWithHeader;
 
             static Config config;
             FindDialog findDialog;
@@ -143,6 +346,7 @@ namespace View
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
 
             virtual void OnStart() override;
+            virtual void OnFocus() override;
 
             // property interface
             bool GetPropertyValue(uint32 id, PropertyValue& value) override;
@@ -163,6 +367,9 @@ namespace View
           private:
             void PopulateGrid();
             void ProcessContent();
+            void GetColumnNames(std::vector<std::string>& names);
+            void ShowColumnProfiles();
+            void FindAllCells();
             void PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationHeight(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
             void PaintCursorInformationCells(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y);
@@ -0,0 +1,73 @@
+#include "GridViewer.hpp"
+
+namespace GView::View::GridViewer
+{
+constexpr int32 BTN_ID_GOTO   = 1;
+constexpr int32 BTN_ID_MORE   = 2;
+constexpr int32 BTN_ID_CANCEL = 3;
+
+HitsDialog::HitsDialog(DataSourceInterface& source, const std::vector<std::string>& names, std::function<bool(HitsDialog&)> onMore)
+    : Window("Matches", "d:c,w:80%,h:80%", WindowFlags::ProcessReturn | WindowFlags::Sizeable), source(source), names(names),
+      onMore(std::move(onMore)), selectedRow(GView::Utils::INVALID_OFFSET), hitsCount(0)
+{
+    status = Factory::Label::Create(this, "", "x:0,y:0,w:100%,h:1");
+    list   = Factory::ListView::Create(this, "l:0,t:1,r:0,b:2", { "n:Row,a:r,w:12", "n:Column,w:20", "n:Value,w:200" }, ListViewFlags::None);
+    list->Handlers()->OnItemPressed = this;
+    Factory::Button::Create(this, "&Go to", "x:20%,y:100%,a:b,w:12", BTN_ID_GOTO);
+    more = Factory::Button::Create(this, "&More", "x:50%,y:100%,a:b,w:12", BTN_ID_MORE);
+    Factory::Button::Create(this, "&Cancel", "x:80%,y:100%,a:b,w:12", BTN_ID_CANCEL);
+    list->SetFocus();
+}
+
+void HitsDialog::AddHits(const std::vector<SearchHit>& hits)
+{
+    LocalString<128> tmp;
+    String value;
+    for (const auto& hit : hits) {
+        auto item = list->AddItem(tmp.Format("%llu", hit.row));
+        item.SetText(1, hit.column < names.size() ? std::string_view{ names[hit.column] } : std::string_view{ tmp.Format("Column %u", hit.column + 1) });
+        if (source.GetCell(hit.row, hit.column, value)) {
+            item.SetText(2, value);
+        }
+        item.SetData(hit.row);
+    }
+    hitsCount += hits.size();
+}
+
+void HitsDialog::UpdateStatus(bool finished)
+{
+    LocalString<128> tmp;
+    status->SetText(finished ? tmp.Format("%zu matches", hitsCount) : tmp.Format("First %zu matches (press More to search further)", hitsCount));
+    more->SetEnabled(!finished);
+}
+
+bool HitsDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if (eventType == Event::ButtonClicked) {
+        switch (ID) {
+        case BTN_ID_GOTO:
+            selectedRow = list->GetCurrentItem().GetData(GView::Utils::INVALID_OFFSET);
+            Exit(Dialogs::Result::Ok);
+            return true;
+        case BTN_ID_MORE:
+            UpdateStatus(!onMore(*this));
+            list->SetFocus();
+            return true;
+        case BTN_ID_CANCEL:
+            Exit(Dialogs::Result::Cancel);
+            return true;
+        }
+    }
+    if (eventType == Event::WindowClose) {
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+    return Window::OnEvent(control, eventType, ID);
+}
+
+void HitsDialog::OnListViewItemPressed(Reference<Controls::ListView> lv, Controls::ListViewItem item)
+{
+    selectedRow = item.GetData(GView::Utils::INVALID_OFFSET);
+    Exit(Dialogs::Result::Ok);
+}
+} // namespace GView::View::GridViewer
@@ -10,10 +10,14 @@ constexpr uint32 PROP_ID_REPLACE_HEADER_WITH_1ST_ROW = 0;
 constexpr uint32 PROP_ID_TOGGLE_HORIZONTAL_LINES     = 1;
 constexpr uint32 PROP_ID_TOGGLE_VERTICAL_LINES       = 2;
 
+constexpr uint64 SPARSE_INDEX_MIN_SIZE = 1024ULL * 1024 * 1024;
+constexpr uint32 PAGE_ROWS             = 4096; // rows loaded in the grid at once
+constexpr size_t SEARCH_HITS_PAGE      = 1000; // hits added to the list before the search waits for "More"
+
 Config Instance::config;
 
 Instance::Instance(Reference<GView::Object> obj, Settings* _settings)
-    : settings(nullptr), ViewControl("Grid View")
+    : settings(nullptr), firstRow(0), populated(false), profilesWithHeader(false), ViewControl("Grid View")
 {
     this->obj = obj;
     // settings
@@ -144,6 +148,24 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
             settings->firstRowAsHeader = !settings->firstRowAsHeader;
             PopulateGrid();
             return true;
+        } else if (ID == COMMAND_ID_NEXT_PAGE) {
+            if (settings->dataSource->HasRow(firstRow + PAGE_ROWS + settings->firstRowAsHeader)) {
+                firstRow += PAGE_ROWS;
+                PopulateGrid();
+            }
+            return true;
+        } else if (ID == COMMAND_ID_PREVIOUS_PAGE) {
+            if (firstRow > 0) {
+                firstRow -= std::min<uint64>(firstRow, PAGE_ROWS);
+                PopulateGrid();
+            }
+            return true;
+        } else if (ID == COMMAND_ID_PROFILE_COLUMNS) {
+            ShowColumnProfiles();
+            return true;
+        } else if (ID == COMMAND_ID_FIND_ALL) {
+            FindAllCells();
+            return true;
         } else if (ID == COMMAND_ID_TOGGLE_HORIZONTAL_LINES) {
             grid->ToggleHorizontalLines();
             return true;
@@ -211,129 +233,224 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
 
 void Instance::OnStart()
 {
+    // a data source supplied by a plugin (a database table) is only read once its grid is shown
+    if (settings->dataSource) {
+        return;
+    }
     ProcessContent();
-    grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows) });
     PopulateGrid();
 }
 
-void Instance::PopulateGrid()
+void Instance::OnFocus()
 {
-    const auto& content = settings->tokens;
-    auto it             = content.begin();
+    if (!populated) {
+        PopulateGrid();
+    }
+}
 
-    if (settings->firstRowAsHeader) {
-        const auto& header = it->second;
+void Instance::PopulateGrid()
+{
+    auto& source = *settings->dataSource;
+    String value;
+    populated = true;
+
+    // the first row of the source is the header -> the rows of the grid start one row later
+    const uint64 headerRows = settings->firstRowAsHeader ? 1 : 0;
+    const auto columns      = source.GetColumnsCount();
+
+    std::vector<std::string> header;
+    if (settings->firstRowAsHeader && source.HasRow(0)) {
+        for (auto j = 0U; j < columns; j++) {
+            header.emplace_back(source.GetCell(0, j, value) ? (std::string_view) value : std::string_view{});
+        }
+    } else if (columns > 0 && source.GetColumnName(0, value)) {
+        for (auto j = 0U; j < columns; j++) {
+            header.emplace_back(source.GetColumnName(j, value) ? (std::string_view) value : std::string_view{});
+        }
+    }
+    if (header.empty()) {
+        grid->SetDefaultHeaderValues();
+    } else {
         std::vector<AppCUI::Utils::ConstString> headerCS;
-        for (const auto& [start, end] : header) {
-            const auto token = obj->GetData().Get(start, static_cast<uint32>(end - start), false);
-            headerCS.push_back(token);
+        for (const auto& name : header) {
+            headerCS.emplace_back(std::string_view{ name });
         }
-        std::advance(it, 1);
         grid->UpdateHeaderValues(headerCS);
-    } else {
-        grid->SetDefaultHeaderValues();
     }
 
+    // only the rows of the current page are asked from the source
+    uint32 rows = 0;
+    while (rows < PAGE_ROWS && source.HasRow(firstRow + headerRows + rows)) {
+        rows++;
+    }
+    settings->rows = rows;
+    settings->cols = columns;
+
     const auto dimensions = grid->GetGridDimensions();
-    if (static_cast<uint32>(settings->rows - settings->firstRowAsHeader) != dimensions.Height) {
-        grid->SetGridDimensions({ static_cast<uint32>(settings->cols), static_cast<uint32>(settings->rows - settings->firstRowAsHeader) });
+    if (rows != dimensions.Height || columns != dimensions.Width) {
+        grid->SetGridDimensions({ columns, rows });
     }
 
-    while (it != content.end()) {
-        const auto i    = it->first;
-        const auto& row = it->second;
-        for (auto itRow = row.begin(); itRow != row.end(); itRow++) {
-            const auto j     = row.size() - std::abs(std::distance(row.end(), itRow));
-            const auto token = obj->GetData().Get(itRow->first, static_cast<uint32>(itRow->second - itRow->first), false);
-            const ConstString value{ token };
-            grid->UpdateCell(static_cast<uint32>(j), static_cast<uint32>(i - settings->firstRowAsHeader), value);
+    for (auto i = 0U; i < rows; i++) {
+        for (auto j = 0U; j < columns; j++) {
+            // a cell that can not be read must not keep the value of the previous page
+            if (!source.GetCell(firstRow + headerRows + i, j, value)) {
+                value.Clear();
+            }
+            grid->UpdateCell(j, i, value);
         }
-        std::advance(it, 1);
     }
 
     grid->Sort();
 }
 
-void GView::View::GridViewer::Instance::ProcessContent()
+void Instance::GetColumnNames(std::vector<std::string>& names)
 {
-    // TODO: this function should be a state machine with using cache as a stream-like structure!
-    // the implementation below is wrong if a "row" contains more bytes than the cache size!
-
-    std::map<uint64, std::pair<uint64, uint64>> lines;
-    std::map<uint64, std::vector<std::pair<uint64, uint64>>> tokens;
-
-    const auto oSize = obj->GetData().GetSize();
-    const auto cSize = static_cast<uint64>(obj->GetData().GetCacheSize());
-
-    auto oSizeProcessed = 0ULL;
-    auto lineStart      = 0ULL;
-    auto currentLine    = 0ULL;
-
-    do {
-        const auto dataSize = oSizeProcessed >= oSize ? 0 : std::min<uint64>(oSize - oSizeProcessed, cSize);
-        const auto buf      = obj->GetData().Get(oSizeProcessed, static_cast<uint32>(dataSize), false);
-        const std::string_view data{ reinterpret_cast<const char*>(buf.GetData()), buf.GetLength() };
-
-        auto nPos       = data.find_first_of('\n', 0);
-        const auto rPos = data.find_first_of('\r', 0);
+    auto& source = *settings->dataSource;
+    String value;
+
+    names.clear();
+    for (auto j = 0U; j < source.GetColumnsCount(); j++) {
+        const bool found = settings->firstRowAsHeader ? source.GetCell(0, j, value) : source.GetColumnName(j, value);
+        if (!found) {
+            names.clear();
+            return;
+        }
+        names.emplace_back((std::string_view) value);
+    }
+}
 
-        const auto oldOSizeProcessed = oSizeProcessed;
+void Instance::ShowColumnProfiles()
+{
+    if (settings->index.GetRowsCount() == 0) {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Column profiles are only available for separated values files!");
+        return;
+    }
 
-        if (nPos < rPos) {
-            if (nPos + 1 < data.size() && data[nPos + 1] == '\r') {
-                oSizeProcessed += nPos + 2;
-            } else {
-                oSizeProcessed += nPos + 1;
-            }
-        } else if (nPos > rPos) {
-            if (rPos + 1 < data.size() && data[rPos + 1] == '\n') {
-                oSizeProcessed += rPos + 2;
-            } else {
-                oSizeProcessed += rPos + 1;
+    // computed once for every header mode
+    if (profiles.empty() || profilesWithHeader != settings->firstRowAsHeader) {
+        LocalString<128> ls;
+        bool canceled         = false;
+        const auto onProgress = [&](uint64 scanned, uint64 total) {
+            canceled = AppCUI::Graphics::ProgressStatus::Update(scanned, ls.Format("Profiled %llu / %llu bytes...", scanned, total));
+            return !canceled;
+        };
+        AppCUI::Graphics::ProgressStatus::Init("Profiling columns...", obj->GetData().GetSize());
+        if (!ColumnEngine::Profile(obj->GetData(), settings->index, settings->firstRowAsHeader ? 1 : 0, profiles, onProgress)) {
+            profiles.clear();
+            if (!canceled) {
+                AppCUI::Dialogs::MessageBox::ShowError("Error", "Failed to profile the columns!");
             }
-        } else if (nPos == rPos && nPos == std::string::npos) {
-            nPos = data.size();
-            oSizeProcessed += nPos + 1;
+            return;
         }
+        profilesWithHeader = settings->firstRowAsHeader;
+    }
 
-        lines.insert({ currentLine, { lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed } });
-        const std::string_view line{ reinterpret_cast<const char*>(buf.GetData() + lineStart), nPos };
+    std::vector<std::string> names;
+    GetColumnNames(names);
+    ProfileDialog dialog(profiles, names);
+    dialog.Show();
+}
 
-        std::vector<uint64> separators;
-        {
-            size_t pos = line.find(settings->separator[0]);
-            while (pos != std::string::npos) {
-                separators.push_back(pos + oldOSizeProcessed);
-                pos = line.find(settings->separator[0], pos + 1);
-            }
+void Instance::FindAllCells()
+{
+    if (settings->index.GetRowsCount() == 0) {
+        AppCUI::Dialogs::MessageBox::ShowError("Error", "Searching all the cells is only available for separated values files!");
+        return;
+    }
+    CHECKRET(findDialog.Show() == Dialogs::Result::Ok, "");
+
+    // the file is searched as UTF-8
+    std::string text;
+    const auto input = findDialog.GetFilterValue();
+    for (size_t i = 0; i < input.size(); i++) {
+        uint32 code = input[i];
+        if (code >= 0xD800 && code < 0xDC00 && i + 1 < input.size() && input[i + 1] >= 0xDC00 && input[i + 1] < 0xE000) {
+            code = 0x10000 + ((code - 0xD800) << 10) + (input[++i] - 0xDC00);
         }
-
-        std::vector<std::pair<uint64, uint64>> lTokens;
-        if (separators.empty()) {
-            lTokens.push_back({ lineStart + oldOSizeProcessed, nPos + oldOSizeProcessed });
+        if (code < 0x80) {
+            text.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            text.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            text.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            text.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            text.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            text.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            text.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            text.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            text.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            text.push_back(static_cast<char>(0x80 | (code & 0x3F)));
         }
-
-        {
-            auto tStart = oldOSizeProcessed;
-            auto tEnd   = oldOSizeProcessed;
-            for (const auto& i : separators) {
-                tEnd = i;
-                lTokens.push_back({ tStart, tEnd });
-                tStart = tEnd + 1;
+    }
+    CHECKRET(!text.empty(), "");
+
+    const uint64 headerRows = settings->firstRowAsHeader ? 1 : 0;
+    const auto isRegex      = findDialog.IsRegex();
+    const auto ignoreCase   = findDialog.IgnoreCase();
+    uint64 position         = 0;
+    bool failed             = false;
+
+    // hits are added to the list batch after batch, until a page is full; returns true if there is more to search
+    const auto searchMore = [&](HitsDialog& dialog) {
+        const auto stopAt = dialog.GetHitsCount() + SEARCH_HITS_PAGE;
+        const auto onHits = [&](const std::vector<SearchHit>& hits) {
+            dialog.AddHits(hits);
+            return dialog.GetHitsCount() < stopAt;
+        };
+        LocalString<128> ls;
+        bool canceled         = false;
+        const auto onProgress = [&](uint64 scanned, uint64 total) {
+            canceled = AppCUI::Graphics::ProgressStatus::Update(
+                  scanned, ls.Format("Searched %llu / %llu bytes, %zu matches...", scanned, total, dialog.GetHitsCount()));
+            return !canceled;
+        };
+        AppCUI::Graphics::ProgressStatus::Init("Searching...", obj->GetData().GetSize());
+        if (!ColumnEngine::Search(obj->GetData(), settings->index, headerRows, text, isRegex, ignoreCase, position, onHits, onProgress)) {
+            // a canceled search can be continued later
+            if (!canceled) {
+                failed = true;
+                AppCUI::Dialogs::MessageBox::ShowError("Error", "Search failed (invalid regular expression?)");
             }
-            lTokens.push_back({ tEnd + 1, oSizeProcessed });
+            return canceled;
         }
+        return position < obj->GetData().GetSize();
+    };
+
+    std::vector<std::string> names;
+    GetColumnNames(names);
+    HitsDialog dialog(*settings->dataSource, names, searchMore);
+    const auto more = searchMore(dialog);
+    if (failed) {
+        return;
+    }
+    if (dialog.GetHitsCount() == 0) {
+        if (!more) {
+            AppCUI::Dialogs::MessageBox::ShowNotification("Find all", "No matches found!");
+        }
+        return;
+    }
+    dialog.UpdateStatus(!more);
+    if (dialog.Show() == Dialogs::Result::Ok && dialog.GetSelectedRow() != GView::Utils::INVALID_OFFSET) {
+        // load the page that holds the row
+        firstRow = (dialog.GetSelectedRow() - headerRows) / PAGE_ROWS * PAGE_ROWS;
+        PopulateGrid();
+    }
+}
 
-        tokens.insert({ currentLine, std::move(lTokens) });
-
-        currentLine++;
-
-    } while (oSizeProcessed < oSize);
+void GView::View::GridViewer::Instance::ProcessContent()
+{
+    if (settings->dataSource) {
+        return;
+    }
 
-    settings->rows   = lines.size();
-    settings->cols   = tokens.size() > 0 ? tokens.begin()->second.size() : 0;
-    settings->lines  = std::move(lines);
-    settings->tokens = std::move(tokens);
+    // huge files only keep checkpoints, the rows in between are tokenized again when they are needed
+    const auto checkpointInterval = obj->GetData().GetSize() > SPARSE_INDEX_MIN_SIZE ? CSVIndex::DEFAULT_CHECKPOINT_INTERVAL : 0;
+    if (!settings->index.Build(obj->GetData(), settings->separator[0], checkpointInterval)) {
+        settings->index.Clear();
+    }
+    settings->dataSource = std::make_unique<CSVDataSource>(obj, settings->index);
 }
 
 void GView::View::GridViewer::Instance::PaintCursorInformationWidth(AppCUI::Graphics::Renderer& renderer, unsigned int x, unsigned int y)
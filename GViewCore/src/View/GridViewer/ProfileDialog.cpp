@@ -0,0 +1,57 @@
+#include "GridViewer.hpp"
+
+namespace GView::View::GridViewer
+{
+constexpr int32 BTN_ID_CLOSE = 1;
+
+static std::string_view GetTypeName(ColumnProfile::Type type)
+{
+    switch (type) {
+    case ColumnProfile::Type::Integer:
+        return "Integer";
+    case ColumnProfile::Type::Float:
+        return "Float";
+    case ColumnProfile::Type::Text:
+        return "Text";
+    default:
+        return "Empty";
+    }
+}
+
+ProfileDialog::ProfileDialog(const std::vector<ColumnProfile>& profiles, const std::vector<std::string>& names)
+    : Window("Column profiles", "d:c,w:90%,h:80%", WindowFlags::Sizeable)
+{
+    auto list = Factory::ListView::Create(
+          this,
+          "l:0,t:0,r:0,b:2",
+          { "n:Column,w:20", "n:Type,w:9", "n:Values,a:r,w:12", "n:Empty,a:r,w:12", "n:Distinct (~),a:r,w:14", "n:Min,a:r,w:16", "n:Max,a:r,w:16",
+            "n:Min len,a:r,w:9", "n:Max len,a:r,w:9" },
+          ListViewFlags::None);
+    Factory::Button::Create(this, "&Close", "x:50%,y:100%,a:b,w:12", BTN_ID_CLOSE);
+
+    LocalString<64> tmp;
+    for (auto i = 0U; i < profiles.size(); i++) {
+        const auto& profile = profiles[i];
+        auto item           = list->AddItem(i < names.size() ? std::string_view{ names[i] } : std::string_view{ tmp.Format("Column %u", i + 1) });
+        item.SetText(1, GetTypeName(profile.type));
+        item.SetText(2, tmp.Format("%llu", profile.values));
+        item.SetText(3, tmp.Format("%llu", profile.empty));
+        item.SetText(4, tmp.Format("%llu", profile.distinct));
+        if (profile.numeric > 0) {
+            item.SetText(5, tmp.Format("%g", profile.minimum));
+            item.SetText(6, tmp.Format("%g", profile.maximum));
+        }
+        item.SetText(7, tmp.Format("%u", profile.minimumLength));
+        item.SetText(8, tmp.Format("%u", profile.maximumLength));
+    }
+}
+
+bool ProfileDialog::OnEvent(Reference<Control> control, Event eventType, int ID)
+{
+    if ((eventType == Event::ButtonClicked && ID == BTN_ID_CLOSE) || eventType == Event::WindowClose) {
+        Exit(Dialogs::Result::Cancel);
+        return true;
+    }
+    return Window::OnEvent(control, eventType, ID);
+}
+} // namespace GView::View::GridViewer
@@ -2,7 +2,7 @@
 
 using namespace GView::View::GridViewer;
 
-SettingsData::SettingsData() : tokens({}), lines({})
+SettingsData::SettingsData()
 {
 }
 
@@ -20,4 +20,9 @@ void Settings::SetSeparator(char separator[2])
 bool Settings::SetName(std::string_view name)
 {
     return ((SettingsData*) (this->data))->name.Set(name);
-}
\ No newline at end of file
+}
+
+void Settings::SetDataSource(DataSourceInterface* dataSource)
+{
+    ((SettingsData*) (this->data))->dataSource.reset(dataSource);
+}
@@ -512,6 +512,26 @@ namespace App
         };
     }
 
+    // read only window [start, start + size) over another data object
+    // (objects stored uncompressed inside a container are read from the parent file instead of being copied)
+    class SubRangeDataObject : public AppCUI::OS::DataObject
+    {
+        std::unique_ptr<AppCUI::OS::DataObject> base;
+        uint64 start, size, position;
+
+      public:
+        SubRangeDataObject(std::unique_ptr<AppCUI::OS::DataObject> base, uint64 start, uint64 size);
+        ~SubRangeDataObject() override;
+
+        bool ReadBuffer(void* buffer, uint32 bufferSize, uint32& bytesRead) override;
+        bool WriteBuffer(const void* buffer, uint32 bufferSize, uint32& bytesWritten) override;
+        uint64 GetSize() override;
+        uint64 GetCurrentPos() const override;
+        bool SetSize(uint64 newSize) override;
+        bool SetCurrentPos(uint64 newPosition) override;
+        void Close() override;
+    };
+
     class Instance : public AppCUI::Utils::PropertiesInterface,
                      public AppCUI::Controls::Handlers::OnEventInterface,
                      public AppCUI::Controls::Handlers::OnStartInterface
@@ -604,6 +624,16 @@ namespace App
               string_view typeName,
               Reference<Window> parent,
               const ConstString& creationProcess = "");
+        bool AddSubRangeWindow(
+              Reference<Object> parentObject,
+              uint64 offset,
+              uint64 size,
+              const ConstString& name,
+              const ConstString& path,
+              OpenMethod method,
+              string_view typeName,
+              Reference<Window> parent,
+              const ConstString& creationProcess = "");
         void UpdateCommandBar(AppCUI::Application::CommandBar& commandBar);
 
         // inline getters
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "GView.hpp"
+
+namespace GView::GenericPlugins::Strings
+{
+using namespace AppCUI::Graphics;
+using namespace GView::View;
+
+class Plugin : public Window, public Handlers::OnButtonPressedInterface
+{
+  private:
+    Reference<GView::Object> object;
+    Reference<Window> parent;
+
+    Reference<ListView> list;
+    Reference<Label> summary;
+    Reference<NumericSelector> minLength;
+    Reference<ComboBox> charset;
+
+    GView::Strings::Table table;
+
+  public:
+    Plugin(Reference<GView::Object> object, Reference<Window> parent);
+
+    void SetCharset(GView::Strings::Settings& settings);
+    void Update();
+    void GoToCurrentString();
+    void Export();
+
+    void OnButtonPressed(Reference<Button> button) override;
+    bool OnEvent(Reference<Control> control, Event eventType, int32 id) override;
+};
+} // namespace GView::GenericPlugins::Strings
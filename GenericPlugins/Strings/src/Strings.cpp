@@ -0,0 +1,214 @@
+#include "Strings.hpp"
+
+using namespace AppCUI;
+using namespace AppCUI::Utils;
+using namespace AppCUI::Application;
+using namespace AppCUI::Controls;
+using namespace GView::Utils;
+using namespace GView;
+
+constexpr int BTN_ID_GOTO   = 1;
+constexpr int BTN_ID_EXPORT = 2;
+constexpr int BTN_ID_CANCEL = 3;
+constexpr int BTN_ID_SCAN   = 4;
+
+constexpr uint64 CHARSET_PRINTABLE    = 0;
+constexpr uint64 CHARSET_ALPHANUMERIC = 1;
+constexpr uint64 CHARSET_LATIN1       = 2;
+
+constexpr uint32 MIN_LENGTH_LIMIT = 256;
+
+constexpr uint64 ITEM_INVALID = 0xFFFFFFFFFFFFFFFF;
+
+// texts longer than this are cut in the list (the exported file keeps them whole)
+constexpr uint32 MAX_DISPLAYED_TEXT = 256;
+
+namespace GView::GenericPlugins::Strings
+{
+using namespace AppCUI::Graphics;
+using namespace GView::View;
+
+Plugin::Plugin(Reference<GView::Object> object, Reference<Window> parent) : Window("Strings", "d:c,w:90%,h:90%", WindowFlags::FixedPosition)
+{
+    this->object = object;
+    this->parent = parent;
+
+    GView::Strings::Settings defaults;
+    Factory::Label::Create(this, "&Min length", "x:1,y:0,w:11,h:1");
+    minLength = Factory::NumericSelector::Create(this, 1, MIN_LENGTH_LIMIT, defaults.minLength, "x:13,y:0,w:14,h:1");
+    minLength->SetHotKey('M');
+    Factory::Label::Create(this, "C&harset", "x:30,y:0,w:8,h:1");
+    charset = Factory::ComboBox::Create(this, "x:39,y:0,w:30,h:1", "");
+    charset->SetHotKey('H');
+    charset->AddItem("Printable ASCII", CHARSET_PRINTABLE);
+    charset->AddItem("Letters, digits and space", CHARSET_ALPHANUMERIC);
+    charset->AddItem("Printable ASCII and Latin-1", CHARSET_LATIN1);
+    charset->SetCurentItemIndex(0);
+    Factory::Button::Create(this, "&Scan", "x:72,y:0,w:10", BTN_ID_SCAN)->Handlers()->OnButtonPressed = this;
+
+    summary = Factory::Label::Create(this, "", "x:1,y:2,w:99%,h:1");
+    list    = Factory::ListView::Create(
+          this, "x:1,y:3,w:99%,h:80%", { "n:Offset,w:18", "n:Encoding,w:10", "n:Length,a:r,w:8", "n:Text,w:200" }, ListViewFlags::None);
+
+    Factory::Button::Create(this, "&Go to", "x:20%,y:100%,a:b,w:12", BTN_ID_GOTO)->Handlers()->OnButtonPressed     = this;
+    Factory::Button::Create(this, "&Export", "x:50%,y:100%,a:b,w:12", BTN_ID_EXPORT)->Handlers()->OnButtonPressed = this;
+    Factory::Button::Create(this, "&Cancel", "x:80%,y:100%,a:b,w:12", BTN_ID_CANCEL)->Handlers()->OnButtonPressed = this;
+
+    Update();
+    list->SetFocus();
+}
+
+void Plugin::SetCharset(GView::Strings::Settings& settings)
+{
+    switch (charset->GetCurrentItemUserData(CHARSET_PRINTABLE)) {
+    case CHARSET_ALPHANUMERIC:
+        for (uint32 i = 0; i < 256; i++)
+            settings.charset[i] = (i >= '0' && i <= '9') || (i >= 'A' && i <= 'Z') || (i >= 'a' && i <= 'z') || (i == ' ');
+        break;
+    case CHARSET_LATIN1:
+        for (uint32 i = 0xA0; i < 256; i++)
+            settings.charset[i] = true;
+        break;
+    default:
+        break; // the default charset of the settings
+    }
+}
+
+void Plugin::Update()
+{
+    list->DeleteAllItems();
+
+    auto& cache = object->GetData();
+    GView::Strings::Settings settings;
+    settings.minLength = static_cast<uint32>(minLength->GetValue());
+    SetCharset(settings);
+    if (table.Build(cache, settings) == false) {
+        AppCUI::Dialogs::MessageBox::ShowError("Error!", "Fail to extract strings!");
+        return;
+    }
+
+    LocalString<64> tmp;
+    LocalString<32> tmp2;
+    std::string text;
+    const auto count = table.GetCount();
+
+    // the list sorts its columns as text -> offsets are padded to the same number of digits and lengths to the column width
+    int offsetDigits = 1;
+    for (auto size = cache.GetSize(); size > 0xF; size >>= 4)
+        offsetDigits++;
+    uint64 added   = 0;
+    uint64 skipped = 0;
+    for (uint64 i = 0; i < count; i++) {
+        GView::Strings::Entry e{};
+        // a string that can not be read again is left out (and counted) instead of ending the list
+        if (!table.GetEntry(i, e) || !table.GetText(cache, e, text)) {
+            skipped++;
+            continue;
+        }
+        if (text.size() > MAX_DISPLAYED_TEXT)
+            text.resize(MAX_DISPLAYED_TEXT);
+
+        auto item = list->AddItem({ tmp.Format("0x%0*llX", offsetDigits, e.offset),
+                                    GView::Strings::Table::GetEncodingName(e.encoding),
+                                    tmp2.Format("%8u", e.GetLength()),
+                                    text });
+        item.SetData(i);
+        added++;
+    }
+
+    if (skipped > 0)
+        summary->SetText(tmp.Format("Strings: %llu (%llu unreadable)", added, skipped));
+    else
+        summary->SetText(tmp.Format("Strings: %llu", added));
+}
+
+void Plugin::GoToCurrentString()
+{
+    const auto index = list->GetCurrentItem().GetData(ITEM_INVALID);
+    CHECKRET(index != ITEM_INVALID, "");
+    GView::Strings::Entry e{};
+    CHECKRET(table.GetEntry(index, e), "");
+
+    auto interface = parent.ToObjectRef<GView::View::WindowInterface>();
+    interface->GetCurrentView()->GoTo(e.offset);
+    this->Exit(Dialogs::Result::Ok);
+}
+
+void Plugin::Export()
+{
+    auto res = AppCUI::Dialogs::FileDialog::ShowSaveFileWindow("strings.txt", "Text Files:txt|All files:*", "");
+    if (res.has_value()) {
+        if (table.WriteTo(object->GetData(), res->u16string()) == false) {
+            AppCUI::Dialogs::MessageBox::ShowError("Error", "Fail to export strings!");
+        }
+    }
+}
+
+void Plugin::OnButtonPressed(Reference<Button> button)
+{
+    switch (button->GetControlID()) {
+    case BTN_ID_GOTO:
+        GoToCurrentString();
+        break;
+    case BTN_ID_EXPORT:
+        Export();
+        break;
+    case BTN_ID_SCAN:
+        Update();
+        list->SetFocus();
+        break;
+    case BTN_ID_CANCEL:
+        this->Exit(Dialogs::Result::Cancel);
+        break;
+    default:
+        break;
+    }
+}
+
+bool Plugin::OnEvent(Reference<Control> control, Event eventType, int32 id)
+{
+    if (Window::OnEvent(control, eventType, id)) {
+        return true;
+    }
+    if (eventType == Event::ListViewItemPressed) {
+        GoToCurrentString();
+        return true;
+    }
+    return false;
+}
+
+extern "C" {
+PLUGIN_EXPORT bool Run(const string_view command, Reference<GView::Object> object)
+{
+    if (command == "Strings") {
+        Reference<Window> parent;
+
+        auto desktop         = AppCUI::Application::GetDesktop();
+        const auto windowsNo = desktop->GetChildrenCount();
+        for (uint32 i = 0; i < windowsNo; i++) {
+            auto window = desktop->GetChild(i);
+            if (window->HasFocus()) {
+                parent = window.ToObjectRef<Window>();
+                break;
+            }
+        }
+
+        if (!parent.IsValid()) {
+            AppCUI::Dialogs::MessageBox::ShowError("Error!", "Parent window for Strings not found!");
+            return false;
+        }
+
+        GView::GenericPlugins::Strings::Plugin plugin(object, parent);
+        plugin.Show();
+
+        return true;
+    }
+    return false;
+}
+
+PLUGIN_EXPORT void UpdateSettings(IniSection sect)
+{
+    sect["Command.Strings"] = Input::Key::Ctrl | Input::Key::Alt | Input::Key::Shift | Input::Key::F3;
+}
+}
+} // namespace GView::GenericPlugins::Strings
@@ -5,6 +5,29 @@
 
 namespace GView::Type::ISO
 {
+constexpr uint32 INVALID_ENTRY = 0xFFFFFFFF;
+
+// a file or a directory of the image; the children of a directory are stored contiguously in ISOFile::entries
+struct PathEntry
+{
+    uint64 offset; // of the extent, in bytes
+    uint32 size;
+    uint32 parent; // INVALID_ENTRY for the children of the root directory
+    uint32 firstChild;
+    uint32 childrenCount;
+    uint32 nameOffset; // in ISOFile::names
+    uint16 nameLength;
+    uint8 fileFlags;
+    unsigned char recordingDateAndTime[7];
+};
+
+enum class NamesSource : uint8
+{
+    ISO9660   = 0,
+    Joliet    = 1, // UCS-2 names from the supplementary volume descriptor
+    RockRidge = 2, // NM entries from the system use area of the primary volume records
+};
+
 class ISOFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
   public:
@@ -15,15 +38,23 @@ class ISOFile : public TypeInterface, public View::ContainerViewer::EnumerateInt
     };
 
     std::vector<MyVolumeDescriptorHeader> headers;
-    std::vector<ECMA_119_DirectoryRecord> records;
+    std::vector<ECMA_119_DirectoryRecord> records; // records[i] is the directory record of entries[i]
 
     ECMA_119_PrimaryVolumeDescriptor pvd{};
     ECMA_119_DirectoryRecord root{};
-    std::vector<ECMA_119_DirectoryRecord> objects;
 
-    std::map<uint64, ECMA_119_DirectoryRecord> itemsCache;
+    // path index built in one pass over the directory extents (the children of the root are [0, rootChildrenCount))
+    std::vector<PathEntry> entries;
+    std::u16string names;
+    uint32 rootChildrenCount;
+    NamesSource namesSource;
 
     uint32 currentItemIndex;
+    uint32 currentItemEnd;
+
+  private:
+    bool BuildIndex(const ECMA_119_DirectoryRecord& rootRecord, uint32 blockSize, NamesSource source);
+    bool HasSUSP(const ECMA_119_DirectoryRecord& rootRecord, uint32 blockSize);
 
   public:
     ISOFile();
@@ -49,6 +80,17 @@ class ISOFile : public TypeInterface, public View::ContainerViewer::EnumerateInt
     virtual bool PopulateItem(TreeViewItem item) override;
     virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
 
+    std::u16string_view GetName(uint32 index) const
+    {
+        const auto& entry = entries[index];
+        return std::u16string_view{ names.data() + entry.nameOffset, entry.nameLength };
+    }
+    std::u16string GetPath(uint32 index) const;
+    // index of the entry with the given path ('/' separated, relative to the root) or INVALID_ENTRY
+    uint32 FindPath(std::u16string_view path) const;
+    // indexes of the entries whose name contains text (ASCII letters are compared case insensitive)
+    void FindByName(std::u16string_view text, std::vector<uint32>& results) const;
+
   public:
     Reference<GView::Utils::SelectionZoneInterface> selectionZoneInterface;
 
@@ -1,10 +1,176 @@
 #include "iso.hpp"
 
 #include <queue>
-#include <map>
+#include <unordered_set>
 
 using namespace GView::Type::ISO;
 
+namespace
+{
+constexpr uint32 DIRECTORY_RECORD_HEADER_SIZE = 33; // the fields before the file identifier
+constexpr uint32 MAX_CONTINUATION_AREAS       = 16;
+
+// Rock Ridge NM flags
+constexpr uint8 NM_CURRENT = 0x02;
+constexpr uint8 NM_PARENT  = 0x04;
+
+// Joliet escape sequences (UCS-2 level 1, 2 and 3)
+constexpr std::string_view JOLIET_ESCAPES[] = { "%/@", "%/C", "%/E" };
+
+uint32 ReadUInt32(const uint8* data)
+{
+    uint32 value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void AppendUTF8(std::u16string& output, const uint8* data, uint32 size)
+{
+    uint32 i = 0;
+    while (i < size)
+    {
+        const uint8 lead    = data[i++];
+        uint32 codePoint    = lead;
+        uint32 continuation = 0;
+        if (lead >= 0xF0 && lead < 0xF8)
+        {
+            codePoint    = lead & 0x07;
+            continuation = 3;
+        }
+        else if (lead >= 0xE0 && lead < 0xF0)
+        {
+            codePoint    = lead & 0x0F;
+            continuation = 2;
+        }
+        else if (lead >= 0xC0 && lead < 0xE0)
+        {
+            codePoint    = lead & 0x1F;
+            continuation = 1;
+        }
+
+        if (continuation > 0)
+        {
+            uint32 j = 0;
+            while (j < continuation && i + j < size && (data[i + j] & 0xC0) == 0x80)
+            {
+                codePoint = (codePoint << 6) | (data[i + j] & 0x3F);
+                j++;
+            }
+            if (j == continuation)
+            {
+                i += continuation;
+            }
+            else
+            {
+                codePoint = lead; // not UTF-8 -> keep the byte as it is
+            }
+        }
+
+        if (codePoint >= 0x10000)
+        {
+            codePoint -= 0x10000;
+            output.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+            output.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+        }
+        else
+        {
+            output.push_back(static_cast<char16_t>(codePoint));
+        }
+    }
+}
+
+// concatenates the NM entries of a System Use area (and of its continuation areas)
+bool ReadRockRidgeName(GView::Utils::DataCache& cache, BufferView systemUse, uint32 blockSize, std::u16string& name)
+{
+    std::string utf8Name;
+    bool found = false;
+    Buffer continuationArea;
+    for (auto area = 0U; area <= MAX_CONTINUATION_AREAS; area++)
+    {
+        const auto data = systemUse.GetData();
+        const auto size = static_cast<uint32>(systemUse.GetLength());
+        uint64 continuationOffset = 0;
+        uint32 continuationLength = 0;
+
+        uint32 position = 0;
+        while (position + 4 <= size)
+        {
+            const uint8 length = data[position + 2];
+            if (length < 4 || position + length > size)
+            {
+                break;
+            }
+            if (data[position] == 'N' && data[position + 1] == 'M' && length >= 5)
+            {
+                if ((data[position + 4] & (NM_CURRENT | NM_PARENT)) == 0)
+                {
+                    utf8Name.append(reinterpret_cast<const char*>(data + position + 5), length - 5);
+                }
+                found = true;
+            }
+            else if (data[position] == 'C' && data[position + 1] == 'E' && length >= 28)
+            {
+                continuationOffset = (uint64) ReadUInt32(data + position + 4) * blockSize + ReadUInt32(data + position + 12);
+                continuationLength = ReadUInt32(data + position + 20);
+            }
+            else if (data[position] == 'S' && data[position + 1] == 'T')
+            {
+                break;
+            }
+            position += length;
+        }
+
+        if (continuationLength == 0)
+        {
+            break;
+        }
+        continuationArea = cache.CopyToBuffer(continuationOffset, continuationLength);
+        if (continuationArea.IsValid() == false)
+        {
+            break;
+        }
+        systemUse = continuationArea;
+    }
+
+    if (found)
+    {
+        AppendUTF8(name, reinterpret_cast<const uint8*>(utf8Name.data()), static_cast<uint32>(utf8Name.size()));
+    }
+    return found;
+}
+
+// ISO 9660 names are d-characters, Joliet names are UCS-2 big endian; the ";1" version suffix is dropped from both
+void DecodeIdentifier(const char* identifier, uint8 length, NamesSource source, std::u16string& name)
+{
+    if (source == NamesSource::Joliet)
+    {
+        for (auto i = 0U; i + 1 < length; i += 2)
+        {
+            name.push_back(static_cast<char16_t>((static_cast<uint8>(identifier[i]) << 8) | static_cast<uint8>(identifier[i + 1])));
+        }
+    }
+    else
+    {
+        for (auto i = 0U; i < length; i++)
+        {
+            name.push_back(static_cast<uint8>(identifier[i]));
+        }
+    }
+
+    const auto separator = name.find_last_of(u';');
+    if (separator != std::u16string::npos &&
+        std::all_of(name.begin() + separator + 1, name.end(), [](char16_t c) { return c >= u'0' && c <= u'9'; }))
+    {
+        name.resize(separator);
+        // "FILE.;1" -> "FILE"
+        if (source == NamesSource::ISO9660 && name.size() > 1 && name.back() == u'.')
+        {
+            name.pop_back();
+        }
+    }
+}
+} // namespace
+
 ISOFile::ISOFile()
 {
 }
@@ -52,88 +218,254 @@ bool ISOFile::Update()
          */
 
         const auto blockSize = pvd.vdd.logicalBlockSize.LSB;
+        CHECK(blockSize > 0, false, "");
         root                 = *reinterpret_cast<ECMA_119_DirectoryRecord*>(&pvd.vdd.directoryEntryForTheRootDirectory);
         auto fileEntryOffset = root.locationOfExtent.LSB * blockSize;
-        auto block           = 0;
         CHECK(fileEntryOffset == ptr.locationOfExtent * blockSize, false, "");
 
-        std::queue<ECMA_119_DirectoryRecord> drs;
-        drs.emplace(root);
-
-        do
+        // Rock Ridge names live in the primary tree, Joliet has a tree of its own
+        if (HasSUSP(root, blockSize))
         {
-            auto offset = drs.front().locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-            drs.pop();
+            return BuildIndex(root, blockSize, NamesSource::RockRidge);
+        }
 
-            auto i = 0ULL;
-            ECMA_119_DirectoryRecord dr{};
-            do
+        for (const auto& supplementary : headers)
+        {
+            if (supplementary.header.type != SectorType::Supplementary)
             {
-                CHECK(obj->GetData().Copy<ECMA_119_DirectoryRecord>(offset, dr), false, "");
+                continue;
+            }
 
-                if (i > 1) // skip '.' & '..'
+            ECMA_119_SupplementaryVolumeDescriptor svd{};
+            CHECK(obj->GetData().Copy<ECMA_119_SupplementaryVolumeDescriptor>(supplementary.offsetInFile, svd), false, "");
+            const std::string_view escapes{ svd.vdd.unusedField2, sizeof(svd.vdd.unusedField2) };
+            for (const auto& joliet : JOLIET_ESCAPES)
+            {
+                if (escapes.starts_with(joliet) && svd.vdd.logicalBlockSize.LSB > 0)
                 {
-                    if (dr.fileFlags & ECMA_119_FileFlags::Directory)
-                    {
-                        drs.emplace(dr);
-                    }
+                    const auto jolietRoot = *reinterpret_cast<ECMA_119_DirectoryRecord*>(&svd.vdd.directoryEntryForTheRootDirectory);
+                    return BuildIndex(jolietRoot, svd.vdd.logicalBlockSize.LSB, NamesSource::Joliet);
                 }
+            }
+        }
+
+        return BuildIndex(root, blockSize, NamesSource::ISO9660);
+    }
+
+    return true;
+}
 
-                if (dr.lengthOfDirectoryRecord != 0)
+bool ISOFile::HasSUSP(const ECMA_119_DirectoryRecord& rootRecord, uint32 blockSize)
+{
+    // the "SP" entry is the first one of the System Use area of the '.' record of the root directory
+    constexpr uint8 SP_SIGNATURE[] = { 'S', 'P', 7, 1, 0xBE, 0xEF };
+    const auto offset              = (uint64) rootRecord.locationOfExtent.LSB * blockSize + DIRECTORY_RECORD_HEADER_SIZE + 1;
+    const auto buffer              = obj->GetData().CopyToBuffer(offset, sizeof(SP_SIGNATURE));
+    CHECK(buffer.IsValid(), false, "");
+    return memcmp(buffer.GetData(), SP_SIGNATURE, sizeof(SP_SIGNATURE)) == 0;
+}
+
+bool ISOFile::BuildIndex(const ECMA_119_DirectoryRecord& rootRecord, uint32 blockSize, NamesSource source)
+{
+    struct PendingDirectory
+    {
+        uint32 index;
+        uint64 offset;
+        uint32 size;
+    };
+
+    auto& cache = obj->GetData();
+    entries.clear();
+    records.clear();
+    names.clear();
+    rootChildrenCount = 0;
+    namesSource       = source;
+
+    std::queue<PendingDirectory> pending;
+    std::unordered_set<uint64> visited; // malformed images can link a directory to one of its ancestors
+    pending.push({ INVALID_ENTRY, (uint64) rootRecord.locationOfExtent.LSB * blockSize, rootRecord.dataLength.LSB });
+
+    std::u16string name;
+    while (pending.empty() == false)
+    {
+        const auto directory = pending.front();
+        pending.pop();
+        if (directory.size == 0 || visited.insert(directory.offset).second == false)
+        {
+            continue;
+        }
+
+        // the whole extent in a single read
+        const auto extent = cache.CopyToBuffer(directory.offset, directory.size, false);
+        if (extent.IsValid() == false)
+        {
+            continue;
+        }
+
+        const auto data       = extent.GetData();
+        const auto size       = static_cast<uint32>(extent.GetLength());
+        const auto firstChild = static_cast<uint32>(entries.size());
+
+        uint32 position = 0;
+        while (position + DIRECTORY_RECORD_HEADER_SIZE <= size)
+        {
+            const uint8 length = data[position];
+            if (length == 0)
+            {
+                // records do not cross logical blocks, the rest of this one is padding
+                position = (position / blockSize + 1) * blockSize;
+                continue;
+            }
+            if (length < DIRECTORY_RECORD_HEADER_SIZE || position + length > size)
+            {
+                break;
+            }
+
+            ECMA_119_DirectoryRecord record{};
+            memcpy(&record, data + position, std::min<size_t>(length, sizeof(record)));
+            const auto identifierLength = record.lengthOfFileIdentifier;
+
+            const bool isSelfOrParent = identifierLength == 1 && (record.fileIdentifier[0] == 0 || record.fileIdentifier[0] == 1); // '.' & '..'
+            if (isSelfOrParent == false && DIRECTORY_RECORD_HEADER_SIZE + identifierLength <= length)
+            {
+                name.clear();
+                if (source == NamesSource::RockRidge)
                 {
-                    if (i > 1) // skip '.' & '..'
+                    // the System Use area follows the identifier, padded to an even offset
+                    const uint32 systemUseOffset = DIRECTORY_RECORD_HEADER_SIZE + identifierLength + (identifierLength % 2 == 0 ? 1 : 0);
+                    if (systemUseOffset < length)
                     {
-                        records.emplace_back(dr);
+                        ReadRockRidgeName(cache, BufferView{ data + position + systemUseOffset, length - systemUseOffset }, blockSize, name);
                     }
-                    offset += dr.lengthOfDirectoryRecord;
+                }
+                if (name.empty())
+                {
+                    DecodeIdentifier(record.fileIdentifier, identifierLength, source, name);
                 }
 
-                i++;
+                PathEntry entry{};
+                entry.offset        = (uint64) record.locationOfExtent.LSB * blockSize;
+                entry.size          = record.dataLength.LSB;
+                entry.parent        = directory.index;
+                entry.firstChild    = 0;
+                entry.childrenCount = 0;
+                entry.nameOffset    = static_cast<uint32>(names.size());
+                entry.nameLength    = static_cast<uint16>(std::min<size_t>(name.size(), 0xFFFF));
+                entry.fileFlags     = record.fileFlags;
+                memcpy(entry.recordingDateAndTime, record.recordingDateAndTime, sizeof(entry.recordingDateAndTime));
+
+                names.append(name, 0, entry.nameLength);
+                entries.push_back(entry);
+                records.push_back(record);
+            }
+
+            position += length;
+        }
 
-            } while (dr.lengthOfDirectoryRecord != 0);
-        } while (drs.empty() == false);
+        const auto childrenCount = static_cast<uint32>(entries.size()) - firstChild;
+        if (directory.index == INVALID_ENTRY)
+        {
+            rootChildrenCount = childrenCount;
+        }
+        else
+        {
+            entries[directory.index].firstChild    = firstChild;
+            entries[directory.index].childrenCount = childrenCount;
+        }
 
-        break;
+        for (auto i = firstChild; i < firstChild + childrenCount; i++)
+        {
+            if (entries[i].fileFlags & ECMA_119_FileFlags::Directory)
+            {
+                pending.push({ i, entries[i].offset, entries[i].size });
+            }
+        }
     }
 
     return true;
 }
 
-bool ISOFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
+std::u16string ISOFile::GetPath(uint32 index) const
 {
-    objects.clear();
-    currentItemIndex = 0;
-    ECMA_119_DirectoryRecord current{};
-
-    int64 currentOffset;
-    if (parent.GetParent().GetHandle() == InvalidItemHandle)
-    {
-        currentOffset = (int64) root.locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-    }
-    else
+    std::u16string path;
+    for (auto current = index; current < entries.size(); current = entries[current].parent)
     {
-        auto data     = parent.GetData<ECMA_119_DirectoryRecord>();
-        currentOffset = (uint64) data->locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-        CHECK(currentOffset != pvd.vdd.logicalBlockSize.LSB, false, "");
+        const auto name = GetName(current);
+        path.insert(path.begin(), name.begin(), name.end());
+        if (entries[current].parent != INVALID_ENTRY)
+        {
+            path.insert(path.begin(), u'/');
+        }
     }
+    return path;
+}
 
-    auto i = 0ULL;
-    do
+uint32 ISOFile::FindPath(std::u16string_view path) const
+{
+    auto first = 0U;
+    auto count = rootChildrenCount;
+    auto found = INVALID_ENTRY;
+
+    while (path.empty() == false)
     {
-        CHECK(obj->GetData().Copy<ECMA_119_DirectoryRecord>(currentOffset, current), false, "");
+        const auto separator = path.find(u'/');
+        const auto component = path.substr(0, separator);
+        path                 = separator == std::u16string_view::npos ? std::u16string_view{} : path.substr(separator + 1);
+        if (component.empty())
+        {
+            continue;
+        }
 
-        if (i > 1 && current.lengthOfDirectoryRecord != 0) // skip '.' & '..'
+        found = INVALID_ENTRY;
+        for (auto i = first; i < first + count; i++)
         {
-            objects.emplace_back(current);
+            if (GetName(i) == component)
+            {
+                found = i;
+                break;
+            }
         }
+        CHECK(found != INVALID_ENTRY, INVALID_ENTRY, "");
+        first = entries[found].firstChild;
+        count = entries[found].childrenCount;
+    }
 
-        currentOffset += current.lengthOfDirectoryRecord;
+    return found;
+}
 
-        i++;
+void ISOFile::FindByName(std::u16string_view text, std::vector<uint32>& results) const
+{
+    results.clear();
+    CHECKRET(text.empty() == false, "");
 
-    } while (current.lengthOfDirectoryRecord != 0);
+    const auto lower = [](char16_t c) { return (c >= u'A' && c <= u'Z') ? static_cast<char16_t>(c | 0x20) : c; };
+    for (auto i = 0U; i < entries.size(); i++)
+    {
+        const auto name = GetName(i);
+        const auto it   = std::search(name.begin(), name.end(), text.begin(), text.end(), [&](char16_t a, char16_t b) { return lower(a) == lower(b); });
+        if (it != name.end())
+        {
+            results.push_back(i);
+        }
+    }
+}
+
+bool ISOFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
+{
+    if (parent.GetParent().GetHandle() == InvalidItemHandle)
+    {
+        currentItemIndex = 0;
+        currentItemEnd   = rootChildrenCount;
+    }
+    else
+    {
+        const auto index = static_cast<uint32>(parent.GetData(INVALID_ENTRY));
+        CHECK(index < entries.size(), false, "");
+        currentItemIndex = entries[index].firstChild;
+        currentItemEnd   = currentItemIndex + entries[index].childrenCount;
+    }
 
-    return objects.size() > 0;
+    return currentItemIndex < currentItemEnd;
 }
 
 bool ISOFile::PopulateItem(TreeViewItem item)
@@ -142,8 +474,8 @@ bool ISOFile::PopulateItem(TreeViewItem item)
     const static auto dec = NumericFormat{ NumericFormatFlags::None, 10, 3, '.' };
     const static auto hex = NumericFormat{ NumericFormatFlags::HexPrefix, 16 };
 
-    const auto& currentObject = objects.at(currentItemIndex);
-    item.SetText(std::string_view{ currentObject.fileIdentifier, currentObject.lengthOfFileIdentifier });
+    const auto& currentObject = entries.at(currentItemIndex);
+    item.SetText(GetName(currentItemIndex));
 
     if (currentObject.fileFlags & ECMA_119_FileFlags::Directory)
     {
@@ -159,49 +491,40 @@ bool ISOFile::PopulateItem(TreeViewItem item)
     }
 
     item.SetPriority(currentObject.fileFlags & ECMA_119_FileFlags::Directory);
-    item.SetExpandable(currentObject.fileFlags & ECMA_119_FileFlags::Directory);
+    item.SetExpandable((currentObject.fileFlags & ECMA_119_FileFlags::Directory) && currentObject.childrenCount > 0);
 
-    item.SetText(1, nf.ToString((uint64) currentObject.dataLength.LSB, dec));
+    item.SetText(1, nf.ToString((uint64) currentObject.size, dec));
     item.SetText(2, RecordingDateAndTimeToString(currentObject.recordingDateAndTime));
-    item.SetText(3, nf.ToString((uint64) currentObject.locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB, hex));
+    item.SetText(3, nf.ToString(currentObject.offset, hex));
     item.SetText(4, GetECMA_119_FileFlags(currentObject.fileFlags));
 
-    const auto key = DRCRC64(currentObject);
-    const auto it  = itemsCache.find(key);
-    if (it == itemsCache.end())
-    {
-        auto res = itemsCache.emplace(std::pair{ key, currentObject });
-        item.SetData<ECMA_119_DirectoryRecord>(&res.first->second);
-    }
-    else
-    {
-        item.SetData<ECMA_119_DirectoryRecord>(&it->second);
-    }
+    item.SetData(static_cast<uint64>(currentItemIndex));
 
     currentItemIndex++;
 
-    return currentItemIndex != objects.size();
+    return currentItemIndex < currentItemEnd;
 }
 
 void ISOFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
 {
     CHECKRET(item.GetParent().GetHandle() != InvalidItemHandle, "");
 
-    auto data         = item.GetData<ECMA_119_DirectoryRecord>();
-    const auto offset = (uint64) data->locationOfExtent.LSB * pvd.vdd.logicalBlockSize.LSB;
-    const auto length = (uint32) data->dataLength.LSB;
-    const auto buffer = obj->GetData().CopyToBuffer(offset, length);
+    const auto index = static_cast<uint32>(item.GetData(INVALID_ENTRY));
+    CHECKRET(index < entries.size(), "");
+    const auto& entry = entries[index];
 
     LocalString<64> ls;
-    ls.Format("_0x%x_0x%x.bin", offset, length);
-    auto name = std::string{ data->fileIdentifier, data->lengthOfFileIdentifier };
-    name.append("_").append(ls.ToStringView());
+    ls.Format("_0x%llx_0x%x.bin", entry.offset, entry.size);
+    LocalUnicodeStringBuilder<256> name;
+    CHECKRET(name.Set(GetName(index)), "");
+    CHECKRET(name.Add("_"), "");
+    CHECKRET(name.Add(ls.ToStringView()), "");
 
     LocalUnicodeStringBuilder<64> lus{ ls };
     auto fullPath = std::u16string{ path.data(), path.size() };
     fullPath.append(lus.ToStringView());
 
-    GView::App::OpenBuffer(buffer, name, fullPath, GView::App::OpenMethod::BestMatch);
+    GView::App::OpenSubRange(obj, entry.offset, entry.size, name, fullPath, GView::App::OpenMethod::BestMatch);
 }
 
 GView::Utils::JsonBuilderInterface* ISOFile::GetSmartAssistantContext(const std::string_view& prompt, std::string_view displayPrompt)
@@ -211,6 +534,6 @@ GView::Utils::JsonBuilderInterface* ISOFile::GetSmartAssistantContext(const std:
     builder->AddUInt("ContentSize", obj->GetData().GetSize());
     if (root.lengthOfFileIdentifier > 0)
         builder->AddString("RootDirectory", std::string_view{ root.fileIdentifier, root.lengthOfFileIdentifier });
-    builder->AddUInt("NumberOfRecords", objects.size());
+    builder->AddUInt("NumberOfRecords", entries.size());
     return builder;
 }
@@ -38,7 +38,7 @@ struct ConnectionCallbackInterface {
 };
 
 struct PayloadInformation {
-    StreamPayload* payload;
+    const StreamPayloadView* payload;
     std::vector<StreamPacketData>* packets;
 };
 
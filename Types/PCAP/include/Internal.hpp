@@ -484,6 +484,13 @@ struct PacketHeader
 
 static_assert(sizeof(PacketHeader) == 16);
 
+// index entry for a packet: the packet bytes stay in the file and are fetched on demand
+struct PacketRecord
+{
+    uint64 offset;       /* file offset of the PacketHeader */
+    PacketHeader header; /* copy of the header (timestamps and lengths) */
+};
+
 enum class EtherType : uint16 // https://www.liveaction.com/resources/glossary/ethertype-values
 {
     Unknown                                      = 0,
@@ -1933,12 +1940,67 @@ static void Swap(ICMPHeader_13_14& icmp13_14)
     icmp13_14.transmitTimestamp  = AppCUI::Endian::BigToNative(icmp13_14.transmitTimestamp);
 }
 
-struct StreamPayload
+// payload of a single packet, described by its position in the file
+struct StreamPayloadSegment
 {
-    uint8* location;
+    uint64 offset;
     uint32 size;
 };
 
+struct StreamPacketData;
+
+// reassembled payload of a stream as a list of segments over the capture; bytes are read only when requested
+class StreamPayloadView
+{
+    GView::Utils::DataCache* data = nullptr;
+    std::vector<StreamPayloadSegment> segments;
+    std::vector<uint64> segmentStarts; // position of every segment inside the payload
+    uint64 size = 0;
+
+  public:
+    void Init(GView::Utils::DataCache* cache, const std::vector<StreamPacketData>& packets);
+
+    uint64 GetSize() const
+    {
+        return size;
+    }
+    const std::vector<StreamPayloadSegment>& GetSegments() const
+    {
+        return segments;
+    }
+
+    // copies the bytes from [position, position + length) into output, crossing segment boundaries if needed
+    bool Copy(uint64 position, uint32 length, uint8* output) const;
+    // same as Copy, but the length is truncated to the available payload
+    Buffer CopyToBuffer(uint64 position, uint32 length) const;
+};
+
+// sequential access over a StreamPayloadView through a small window
+class StreamPayloadCursor
+{
+    static constexpr uint32 WINDOW_SIZE = 64 * 1024;
+
+    const StreamPayloadView& view;
+    Buffer window;
+    uint64 windowStart = 0;
+    uint32 windowSize  = 0;
+
+    bool Load(uint64 position);
+
+  public:
+    explicit StreamPayloadCursor(const StreamPayloadView& payloadView) : view(payloadView)
+    {
+    }
+
+    inline bool Get(uint64 position, uint8& value)
+    {
+        if ((position < windowStart || position - windowStart >= windowSize) && !Load(position))
+            return false;
+        value = window.GetData()[position - windowStart];
+        return true;
+    }
+};
+
 // TODO: for the future maybe change structure for a more generic structure
 struct StreamTCPOrder
 {
@@ -1948,6 +2010,59 @@ struct StreamTCPOrder
     uint32 maxNumber; // between seqNumber and ackNumber
 };
 
+// binary identification of a flow (addresses and ports are in host byte order)
+struct FlowKey
+{
+    uint16 sourceAddress[8]; // IPv4 addresses use only the first 4 bytes
+    uint16 destinationAddress[8];
+    uint16 sourcePort;
+    uint16 destinationPort;
+    uint16 ipProtocol;
+    uint16 transportProtocol;
+
+    // same key for both directions of a flow: the lower endpoint is always the source
+    FlowKey Normalized() const
+    {
+        int32 result = memcmp(sourceAddress, destinationAddress, sizeof(sourceAddress));
+        if (result == 0)
+            result = (int32) sourcePort - (int32) destinationPort;
+        if (result <= 0)
+            return *this;
+
+        FlowKey key = *this;
+        memcpy(key.sourceAddress, destinationAddress, sizeof(sourceAddress));
+        memcpy(key.destinationAddress, sourceAddress, sizeof(destinationAddress));
+        key.sourcePort      = destinationPort;
+        key.destinationPort = sourcePort;
+        return key;
+    }
+
+    bool operator==(const FlowKey& other) const
+    {
+        return memcmp(this, &other, sizeof(FlowKey)) == 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40);
+
+struct FlowKeyHash
+{
+    size_t operator()(const FlowKey& key) const noexcept
+    {
+        uint64 words[sizeof(FlowKey) / sizeof(uint64)];
+        memcpy(words, &key, sizeof(FlowKey));
+
+        uint64 hash = 0x9E3779B97F4A7C15ULL;
+        for (const auto word : words)
+        {
+            hash ^= word;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+        }
+        return (size_t) hash;
+    }
+};
+
 struct LinkTypeInfo {
     LinkType type;
     void* header;
@@ -1967,10 +2082,9 @@ struct PacketData {
 };
 
 struct StreamPacketData {
-    const PacketHeader* header;
-    StreamPayload payload;
+    uint64 packetOffset; // file offset of the PacketHeader
+    StreamPayloadSegment payload;
     StreamTCPOrder order;
-    PacketData packetData;
 
     // TODO
     bool operator<(const StreamPacketData& other) const
@@ -1995,7 +2109,7 @@ struct StreamTcpLayer
 {
     std::unique_ptr<uint8[]> name;
     std::string_view extractionName;
-    StreamPayload payload;
+    StreamPayloadSegment payload; // offset is the position inside the stream payload
     void* payloadData;
 
     StreamTcpLayer() : name(nullptr), extractionName(), payload(), payloadData(nullptr)
@@ -2041,7 +2155,7 @@ struct StreamData
     uint16 ipProtocol                                        = INVALID_IP_PROTOCOL_VALUE;
     uint16 transportProtocol                                 = INVALID_TRANSPORT_PROTOCOL_VALUE;
     uint64 totalPayload                                      = 0;
-    std::string name                                         = {};
+    FlowKey endpoints                                        = {}; // source is the endpoint that started the flow
     bool isFinished                                          = false;
     uint8 finFlagsFound                                      = 0;
     std::string appLayerName                                 = "";
@@ -2050,7 +2164,7 @@ struct StreamData
     std::deque<StreamTcpLayer> applicationLayers;
     struct PayloadDataParserInterface* payloadParserFound = nullptr;
 
-    StreamPayload connPayload;
+    StreamPayloadView connPayload;
     // Delete copy constructor and assignment operator
     StreamData(const StreamData&)            = delete;
     StreamData& operator=(const StreamData&) = delete;
@@ -2074,6 +2188,9 @@ struct StreamData
             summary.erase(summary.begin() + PCAP_MAX_SUMMARY_SIZE, summary.begin() + summary.size());
     }
 
+    // "src:port -> dst:port", built only when the stream is displayed
+    std::string GetName() const;
+
     std::string_view GetIpProtocolName() const
     {
         if (ipProtocol == INVALID_IP_PROTOCOL_VALUE)
@@ -2093,7 +2210,7 @@ struct StreamData
         std::sort(packetsOffsets.begin(), packetsOffsets.end());
     }
 
-    void ComputeFinalPayload();
+    void ComputeFinalPayload(GView::Utils::DataCache& data);
     //void TryParsePayload();
 };
 
@@ -3,16 +3,16 @@
 #include "Internal.hpp"
 #include "Utils.hpp"
 #include "StreamManager.hpp"
+#include "PacketFilter.hpp"
 
 namespace GView::Type::PCAP
 {
 class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
   public:
-    Buffer data; // it's maximum 0xFFFF so just save it here
-
     Header header;
-    std::vector<std::pair<PacketHeader*, uint32>> packetHeaders;
+    std::vector<PacketRecord> packets;
+    std::vector<PacketSummary> summaries; // built the first time a filter is applied
     StreamManager streamManager;
 
 	uint32 currentItemIndex{ 0 };
@@ -24,6 +24,13 @@ class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateIn
 
     bool Update();
 
+    // loads the packet bytes (header included) into output, reusing its memory
+    bool GetPacket(const PacketRecord& record, Buffer& output);
+
+    bool BuildPacketSummaries();
+    // indexes of the packets matched by the filter (evaluated in parallel over chunks of packets)
+    bool FilterPackets(const PacketFilter& filter, std::vector<uint32>& output);
+
     std::string_view GetTypeName() override
     {
         return "PCAP";
@@ -159,12 +166,19 @@ namespace Panels
         Reference<PCAPFile> pcap;
         Reference<GView::View::WindowInterface> win;
         Reference<AppCUI::Controls::ListView> list;
+        Reference<AppCUI::Controls::Label> filterStatus;
         int32 Base;
 
+        PacketFilter filter;
+        std::string filterText;
+        std::vector<uint32> visiblePackets;
+
         std::string_view GetValue(NumericFormatter& n, uint64 value);
         void GoToSelectedSection();
         void SelectCurrentSection();
         void OpenPacket();
+        void ChangeFilter();
+        void ApplyFilter();
 
       public:
         Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> win);
@@ -173,6 +187,21 @@ namespace Panels
         bool OnUpdateCommandBar(AppCUI::Application::CommandBar& commandBar) override;
         bool OnEvent(Reference<Control>, Event evnt, int controlID) override;
 
+        class FilterDialog : public Window
+        {
+            Reference<TextField> input;
+            std::string expression;
+
+          public:
+            FilterDialog(std::string_view currentExpression);
+
+            bool OnEvent(Reference<Control> ctrl, Event evnt, int controlID) override;
+            std::string_view GetExpression() const
+            {
+                return expression;
+            }
+        };
+
         class PacketDialog : public Window
         {
             Reference<GView::Object> object;
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Internal.hpp"
+
+namespace GView::Type::PCAP
+{
+// the fields of a packet that filters can test (IPv4 addresses are in host byte order)
+struct PacketSummary
+{
+    uint32 sourceAddress;
+    uint32 destinationAddress;
+    uint16 sourcePort;
+    uint16 destinationPort;
+    uint8 ipVersion; // 0 if the packet has no IP layer
+    uint8 protocol;  // IP_Protocol of the transport layer
+    uint16 reserved;
+};
+
+static_assert(sizeof(PacketSummary) == 16);
+
+bool BuildPacketSummary(const PacketHeader* packet, LinkType network, PacketSummary& summary);
+
+/*
+ * Filter expressions for packets, compiled into a postfix program. Examples:
+ *      tcp.port == 443 && ip.src in 10.0.0.0/8 && len > 1000
+ *      (udp || icmp) and not ip.addr == 192.168.1.1
+ * Fields: len, frame.len, frame.origlen, frame.time, ip.src, ip.dst, ip.addr, ip.proto,
+ *         tcp.srcport, tcp.dstport, tcp.port, udp.srcport, udp.dstport, udp.port
+ * Protocols: ip, ipv4, ipv6, tcp, udp, icmp
+ */
+class PacketFilter
+{
+  public:
+    enum class Field : uint8
+    {
+        Length,
+        OriginalLength,
+        Time,
+        IpSource,
+        IpDestination,
+        IpAddress, // source or destination
+        IpProtocol,
+        TcpSourcePort,
+        TcpDestinationPort,
+        TcpPort, // source or destination
+        UdpSourcePort,
+        UdpDestinationPort,
+        UdpPort, // source or destination
+    };
+    enum class OpCode : uint8
+    {
+        Compare,
+        HasIpVersion,
+        HasProtocol,
+        And,
+        Or,
+        Not,
+    };
+    enum class Comparison : uint8
+    {
+        Equal,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual,
+    };
+    struct Instruction
+    {
+        OpCode op;
+        Field field;
+        Comparison comparison;
+        uint8 protocol; // ip version for HasIpVersion, IP_Protocol for HasProtocol
+        uint32 mask;    // applied to the field value before comparing (network prefix for addresses)
+        uint64 value;
+    };
+
+    static constexpr uint32 MAX_STACK_DEPTH = 64;
+
+  private:
+    std::vector<Instruction> program;
+    std::string error;
+
+  public:
+    // an empty expression matches every packet
+    bool Compile(std::string_view expression);
+    bool Matches(const PacketRecord& record, const PacketSummary& summary) const;
+
+    bool Empty() const
+    {
+        return program.empty();
+    }
+    std::string_view GetError() const
+    {
+        return error;
+    }
+};
+} // namespace GView::Type::PCAP
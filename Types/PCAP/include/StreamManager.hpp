@@ -4,30 +4,76 @@
 
 namespace GView::Type::PCAP
 {
+// compact result of dissecting a packet, it does not reference the packet bytes
+struct DissectedPacket
+{
+    FlowKey key; // in the direction of the packet (not normalized)
+    uint64 flowHash;
+    uint64 packetOffset;
+    StreamPayloadSegment payload;
+    uint32 index; // index of the packet in the capture
+    uint32 seqNumber;
+    uint32 ackNumber;
+    uint8 tcpFlags;
+};
+
+// reads consecutive packets from a capture file in large chunks (one instance per thread)
+class PacketFileReader
+{
+    AppCUI::OS::File file;
+    Buffer chunk;
+    uint64 chunkStart = 0;
+    uint32 chunkSize  = 0;
+
+  public:
+    static constexpr uint32 MIN_PACKETS_PER_WORKER = 16384;
+
+    bool Open(const std::filesystem::path& path);
+    // the result is valid until the next call
+    const PacketHeader* Get(const PacketRecord& record);
+
+    // number of threads worth using for the given capture (1 if it can not be read from multiple threads)
+    static uint32 GetWorkersCount(Reference<GView::Object> object, uint32 packetsCount);
+};
+
+struct FlowTable
+{
+    std::unordered_map<FlowKey, uint32, FlowKeyHash> indexes; // normalized key -> index in flows
+    std::vector<std::deque<StreamData>> flows;                 // connections of each flow, in order of appearance
+    std::vector<uint32> firstPackets;                          // index of the first packet of each flow
+};
+
 class StreamManager
 {
-    std::unordered_map<std::string, std::deque<StreamData>> streams;
+    FlowTable flowTable;
     std::vector<StreamData> finalStreams;
     std::vector<std::string> protocolsFound;
     std::vector<unique_ptr<PayloadDataParserInterface>> payloadParsers;
     Reference<GView::View::WindowInterface> window;
 
     // TODO: maybe sync functions with those used in Panels?
-    void Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet);
-    void Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet);
+    // the dissection functions only read the packet, so they can run on multiple threads
+    static bool Dissect_Package_EthernetHeader(DissectedPacket& result, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet);
+    static bool Dissect_Package_NullHeader(DissectedPacket& result, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet);
+
+    static bool Dissect_IPv4Header(DissectedPacket& result, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet);
+    static bool Dissect_IPv6Header(DissectedPacket& result, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet);
 
-    void Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet);
-    void Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet);
+    static bool Dissect_TCPHeader(
+          DissectedPacket& result, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet);
 
-    void Add_TCPHeader(PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet);
+    static bool DissectPacket(const PacketHeader* packet, LinkType network, DissectedPacket& result);
+    static void AddDissectedPacket(FlowTable& table, const DissectedPacket& packet);
 
     void AddToKnownProtocols(const std::string& layerName);
 
   public:
     StreamManager() = default;
 
-    void AddPacket(const PacketHeader* packet, LinkType network);
-    void FinishedAdding();
+    // dissects the packets (in parallel for large captures) and groups them into streams;
+    // only file offsets are retained, the packet bytes are read again when needed
+    void AddPackets(Reference<GView::Object> object, const std::vector<PacketRecord>& packets, LinkType network);
+    void FinishedAdding(GView::Utils::DataCache& data);
     bool RegisterPayloadParser(unique_ptr<PayloadDataParserInterface> parser);
 
     void InitStreamManager(Reference<GView::View::WindowInterface> windowParam);
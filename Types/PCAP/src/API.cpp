@@ -28,23 +28,22 @@ struct ConnectionCallbackInterfaceImpl : public ConnectionCallbackInterface {
     }
 };
 
-void StreamManager::FinishedAdding()
+void StreamManager::FinishedAdding(GView::Utils::DataCache& data)
 {
-    if (streams.empty())
+    if (flowTable.flows.empty())
         return;
 
-    finalStreams.reserve(streams.size());
+    finalStreams.reserve(flowTable.flows.size());
 
-    for (auto& [streamName, connections] : streams) {
+    for (auto& connections : flowTable.flows) {
         for (auto& conn : connections) {
-            conn.name = streamName;
             // conn.SortPackets();
-            conn.ComputeFinalPayload();
+            conn.ComputeFinalPayload(data);
 
             ConnectionCallbackInterfaceImpl callbackInterface = {};
             callbackInterface.streamData                      = &conn;
 
-            if (conn.connPayload.size) {
+            if (conn.connPayload.GetSize()) {
                 PayloadInformation payloadInfo{ &conn.connPayload, &conn.packetsOffsets };
                 for (auto& parser : payloadParsers) {
                     auto result = parser->ParsePayload(payloadInfo, &callbackInterface);
@@ -61,5 +60,5 @@ void StreamManager::FinishedAdding()
         }
     }
 
-    streams.clear();
+    flowTable = {};
 }
\ No newline at end of file
@@ -62,10 +62,10 @@ extern "C"
 
         auto count = 0;
         LocalString<32> ls;
-        for (const auto& [header, offset] : pcap->packetHeaders)
+        for (const auto& record : pcap->packets)
         {
             const auto& c = *(colors.begin() + (count % 2));
-            settings.AddZone(offset, sizeof(PCAP::PacketHeader) + header->inclLen, c, ls.Format("Packet_%u", count));
+            settings.AddZone(record.offset, sizeof(PCAP::PacketHeader) + record.header.inclLen, c, ls.Format("Packet_%u", count));
             count++;
         }
 
@@ -91,9 +91,8 @@ extern "C"
         settings.SetEnumerateCallback(win->GetObject()->GetContentType<GView::Type::PCAP::PCAPFile>().ToObjectRef<ContainerViewer::EnumerateInterface>());
         settings.SetOpenItemCallback(win->GetObject()->GetContentType<GView::Type::PCAP::PCAPFile>().ToObjectRef<ContainerViewer::OpenItemInterface>());
 
-        for (const auto& [header, offset] : pcap->packetHeaders)
-            pcap->streamManager.AddPacket(header, pcap->header.network);
-        pcap->streamManager.FinishedAdding();
+        pcap->streamManager.AddPackets(win->GetObject(), pcap->packets, pcap->header.network);
+        pcap->streamManager.FinishedAdding(win->GetObject()->GetData());
 
 		const auto properties = pcap->GetPropertiesForContainerView();
         for (const auto& property : properties)
@@ -1,5 +1,8 @@
 #include "PCAP.hpp"
 
+#include <algorithm>
+#include <thread>
+
 using namespace GView::Type::PCAP;
 
 PCAPFile::PCAPFile()
@@ -8,7 +11,7 @@ PCAPFile::PCAPFile()
 
 bool PCAPFile::Update()
 {
-    auto offset = 0;
+    uint64 offset = 0;
     CHECK(obj->GetData().Copy<Header>(offset, header), false, "");
     offset += sizeof(Header);
     if (header.magicNumber == Magic::Swapped)
@@ -16,17 +19,144 @@ bool PCAPFile::Update()
         Swap(header);
     }
 
-    // TODO: check for future, is this really ok? test with big pcap files
-    data = obj->GetData().CopyToBuffer(offset, (uint32) obj->GetData().GetSize() - offset);
-    CHECK(data.IsValid(), false, "");
+    // only the packet headers are read here, the packet bytes are fetched on demand (GetPacket)
+    const auto fileSize = obj->GetData().GetSize();
+    packets.clear();
+    while (offset + sizeof(PacketHeader) <= fileSize)
+    {
+        PacketRecord record{ offset, {} };
+        CHECKBK(obj->GetData().Copy<PacketHeader>(offset, record.header), "");
+        CHECKBK(offset + sizeof(PacketHeader) + record.header.inclLen <= fileSize, "Truncated packet at offset %llu", offset);
+
+        packets.push_back(record);
+        offset += sizeof(PacketHeader) + record.header.inclLen;
+    }
+
+    return true;
+}
+
+bool PCAPFile::GetPacket(const PacketRecord& record, Buffer& output)
+{
+    const uint32 size = sizeof(PacketHeader) + record.header.inclLen;
+    auto& data        = obj->GetData();
+
+    if (size > data.GetCacheSize())
+    {
+        output = data.CopyToBuffer(record.offset, size);
+        return output.IsValid();
+    }
+
+    const auto view = data.Get(record.offset, size, true);
+    CHECK(view.IsValid(), false, "");
+    output.Resize(size);
+    memcpy(output.GetData(), view.GetData(), size);
+
+    return true;
+}
+
+bool PCAPFile::BuildPacketSummaries()
+{
+    if (summaries.size() == packets.size())
+        return true;
+
+    const auto packetsCount   = (uint32) packets.size();
+    const uint32 workersCount = PacketFileReader::GetWorkersCount(obj, packetsCount);
+    // filled aside and only then published, so that a partially built table is never taken as complete
+    std::vector<PacketSummary> result(packetsCount);
+
+    // through the object's cache, on the calling thread
+    const auto buildSerially = [this, &result](uint32 start, uint32 end) {
+        Buffer packet;
+        for (uint32 index = start; index < end; index++)
+            if (GetPacket(packets[index], packet))
+                BuildPacketSummary(reinterpret_cast<const PacketHeader*>(packet.GetData()), header.network, result[index]);
+    };
+
+    if (workersCount == 1)
+    {
+        buildSerially(0, packetsCount);
+        summaries = std::move(result);
+        return true;
+    }
+
+    const std::filesystem::path path(obj->GetPath());
+    std::vector<uint8> failed(workersCount, 0);
+    std::vector<std::thread> threads;
+    threads.reserve(workersCount);
+    for (uint32 worker = 0; worker < workersCount; worker++)
+    {
+        threads.emplace_back([this, &path, &result, &failed, worker, workersCount, packetsCount]() {
+            PacketFileReader reader;
+            if (!reader.Open(path))
+            {
+                failed[worker] = 1;
+                return;
+            }
+            const auto end = (uint32) ((uint64) packetsCount * (worker + 1) / workersCount);
+            for (auto index = (uint32) ((uint64) packetsCount * worker / workersCount); index < end; index++)
+            {
+                const auto packet = reader.Get(packets[index]);
+                if (!packet)
+                {
+                    failed[worker] = 1;
+                    return;
+                }
+                BuildPacketSummary(packet, header.network, result[index]);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    // a worker that could not read its packets through its own handle --> its range is done again through the cache
+    for (uint32 worker = 0; worker < workersCount; worker++)
+        if (failed[worker])
+            buildSerially((uint32) ((uint64) packetsCount * worker / workersCount), (uint32) ((uint64) packetsCount * (worker + 1) / workersCount));
+
+    summaries = std::move(result);
+    return true;
+}
 
-    const auto delta = offset;
-    do
+bool PCAPFile::FilterPackets(const PacketFilter& filter, std::vector<uint32>& output)
+{
+    output.clear();
+    const auto packetsCount = (uint32) packets.size();
+    if (filter.Empty())
+    {
+        output.resize(packetsCount);
+        for (uint32 index = 0; index < packetsCount; index++)
+            output[index] = index;
+        return true;
+    }
+    CHECK(BuildPacketSummaries(), false, "");
+
+    const uint32 workersCount =
+          std::clamp<uint32>(packetsCount / PacketFileReader::MIN_PACKETS_PER_WORKER, 1, std::max<uint32>(std::thread::hardware_concurrency(), 1));
+    std::vector<std::vector<uint32>> results(workersCount);
+    const auto evaluate = [&](uint32 worker) {
+        const auto end = (uint32) ((uint64) packetsCount * (worker + 1) / workersCount);
+        for (auto index = (uint32) ((uint64) packetsCount * worker / workersCount); index < end; index++)
+            if (filter.Matches(packets[index], summaries[index]))
+                results[worker].push_back(index);
+    };
+
+    if (workersCount == 1)
     {
-        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (data.GetData() + offset - delta), offset);
-        offset += (sizeof(PacketHeader) + header->origLen);
-    } while (offset < obj->GetData().GetSize());
+        evaluate(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(workersCount);
+        for (uint32 worker = 0; worker < workersCount; worker++)
+            threads.emplace_back(evaluate, worker);
+        for (auto& thread : threads)
+            thread.join();
+    }
 
+    // chunks are consecutive --> concatenating them keeps the capture order
+    for (const auto& result : results)
+        output.insert(output.end(), result.begin(), result.end());
     return true;
 }
 
@@ -94,7 +224,7 @@ bool PCAPFile::PopulateItem(TreeViewItem item)
         item.SetData(currentItemIndex);
 
         item.SetText(tmp.Format("%s", n.ToString(streamIndex, NUMERIC_FORMAT).data()));
-        item.SetText(1, stream->name);
+        item.SetText(1, stream->GetName());
         item.SetText(2, stream->GetIpProtocolName());
         item.SetText(3, stream->GetTransportProtocolName());
         item.SetText(4, tmp.Format("%s", n.ToString(stream->totalPayload, NUMERIC_FORMAT).data()));
@@ -156,16 +286,15 @@ void PCAPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIt
     if (layer.payload.size == 0)
         return;
 
-    uint8* payload = new uint8[layer.payload.size];
-    memcpy(payload, layer.payload.location, layer.payload.size);
-
     std::string extractionName;
     if (!layer.extractionName.empty())
         extractionName = std::string(layer.extractionName.data(), layer.extractionName.size());
     else
         extractionName = (const char*) layer.name.get();
 
-    const Buffer buffer = { payload, layer.payload.size };
+    const Buffer buffer = stream->connPayload.CopyToBuffer(layer.payload.offset, layer.payload.size);
+    if (!buffer.IsValid())
+        return;
 
     GView::App::OpenBuffer(buffer, extractionName, extractionName, GView::App::OpenMethod::BestMatch);
 }
@@ -180,7 +309,7 @@ std::vector<std::pair<std::string, std::string>> PCAPFile::GetPropertiesForConta
 
     NumericFormatter n;
     result.emplace_back("PCAP Version", tmp.GetText());
-    result.emplace_back("Total packets", n.ToString((uint32) packetHeaders.size(), NumericFormatFlags::None).data());
+    result.emplace_back("Total packets", n.ToString((uint32) packets.size(), NumericFormatFlags::None).data());
     result.emplace_back("Total streams", n.ToString((uint32) streamManager.size(), NumericFormatFlags::None).data());
     result.emplace_back("Protocols", streamManager.GetProtocolsFound().data());
 
@@ -192,7 +321,7 @@ GView::Utils::JsonBuilderInterface* PCAPFile::GetSmartAssistantContext(const std
     auto builder = GView::Utils::JsonBuilderInterface::Create();
     builder->AddU16String("Name", obj->GetName());
     builder->AddUInt("ContentSize", obj->GetData().GetSize());
-    builder->AddUInt("TotalPackets", packetHeaders.size());
+    builder->AddUInt("TotalPackets", packets.size());
     builder->AddUInt("TotalStreams", streamManager.size());
     return builder;
 }
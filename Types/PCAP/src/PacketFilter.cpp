@@ -0,0 +1,546 @@
+#include "PacketFilter.hpp"
+
+using namespace GView::Type::PCAP;
+
+bool GView::Type::PCAP::BuildPacketSummary(const PacketHeader* packet, LinkType network, PacketSummary& summary)
+{
+    summary         = {};
+    auto data       = (const uint8*) packet + sizeof(PacketHeader);
+    uint32 length   = packet->inclLen;
+    uint16 etherRaw = 0;
+
+    if (network == LinkType::ETHERNET)
+    {
+        if (length < sizeof(Package_EthernetHeader))
+            return true;
+        auto pehRef = *(const Package_EthernetHeader*) data;
+        Swap(pehRef);
+        etherRaw = pehRef.etherType;
+        data += sizeof(Package_EthernetHeader);
+        length -= sizeof(Package_EthernetHeader);
+    }
+    else if (network == LinkType::NULL_)
+    {
+        if (length < sizeof(Package_NullHeader) || ((const Package_NullHeader*) data)->family_ip != NULL_FAMILY_IP)
+            return true;
+        data += sizeof(Package_NullHeader);
+        length -= sizeof(Package_NullHeader);
+    }
+    else
+    {
+        return true;
+    }
+
+    IP_Protocol protocol;
+    const auto etherType = network == LinkType::NULL_ ? EtherType::IPv4 : PCAP::GetEtherType(etherRaw);
+    if (etherType == EtherType::IPv4)
+    {
+        if (length < sizeof(IPv4Header))
+            return true;
+        auto ipv4                  = (const IPv4Header*) data;
+        summary.ipVersion          = 4;
+        summary.sourceAddress      = AppCUI::Endian::BigToNative(ipv4->sourceAddress);
+        summary.destinationAddress = AppCUI::Endian::BigToNative(ipv4->destinationAddress);
+        protocol                   = ipv4->protocol;
+        data += sizeof(IPv4Header);
+        length -= sizeof(IPv4Header);
+    }
+    else if (etherType == EtherType::IPv6)
+    {
+        if (length < sizeof(IPv6Header))
+            return true;
+        summary.ipVersion = 6;
+        protocol          = ((const IPv6Header*) data)->nextHeader;
+        data += sizeof(IPv6Header);
+        length -= sizeof(IPv6Header);
+    }
+    else
+    {
+        return true;
+    }
+
+    summary.protocol = static_cast<uint8>(protocol);
+    if (protocol == IP_Protocol::TCP && length >= sizeof(TCPHeader))
+    {
+        auto tcp                = (const TCPHeader*) data;
+        summary.sourcePort      = AppCUI::Endian::BigToNative(tcp->sPort);
+        summary.destinationPort = AppCUI::Endian::BigToNative(tcp->dPort);
+    }
+    else if (protocol == IP_Protocol::UDP && length >= sizeof(UDPHeader))
+    {
+        auto udp                = (const UDPHeader*) data;
+        summary.sourcePort      = AppCUI::Endian::BigToNative(udp->srcPort);
+        summary.destinationPort = AppCUI::Endian::BigToNative(udp->destPort);
+    }
+
+    return true;
+}
+
+namespace
+{
+enum class TokenType : uint8
+{
+    None,
+    Identifier,
+    Value, // numbers and addresses
+    Equal,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+    And,
+    Or,
+    Not,
+    In,
+    OpenParenthesis,
+    CloseParenthesis,
+    Invalid,
+};
+
+struct Token
+{
+    TokenType type;
+    std::string_view text;
+};
+
+struct FieldName
+{
+    std::string_view name;
+    PacketFilter::Field field;
+};
+
+constexpr FieldName FIELD_NAMES[] = {
+    { "len", PacketFilter::Field::Length },
+    { "frame.len", PacketFilter::Field::Length },
+    { "frame.origlen", PacketFilter::Field::OriginalLength },
+    { "frame.time", PacketFilter::Field::Time },
+    { "ip.src", PacketFilter::Field::IpSource },
+    { "ip.dst", PacketFilter::Field::IpDestination },
+    { "ip.addr", PacketFilter::Field::IpAddress },
+    { "ip.proto", PacketFilter::Field::IpProtocol },
+    { "tcp.srcport", PacketFilter::Field::TcpSourcePort },
+    { "tcp.dstport", PacketFilter::Field::TcpDestinationPort },
+    { "tcp.port", PacketFilter::Field::TcpPort },
+    { "udp.srcport", PacketFilter::Field::UdpSourcePort },
+    { "udp.dstport", PacketFilter::Field::UdpDestinationPort },
+    { "udp.port", PacketFilter::Field::UdpPort },
+};
+
+bool IsAddressField(PacketFilter::Field field)
+{
+    return field == PacketFilter::Field::IpSource || field == PacketFilter::Field::IpDestination || field == PacketFilter::Field::IpAddress;
+}
+
+bool ParseNumber(std::string_view text, uint64& value)
+{
+    uint32 base = 10;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        base = 16;
+        text = text.substr(2);
+    }
+    CHECK(!text.empty(), false, "");
+
+    value = 0;
+    for (const auto c : text)
+    {
+        uint32 digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (base == 16 && c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (base == 16 && c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return false;
+        CHECK(value <= (0xFFFFFFFFFFFFFFFFULL - digit) / base, false, "");
+        value = value * base + digit;
+    }
+    return true;
+}
+
+// "a.b.c.d" or "a.b.c.d/prefix"
+bool ParseIPv4(std::string_view text, uint32& address, uint32& mask)
+{
+    uint32 prefix    = 32;
+    const auto slash = text.find('/');
+    if (slash != std::string_view::npos)
+    {
+        uint64 value;
+        CHECK(ParseNumber(text.substr(slash + 1), value) && value <= 32, false, "");
+        prefix = (uint32) value;
+        text   = text.substr(0, slash);
+    }
+
+    address = 0;
+    for (uint32 part = 0; part < 4; part++)
+    {
+        const auto dot = text.find('.');
+        CHECK((dot == std::string_view::npos) == (part == 3), false, "");
+
+        uint64 value;
+        CHECK(ParseNumber(text.substr(0, dot), value) && value <= 0xFF, false, "");
+        address = (address << 8) | (uint32) value;
+        if (dot != std::string_view::npos)
+            text = text.substr(dot + 1);
+    }
+
+    mask = prefix == 0 ? 0 : 0xFFFFFFFFU << (32 - prefix);
+    address &= mask;
+    return true;
+}
+
+class FilterCompiler
+{
+    std::string_view text;
+    size_t position = 0;
+    Token current{};
+    std::vector<PacketFilter::Instruction>& program;
+    std::string& error;
+    uint32 depth    = 0;
+    uint32 maxDepth = 0;
+
+    void Next()
+    {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t'))
+            position++;
+        if (position >= text.size())
+        {
+            current = { TokenType::None, {} };
+            return;
+        }
+
+        const auto start = position;
+        const auto c     = text[position];
+        const auto next  = position + 1 < text.size() ? text[position + 1] : 0;
+        auto set         = [&](TokenType type, size_t size) {
+            current = { type, text.substr(start, size) };
+            position += size;
+        };
+
+        if (isalpha((uint8) c) || c == '_')
+        {
+            while (position < text.size() && (isalnum((uint8) text[position]) || text[position] == '_' || text[position] == '.'))
+                position++;
+            current = { TokenType::Identifier, text.substr(start, position - start) };
+            if (current.text == "and")
+                current.type = TokenType::And;
+            else if (current.text == "or")
+                current.type = TokenType::Or;
+            else if (current.text == "not")
+                current.type = TokenType::Not;
+            else if (current.text == "in")
+                current.type = TokenType::In;
+            return;
+        }
+        if (isdigit((uint8) c))
+        {
+            while (position < text.size() && (isalnum((uint8) text[position]) || text[position] == '.' || text[position] == '/'))
+                position++;
+            current = { TokenType::Value, text.substr(start, position - start) };
+            return;
+        }
+
+        switch (c)
+        {
+        case '=':
+            return set(next == '=' ? TokenType::Equal : TokenType::Invalid, next == '=' ? 2 : 1);
+        case '!':
+            return next == '=' ? set(TokenType::NotEqual, 2) : set(TokenType::Not, 1);
+        case '<':
+            return next == '=' ? set(TokenType::LessOrEqual, 2) : set(TokenType::Less, 1);
+        case '>':
+            return next == '=' ? set(TokenType::GreaterOrEqual, 2) : set(TokenType::Greater, 1);
+        case '&':
+            return set(next == '&' ? TokenType::And : TokenType::Invalid, next == '&' ? 2 : 1);
+        case '|':
+            return set(next == '|' ? TokenType::Or : TokenType::Invalid, next == '|' ? 2 : 1);
+        case '(':
+            return set(TokenType::OpenParenthesis, 1);
+        case ')':
+            return set(TokenType::CloseParenthesis, 1);
+        default:
+            return set(TokenType::Invalid, 1);
+        }
+    }
+
+    bool Fail(std::string_view message)
+    {
+        LocalString<256> ls;
+        error = ls.Format("%.*s (at position %u)", (int) message.size(), message.data(), (uint32) (position - current.text.size())).data();
+        return false;
+    }
+
+    void Emit(PacketFilter::OpCode op, PacketFilter::Field field = {}, PacketFilter::Comparison comparison = {}, uint8 protocol = 0, uint32 mask = 0, uint64 value = 0)
+    {
+        program.push_back({ op, field, comparison, protocol, mask, value });
+        if (op == PacketFilter::OpCode::And || op == PacketFilter::OpCode::Or)
+            depth--;
+        else if (op != PacketFilter::OpCode::Not)
+            depth++;
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    bool ParseComparison(PacketFilter::Field field)
+    {
+        const auto op = current.type;
+        Next();
+        CHECK(current.type == TokenType::Value, Fail("Expecting a value"), "");
+
+        uint64 value;
+        uint32 mask = 0xFFFFFFFFU;
+        if (IsAddressField(field))
+        {
+            uint32 address;
+            CHECK(ParseIPv4(current.text, address, mask), Fail("Invalid IPv4 address"), "");
+            value = address;
+        }
+        else
+        {
+            CHECK(op != TokenType::In, Fail("'in' can only be used with IP addresses"), "");
+            CHECK(ParseNumber(current.text, value), Fail("Invalid number"), "");
+        }
+        Next();
+
+        PacketFilter::Comparison comparison;
+        switch (op)
+        {
+        case TokenType::Equal:
+        case TokenType::NotEqual:
+        case TokenType::In:
+            comparison = PacketFilter::Comparison::Equal;
+            break;
+        case TokenType::Less:
+            comparison = PacketFilter::Comparison::Less;
+            break;
+        case TokenType::LessOrEqual:
+            comparison = PacketFilter::Comparison::LessOrEqual;
+            break;
+        case TokenType::Greater:
+            comparison = PacketFilter::Comparison::Greater;
+            break;
+        default:
+            comparison = PacketFilter::Comparison::GreaterOrEqual;
+            break;
+        }
+
+        Emit(PacketFilter::OpCode::Compare, field, comparison, 0, mask, value);
+        if (op == TokenType::NotEqual)
+            Emit(PacketFilter::OpCode::Not);
+        return true;
+    }
+
+    bool ParsePrimary()
+    {
+        if (current.type == TokenType::OpenParenthesis)
+        {
+            Next();
+            CHECK(ParseOr(), false, "");
+            CHECK(current.type == TokenType::CloseParenthesis, Fail("Expecting ')'"), "");
+            Next();
+            return true;
+        }
+        CHECK(current.type == TokenType::Identifier, Fail("Expecting a field or a protocol"), "");
+
+        const auto name = current.text;
+        Next();
+        switch (current.type)
+        {
+        case TokenType::Equal:
+        case TokenType::NotEqual:
+        case TokenType::Less:
+        case TokenType::LessOrEqual:
+        case TokenType::Greater:
+        case TokenType::GreaterOrEqual:
+        case TokenType::In:
+            for (const auto& entry : FIELD_NAMES)
+                if (entry.name == name)
+                    return ParseComparison(entry.field);
+            return Fail("Unknown field");
+        default:
+            break;
+        }
+
+        if (name == "ip" || name == "ipv4")
+            Emit(PacketFilter::OpCode::HasIpVersion, {}, {}, 4);
+        else if (name == "ipv6")
+            Emit(PacketFilter::OpCode::HasIpVersion, {}, {}, 6);
+        else if (name == "tcp")
+            Emit(PacketFilter::OpCode::HasProtocol, {}, {}, static_cast<uint8>(IP_Protocol::TCP));
+        else if (name == "udp")
+            Emit(PacketFilter::OpCode::HasProtocol, {}, {}, static_cast<uint8>(IP_Protocol::UDP));
+        else if (name == "icmp")
+            Emit(PacketFilter::OpCode::HasProtocol, {}, {}, static_cast<uint8>(IP_Protocol::ICMP));
+        else
+            return Fail("Unknown protocol");
+        return true;
+    }
+
+    bool ParseUnary()
+    {
+        if (current.type == TokenType::Not)
+        {
+            Next();
+            CHECK(ParseUnary(), false, "");
+            Emit(PacketFilter::OpCode::Not);
+            return true;
+        }
+        return ParsePrimary();
+    }
+
+    bool ParseAnd()
+    {
+        CHECK(ParseUnary(), false, "");
+        while (current.type == TokenType::And)
+        {
+            Next();
+            CHECK(ParseUnary(), false, "");
+            Emit(PacketFilter::OpCode::And);
+        }
+        return true;
+    }
+
+    bool ParseOr()
+    {
+        CHECK(ParseAnd(), false, "");
+        while (current.type == TokenType::Or)
+        {
+            Next();
+            CHECK(ParseAnd(), false, "");
+            Emit(PacketFilter::OpCode::Or);
+        }
+        return true;
+    }
+
+  public:
+    FilterCompiler(std::string_view expression, std::vector<PacketFilter::Instruction>& output, std::string& errorOutput)
+        : text(expression), program(output), error(errorOutput)
+    {
+    }
+
+    bool Compile()
+    {
+        Next();
+        CHECK(ParseOr(), false, "");
+        CHECK(current.type == TokenType::None, Fail("Unexpected token"), "");
+        CHECK(maxDepth <= PacketFilter::MAX_STACK_DEPTH, Fail("Expression is too complex"), "");
+        return true;
+    }
+};
+
+inline bool Compare(PacketFilter::Comparison comparison, uint64 left, uint64 right)
+{
+    switch (comparison)
+    {
+    case PacketFilter::Comparison::Equal:
+        return left == right;
+    case PacketFilter::Comparison::Less:
+        return left < right;
+    case PacketFilter::Comparison::LessOrEqual:
+        return left <= right;
+    case PacketFilter::Comparison::Greater:
+        return left > right;
+    default:
+        return left >= right;
+    }
+}
+} // namespace
+
+bool PacketFilter::Compile(std::string_view expression)
+{
+    program.clear();
+    error.clear();
+
+    const auto first = expression.find_first_not_of(" \t");
+    if (first == std::string_view::npos)
+        return true;
+
+    FilterCompiler compiler(expression, program, error);
+    if (!compiler.Compile())
+    {
+        program.clear();
+        return false;
+    }
+    return true;
+}
+
+bool PacketFilter::Matches(const PacketRecord& record, const PacketSummary& summary) const
+{
+    bool stack[MAX_STACK_DEPTH];
+    uint32 top = 0;
+
+    for (const auto& instruction : program)
+    {
+        switch (instruction.op)
+        {
+        case OpCode::Compare:
+        {
+            uint64 values[2];
+            uint32 count = 1;
+            bool valid   = true;
+            switch (instruction.field)
+            {
+            case Field::Length:
+                values[0] = record.header.inclLen;
+                break;
+            case Field::OriginalLength:
+                values[0] = record.header.origLen;
+                break;
+            case Field::Time:
+                values[0] = record.header.tsSec;
+                break;
+            case Field::IpSource:
+            case Field::IpDestination:
+            case Field::IpAddress:
+                valid     = summary.ipVersion == 4;
+                values[0] = instruction.field == Field::IpDestination ? summary.destinationAddress : summary.sourceAddress;
+                values[1] = summary.destinationAddress;
+                count     = instruction.field == Field::IpAddress ? 2 : 1;
+                break;
+            case Field::IpProtocol:
+                valid     = summary.ipVersion != 0;
+                values[0] = summary.protocol;
+                break;
+            default:
+            {
+                const bool isTcp = instruction.field == Field::TcpSourcePort || instruction.field == Field::TcpDestinationPort ||
+                                   instruction.field == Field::TcpPort;
+                valid = summary.protocol == static_cast<uint8>(isTcp ? IP_Protocol::TCP : IP_Protocol::UDP);
+
+                const bool isDestination = instruction.field == Field::TcpDestinationPort || instruction.field == Field::UdpDestinationPort;
+                values[0]                = isDestination ? summary.destinationPort : summary.sourcePort;
+                values[1]                = summary.destinationPort;
+                count                    = (instruction.field == Field::TcpPort || instruction.field == Field::UdpPort) ? 2 : 1;
+                break;
+            }
+            }
+
+            bool result = false;
+            for (uint32 index = 0; valid && index < count && !result; index++)
+                result = Compare(instruction.comparison, values[index] & instruction.mask, instruction.value);
+            stack[top++] = result;
+            break;
+        }
+        case OpCode::HasIpVersion:
+            stack[top++] = summary.ipVersion == instruction.protocol;
+            break;
+        case OpCode::HasProtocol:
+            stack[top++] = summary.ipVersion != 0 && summary.protocol == instruction.protocol;
+            break;
+        case OpCode::And:
+            top--;
+            stack[top - 1] = stack[top - 1] && stack[top];
+            break;
+        case OpCode::Or:
+            top--;
+            stack[top - 1] = stack[top - 1] || stack[top];
+            break;
+        case OpCode::Not:
+            stack[top - 1] = !stack[top - 1];
+            break;
+        }
+    }
+
+    return top == 0 || stack[0];
+}
@@ -29,7 +29,7 @@ void Information::UpdateGeneralInformation()
     general->AddItem("Header").SetType(ListViewItem::Type::Category);
     UpdatePcapHeader();
 
-    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packetHeaders.size()).SetType(ListViewItem::Type::Emphasized_1);
+    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packets.size()).SetType(ListViewItem::Type::Emphasized_1);
 }
 
 void Information::UpdatePcapHeader()
@@ -1,5 +1,6 @@
 #include "PCAP.hpp"
 
+#include <chrono>
 #include <numeric>
 
 namespace GView::Type::PCAP::Panels
@@ -14,17 +15,22 @@ enum class ObjectAction : int32
     Select     = 2,
     ChangeBase = 4,
     OpenPacket = 8,
+    Filter     = 16,
 };
 
+constexpr int BUTTON_ID_FILTER_OK     = 1;
+constexpr int BUTTON_ID_FILTER_CANCEL = 2;
+
 Packets::Packets(Reference<PCAPFile> _pcap, Reference<GView::View::WindowInterface> _win) : TabPage("&Packets")
 {
     pcap = _pcap;
     win  = _win;
     Base = 16;
 
-    list = Factory::ListView::Create(
+    filterStatus = Factory::Label::Create(this, "Filter: none (Ctrl+F to change)", "l:0,t:0,r:0,h:1");
+    list         = Factory::ListView::Create(
           this,
-          "d:c",
+          "l:0,t:1,r:0,b:0",
           { "n:#,a:r,w:6",
             "n:Timestamp,a:r,w:20",
             "n:Seconds,a:r,w:16",
@@ -48,19 +54,17 @@ std::string_view Packets::GetValue(NumericFormatter& n, uint64 value)
 
 void Panels::Packets::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
+    auto record = list->GetCurrentItem().GetData<const PacketRecord>();
 
-    win->GetCurrentView()->GoTo(offset);
+    win->GetCurrentView()->GoTo(record->offset);
 }
 
 void Panels::Packets::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
-    const auto size   = record->first->inclLen + sizeof(PacketHeader);
+    auto record     = list->GetCurrentItem().GetData<const PacketRecord>();
+    const auto size = record->header.inclLen + sizeof(PacketHeader);
 
-    win->GetCurrentView()->Select(offset, size);
+    win->GetCurrentView()->Select(record->offset, size);
 }
 
 std::string_view Packets::PacketDialog::GetValue(NumericFormatter& n, uint64 value)
@@ -690,8 +694,10 @@ Panels::Packets::PacketDialog::PacketDialog(
 
 void Panels::Packets::OpenPacket()
 {
-    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto& packet = itemData->first;
+    auto record = list->GetCurrentItem().GetData<const PacketRecord>();
+    Buffer packetBuffer;
+    CHECKRET(pcap->GetPacket(*record, packetBuffer), "");
+    const auto packet = reinterpret_cast<const PacketHeader*>(packetBuffer.GetData());
 
     LocalString<128> ls;
     ls.Format("d:c,w:80,h:50", this->GetHeight());
@@ -699,6 +705,85 @@ void Panels::Packets::OpenPacket()
     dialog.Show();
 }
 
+Panels::Packets::FilterDialog::FilterDialog(std::string_view currentExpression)
+    : Window("Packet filter", "d:c,w:80,h:9", WindowFlags::ProcessReturn), expression(currentExpression)
+{
+    Factory::Label::Create(this, "Example: tcp.port == 443 && ip.src in 10.0.0.0/8 && len > 1000", "l:1,t:0,r:1,h:1");
+    input = Factory::TextField::Create(this, expression, "l:1,t:2,r:1", TextFieldFlags::None);
+    Factory::Button::Create(this, "&Apply", "l:20,b:0,w:15", BUTTON_ID_FILTER_OK);
+    Factory::Button::Create(this, "&Cancel", "l:42,b:0,w:15", BUTTON_ID_FILTER_CANCEL);
+    input->SetFocus();
+}
+
+bool Panels::Packets::FilterDialog::OnEvent(Reference<Control> ctrl, Event evnt, int controlID)
+{
+    if (evnt == Event::WindowAccept || (evnt == Event::ButtonClicked && controlID == BUTTON_ID_FILTER_OK))
+    {
+        input->GetText().ToString(expression);
+        Exit(AppCUI::Dialogs::Result::Ok);
+        return true;
+    }
+    if (evnt == Event::WindowClose || (evnt == Event::ButtonClicked && controlID == BUTTON_ID_FILTER_CANCEL))
+    {
+        Exit(AppCUI::Dialogs::Result::Cancel);
+        return true;
+    }
+    return Window::OnEvent(ctrl, evnt, controlID);
+}
+
+void Panels::Packets::ChangeFilter()
+{
+    FilterDialog dialog(filterText);
+    if (dialog.Show() != AppCUI::Dialogs::Result::Ok)
+        return;
+
+    PacketFilter newFilter;
+    if (!newFilter.Compile(dialog.GetExpression()))
+    {
+        AppCUI::Dialogs::MessageBox::ShowError("Invalid filter", newFilter.GetError());
+        return;
+    }
+
+    filter     = std::move(newFilter);
+    filterText = dialog.GetExpression();
+    ApplyFilter();
+    Update();
+}
+
+void Panels::Packets::ApplyFilter()
+{
+    // the summaries are built once, the first time a filter is used --> not part of the filter throughput
+    if (!filter.Empty() && !pcap->BuildPacketSummaries())
+    {
+        filterStatus->SetText("Filter: failed to evaluate");
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    if (!pcap->FilterPackets(filter, visiblePackets))
+    {
+        filterStatus->SetText("Filter: failed to evaluate");
+        return;
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (filter.Empty())
+    {
+        filterStatus->SetText("Filter: none (Ctrl+F to change)");
+        return;
+    }
+
+    LocalString<512> ls;
+    NumericFormatter n, n2, n3;
+    const auto rate = elapsed > 0 ? (uint64) (pcap->packets.size() / elapsed) : 0ULL;
+    ls.Format(
+          "Filter: %s -> %s of %s packets (%s packets/s)",
+          filterText.c_str(),
+          n.ToString((uint64) visiblePackets.size(), { NumericFormatFlags::None, 10, 3, ',' }).data(),
+          n2.ToString((uint64) pcap->packets.size(), { NumericFormatFlags::None, 10, 3, ',' }).data(),
+          n3.ToString(rate, { NumericFormatFlags::None, 10, 3, ',' }).data());
+    filterStatus->SetText(ls);
+}
+
 void Panels::Packets::Update()
 {
     list->DeleteAllItems();
@@ -706,24 +791,27 @@ void Panels::Packets::Update()
     LocalString<128> tmp;
     NumericFormatter n;
 
-    for (auto i = 0ULL; i < pcap->packetHeaders.size(); i++)
+    if (filter.Empty())
+        pcap->FilterPackets(filter, visiblePackets);
+
+    for (const auto i : visiblePackets)
     {
-        auto& record                 = pcap->packetHeaders[i];
-        const auto& [header, offset] = record;
+        auto& record       = pcap->packets[i];
+        const auto& header = record.header;
 
-        auto timestamp = header->tsSec * (uint64) 1000000 + header->tsUsec;
+        auto timestamp = header.tsSec * (uint64) 1000000 + header.tsUsec;
         timestamp /= 1000000;
         AppCUI::OS::DateTime dt;
         dt.CreateFromTimestamp(timestamp);
 
         auto item = list->AddItem({ tmp.Format("%s", GetValue(n, i).data()) });
         item.SetText(1, tmp.Format("%s", dt.GetStringRepresentation().data()));
-        item.SetText(2, tmp.Format("%s", GetValue(n, header->tsSec).data()));
-        item.SetText(3, tmp.Format("%s", GetValue(n, header->tsUsec).data()));
-        item.SetText(4, tmp.Format("%s", GetValue(n, header->inclLen).data()));
-        item.SetText(5, tmp.Format("%s", GetValue(n, header->origLen).data()));
+        item.SetText(2, tmp.Format("%s", GetValue(n, header.tsSec).data()));
+        item.SetText(3, tmp.Format("%s", GetValue(n, header.tsUsec).data()));
+        item.SetText(4, tmp.Format("%s", GetValue(n, header.inclLen).data()));
+        item.SetText(5, tmp.Format("%s", GetValue(n, header.origLen).data()));
 
-        item.SetData<std::pair<PacketHeader*, uint32>>(&record);
+        item.SetData<PacketRecord>(&record);
     }
 }
 
@@ -733,6 +821,7 @@ bool Panels::Packets::OnUpdateCommandBar(AppCUI::Application::CommandBar& comman
     commandBar.SetCommand(Key::F9, "Select", static_cast<int32_t>(ObjectAction::Select));
     commandBar.SetCommand(Key::F2, Base == 10 ? "Dec" : "Hex", static_cast<int32_t>(ObjectAction::ChangeBase));
     commandBar.SetCommand(Key::Ctrl | Key::Enter, "Open Packet", static_cast<int32_t>(ObjectAction::OpenPacket));
+    commandBar.SetCommand(Key::Ctrl | Key::F, "Filter", static_cast<int32_t>(ObjectAction::Filter));
 
     return true;
 }
@@ -764,6 +853,9 @@ bool Panels::Packets::OnEvent(Reference<Control> ctrl, Event evnt, int controlID
         case ObjectAction::OpenPacket:
             OpenPacket();
             return true;
+        case ObjectAction::Filter:
+            ChangeFilter();
+            return true;
         }
     }
 
@@ -28,18 +28,23 @@ void GetFileExtracted(StreamTcpLayer& output)
 PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformation& payloadInformation, ConnectionCallbackInterface* callbackInterface)
 {
     const auto connPayload = payloadInformation.payload;
-    if (payloadInformation.payload->size < 3)
+    if (connPayload->GetSize() < 3)
+        return nullptr;
+    uint8 start[3];
+    if (!connPayload->Copy(0, sizeof(start), start))
         return nullptr;
     for (int i = 0; i < 3; i++)
-        if (!isalpha(connPayload->location[i]))
+        if (!isalpha(start[i]))
             return nullptr;
 
     auto& applicationLayers = callbackInterface->GetApplicationLayers();
 
+    // the payload is scanned through a cursor, so HTTP messages can span multiple packets
+    StreamPayloadCursor cursor(*connPayload);
     uint8 buffer[300]     = {};
     uint32 bufferSize     = 0;
-    const uint8* startPtr = connPayload->location;
-    const uint8* endPtr   = connPayload->location + connPayload->size;
+    uint64 position       = 0;
+    const uint64 end      = connPayload->GetSize();
     bool wasEndline       = false;
     uint32 spaces         = 0;
 
@@ -47,18 +52,21 @@ PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformat
 
     StreamTcpLayer layer = {};
 
-    while (startPtr < endPtr) {
-        if (*startPtr == 0x0D || *startPtr == 0x0a) {
+    while (position < end) {
+        uint8 current;
+        if (!cursor.Get(position, current))
+            break;
+        if (current == 0x0D || current == 0x0a) {
             wasEndline = true;
             ++spaces;
         } else if (wasEndline) {
             if (spaces >= 4) {
                 if (identified) {
                     if (layer.payload.size) {
-                        layer.payload.location = (uint8*) startPtr;
+                        layer.payload.offset = position;
                         // push
 
-                        startPtr += layer.payload.size;
+                        position += layer.payload.size;
                         bufferSize         = 0;
                         buffer[bufferSize] = '\0';
                         identified         = false;
@@ -111,17 +119,17 @@ PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformat
 
             if (bufferSize >= maxWaitUntilEndLine - 1)
                 break;
-            buffer[bufferSize++] = *startPtr;
+            buffer[bufferSize++] = current;
         } else {
             if (bufferSize >= maxWaitUntilEndLine - 1)
                 return nullptr;
-            buffer[bufferSize++] = *startPtr;
+            buffer[bufferSize++] = current;
         }
 
-        startPtr++;
+        position++;
     }
 
-    if (startPtr >= endPtr) {
+    if (position >= end) {
         callbackInterface->AddConnectionAppLayerName("HTTP");
     }
 
@@ -1,31 +1,144 @@
 #include "StreamManager.hpp"
 #include "Utils.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace GView::Type::PCAP;
 
-void StreamData::ComputeFinalPayload()
+void StreamPayloadView::Init(GView::Utils::DataCache* cache, const std::vector<StreamPacketData>& packets)
 {
-    if (totalPayload == 0)
-        return;
+    data = cache;
+    size = 0;
+    segments.clear();
+    segmentStarts.clear();
 
-    uint8* payload = new uint8[totalPayload];
+    for (const auto& packet : packets)
+    {
+        if (packet.payload.size == 0)
+            continue;
+        // payloads that follow each other in the file are kept as a single segment
+        if (!segments.empty() && segments.back().offset + segments.back().size == packet.payload.offset &&
+            (uint64) segments.back().size + packet.payload.size <= 0xFFFFFFFFULL)
+        {
+            segments.back().size += packet.payload.size;
+        }
+        else
+        {
+            segments.push_back(packet.payload);
+            segmentStarts.push_back(size);
+        }
+        size += packet.payload.size;
+    }
+}
+
+bool StreamPayloadView::Copy(uint64 position, uint32 length, uint8* output) const
+{
+    CHECK(data, false, "");
+    CHECK(position <= size && length <= size - position, false, "");
+    if (length == 0)
+        return true;
 
-    auto payloadPtr = payload;
-    for (const auto& packet : packetsOffsets)
-        if (packet.payload.location)
+    // last segment that starts at or before position
+    auto index = (size_t) (std::upper_bound(segmentStarts.begin(), segmentStarts.end(), position) - segmentStarts.begin()) - 1;
+    while (length > 0)
+    {
+        const auto& segment = segments[index];
+        const auto inner    = position - segmentStarts[index];
+        const auto toCopy   = (uint32) std::min<uint64>(length, segment.size - inner);
+
+        uint32 copied = 0;
+        while (copied < toCopy)
         {
-            memcpy(payloadPtr, packet.payload.location, packet.payload.size);
-            payloadPtr += packet.payload.size;
+            const auto chunk = std::min<uint32>(toCopy - copied, data->GetCacheSize() >> 1);
+            const auto view  = data->Get(segment.offset + inner + copied, chunk, true);
+            CHECK(view.IsValid(), false, "");
+            memcpy(output, view.GetData(), chunk);
+            output += chunk;
+            copied += chunk;
         }
 
-    connPayload.size     = (uint32) totalPayload;
-    connPayload.location = payload;
+        position += toCopy;
+        length -= toCopy;
+        index++;
+    }
+    return true;
+}
+
+Buffer StreamPayloadView::CopyToBuffer(uint64 position, uint32 length) const
+{
+    if (position >= size)
+        return {};
+    length = (uint32) std::min<uint64>(length, size - position);
+
+    Buffer buffer{};
+    buffer.Resize(length);
+    CHECK(Copy(position, length, buffer.GetData()), Buffer(), "");
+    return buffer;
+}
+
+bool StreamPayloadCursor::Load(uint64 position)
+{
+    CHECK(position < view.GetSize(), false, "");
+    windowSize = (uint32) std::min<uint64>(WINDOW_SIZE, view.GetSize() - position);
+    if (window.GetLength() < WINDOW_SIZE)
+        window.Resize(WINDOW_SIZE);
+    windowStart = position;
+    if (!view.Copy(position, windowSize, window.GetData()))
+    {
+        windowSize = 0;
+        return false;
+    }
+    return true;
+}
+
+void StreamData::ComputeFinalPayload(GView::Utils::DataCache& data)
+{
+    // no copy is made here, the payload bytes are read when a parser or the user needs them
+    connPayload.Init(&data, packetsOffsets);
 
     //CallTransportLayerPlugins();
 }
 
-void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet)
+std::string StreamData::GetName() const
 {
+    LocalString<64> srcIp, dstIp;
+    switch (static_cast<EtherType>(ipProtocol))
+    {
+    case EtherType::IPv4:
+    {
+        uint32 source, destination;
+        memcpy(&source, endpoints.sourceAddress, sizeof(uint32));
+        memcpy(&destination, endpoints.destinationAddress, sizeof(uint32));
+        Utils::IPv4ElementToStringNoHex(source, srcIp);
+        Utils::IPv4ElementToStringNoHex(destination, dstIp);
+        break;
+    }
+    case EtherType::IPv6:
+        Utils::IPv6ElementToString(endpoints.sourceAddress, srcIp);
+        Utils::IPv6ElementToString(endpoints.destinationAddress, dstIp);
+        break;
+    default:
+        return "";
+    }
+
+    NumericFormatter n, n2;
+    LocalString<256> name;
+    name.Format(
+          "%s:%s -> %s:%s",
+          srcIp.GetText(),
+          n.ToString(endpoints.sourcePort, { NumericFormatFlags::None, 10, 3, '.' }).data(),
+          dstIp.GetText(),
+          n2.ToString(endpoints.destinationPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
+    return name.GetText();
+}
+
+bool StreamManager::Dissect_Package_EthernetHeader(DissectedPacket& result, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet)
+{
+    if (length < sizeof(Package_EthernetHeader))
+        return false;
+
     auto pehRef = *peh;
     Swap(pehRef);
 
@@ -33,34 +146,38 @@ void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Pac
     if (etherType == EtherType::IPv4)
     {
         auto ipv4 = (IPv4Header*) ((uint8*) peh + sizeof(Package_EthernetHeader));
-        packetData->linkLayer = { LinkType::IPV4, ipv4 };
-        Add_IPv4Header(packetData, ipv4, length - sizeof(Package_EthernetHeader), packet);
+        return Dissect_IPv4Header(result, ipv4, length - sizeof(Package_EthernetHeader), packet);
     }
-    else if (etherType == EtherType::IPv6)
+    if (etherType == EtherType::IPv6)
     {
         auto ipv6 = (IPv6Header*) ((uint8*) peh + sizeof(Package_EthernetHeader));
-        packetData->linkLayer = { LinkType::IPV6, ipv6 };
-        Add_IPv6Header(packetData, ipv6, length - sizeof(Package_EthernetHeader), packet);
+        return Dissect_IPv6Header(result, ipv6, length - sizeof(Package_EthernetHeader), packet);
     }
+    return false;
 }
 
-void StreamManager::Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet)
+bool StreamManager::Dissect_Package_NullHeader(DissectedPacket& result, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet)
 {
+    if (length < sizeof(Package_NullHeader))
+        return false;
+
     if (pnh->family_ip == NULL_FAMILY_IP)
     {
         auto ipv4 = (IPv4Header*) ((uint8*) pnh + sizeof(Package_NullHeader));
-        packetData->linkLayer = { LinkType::IPV4, ipv4 };
-        Add_IPv4Header(packetData, ipv4, length - sizeof(Package_NullHeader), packet);
+        return Dissect_IPv4Header(result, ipv4, length - sizeof(Package_NullHeader), packet);
     }
+    return false;
 }
 
-void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet)
+bool StreamManager::Dissect_IPv4Header(DissectedPacket& result, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet)
 {
+    if (packetInclLen < sizeof(IPv4Header))
+        return false;
+
     if (ipv4->protocol == IP_Protocol::TCP)
     {
         auto tcp = (TCPHeader*) ((uint8*) ipv4 + sizeof(IPv4Header));
-        packetData->transportLayer = { IP_Protocol::TCP, tcp };
-        Add_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv4Header), ipv4, static_cast<uint32>(EtherType::IPv4), packet);
+        return Dissect_TCPHeader(result, tcp, packetInclLen - sizeof(IPv4Header), ipv4, static_cast<uint32>(EtherType::IPv4), packet);
     }
     // TODO: add support for UDP streams
     /*else if (ipv4->protocol == IP_Protocol::UDP)
@@ -68,15 +185,18 @@ void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv
         auto udp = (UDPHeader*) ((uint8*) ipv4 + sizeof(IPv4Header), static_cast<uint32>(EtherType::IPv4));
         Add_UDPHeader(udp);
     }*/
+    return false;
 }
 
-void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet)
+bool StreamManager::Dissect_IPv6Header(DissectedPacket& result, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet)
 {
+    if (packetInclLen < sizeof(IPv6Header))
+        return false;
+
     if (ipv6->nextHeader == IP_Protocol::TCP)
     {
         auto tcp = (TCPHeader*) ((uint8*) ipv6 + sizeof(IPv4Header));
-        packetData->transportLayer = { IP_Protocol::TCP, tcp };
-        Add_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), packet);
+        return Dissect_TCPHeader(result, tcp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), packet);
     }
     // TODO: add support for UDP streams
     /*else if (ipv6->nextHeader == IP_Protocol::UDP)
@@ -84,47 +204,44 @@ void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv
         auto udp = (UDPHeader*) ((uint8*) ipv6 + sizeof(IPv6Header));
         Add_UDPHeader(udp);
     }*/
+    return false;
 }
 
-void StreamManager::Add_TCPHeader(
-      PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet)
+bool StreamManager::Dissect_TCPHeader(
+      DissectedPacket& result, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet)
 {
-    const auto etherProto = static_cast<EtherType>(ipProto);
-    LocalString<64> srcIp, dstIp, srcPort, dstPort;
-    NumericFormatter n;
-    switch (etherProto)
+    if (packetInclLen < sizeof(TCPHeader))
+        return false;
+
+    auto& key = result.key;
+    switch (static_cast<EtherType>(ipProto))
     {
     case EtherType::IPv4:
     {
         auto* ip = (const IPv4Header*) ipHeader;
 
-        auto ipv4Ref = *ip;
-        Swap(ipv4Ref);
-
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.sourceAddress, srcIp);
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.destinationAddress, dstIp);
+        const auto source      = AppCUI::Endian::BigToNative(ip->sourceAddress);
+        const auto destination = AppCUI::Endian::BigToNative(ip->destinationAddress);
+        memcpy(key.sourceAddress, &source, sizeof(uint32));
+        memcpy(key.destinationAddress, &destination, sizeof(uint32));
         break;
     }
     case EtherType::IPv6:
     {
         auto* ip = (const IPv6Header*) ipHeader;
 
-        auto ipv6Ref = *ip;
-        Swap(ipv6Ref);
-
-        Utils::IPv6ElementToString(ipv6Ref.sourceAddress, srcIp);
-        Utils::IPv6ElementToString(ipv6Ref.destinationAddress, dstIp);
+        for (uint8 i = 0U; i < 8; i++)
+        {
+            key.sourceAddress[i]      = AppCUI::Endian::BigToNative(ip->sourceAddress[i]);
+            key.destinationAddress[i] = AppCUI::Endian::BigToNative(ip->destinationAddress[i]);
+        }
         break;
     }
     default:
         // TODO: in the future add an error
-        return;
+        return false;
     }
 
-    const bool hasRstFlag = (tcp->flags & RST) > 0;
-    const bool hasFinFlag = (tcp->flags & FIN) > 0;
-    const bool hasSynFlag = (tcp->flags & SYN) > 0;
-
     auto tcpRef = *tcp;
     Swap(tcpRef);
 
@@ -132,71 +249,75 @@ void StreamManager::Add_TCPHeader(
     const uint32 options_len    = tcp_header_len - sizeof(TCPHeader);
 
     if (tcp_header_len < sizeof(TCPHeader))
-        return; // err: TODO improve this later
+        return false; // err: TODO improve this later
 
-    StreamPayload payload{};
     if (packetInclLen > tcp_header_len)
     {
-        payload.size     = static_cast<uint32>(packetInclLen) - tcp_header_len;
-        payload.location = ((uint8*) tcp + sizeof(TCPHeader) + options_len);
+        result.payload.size   = static_cast<uint32>(packetInclLen) - tcp_header_len;
+        result.payload.offset = result.packetOffset + (((uint8*) tcp + sizeof(TCPHeader) + options_len) - (uint8*) packet);
     }
 
-    srcPort.Format("%s", n.ToString(tcpRef.sPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
-    dstPort.Format("%s", n.ToString(tcpRef.dPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
+    key.sourcePort        = tcpRef.sPort;
+    key.destinationPort   = tcpRef.dPort;
+    key.ipProtocol        = (uint16) ipProto;
+    key.transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
 
-    StreamData* streamToAddTo = nullptr;
+    result.seqNumber = tcp->seq;
+    result.ackNumber = tcp->ack;
+    result.tcpFlags  = tcp->flags;
+    return true;
+}
 
-    LocalString<256> streamName;
-    streamName.Format("%s:%s -> %s:%s", dstIp.GetText(), dstPort.GetText(), srcIp.GetText(), srcPort.GetText());
-    auto revStream = streams.find(streamName.GetText());
-    if (revStream != streams.end())
+bool StreamManager::DissectPacket(const PacketHeader* packet, LinkType network, DissectedPacket& result)
+{
+    if (network == LinkType::ETHERNET)
     {
-        if (!revStream->second.back().isFinished)
-            streamToAddTo = &revStream->second.back();
-        else
-        {
-            revStream->second.emplace_back();
-            streamToAddTo                    = &revStream->second.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
+        auto peh = (Package_EthernetHeader*) ((uint8*) packet + sizeof(PacketHeader));
+        return Dissect_Package_EthernetHeader(result, peh, packet->inclLen, packet);
     }
-    else
+    if (network == LinkType::NULL_)
     {
-        const auto name     = streamName.Format("%s:%s -> %s:%s", srcIp.GetText(), srcPort.GetText(), dstIp.GetText(), dstPort.GetText());
-        auto& currentStream = streams[name.data()];
-        if (currentStream.empty())
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
-        streamToAddTo = &currentStream.back();
-        if (streamToAddTo->isFinished)
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
+        auto pnh = (Package_NullHeader*) ((uint8*) packet + sizeof(PacketHeader));
+        return Dissect_Package_NullHeader(result, pnh, packet->inclLen, packet);
     }
+    return false;
+}
 
-    if (hasRstFlag)
+void StreamManager::AddDissectedPacket(FlowTable& table, const DissectedPacket& packet)
+{
+    // both directions of a connection share the normalized key
+    const auto [flow, isNewFlow] = table.indexes.try_emplace(packet.key.Normalized(), (uint32) table.flows.size());
+    if (isNewFlow)
+    {
+        table.flows.emplace_back();
+        table.firstPackets.push_back(packet.index);
+    }
+
+    auto& connections = table.flows[flow->second];
+    if (connections.empty() || connections.back().isFinished)
+    {
+        auto& connection             = connections.emplace_back();
+        connection.endpoints         = connections.size() > 1 ? connections.front().endpoints : packet.key;
+        connection.ipProtocol        = packet.key.ipProtocol;
+        connection.transportProtocol = packet.key.transportProtocol;
+    }
+    StreamData* streamToAddTo = &connections.back();
+
+    if ((packet.tcpFlags & RST) > 0)
         streamToAddTo->isFinished = true;
-    if (hasFinFlag)
+    if ((packet.tcpFlags & FIN) > 0)
         ++streamToAddTo->finFlagsFound;
-    if (hasSynFlag && streamToAddTo->finFlagsFound >= 2)
+    if ((packet.tcpFlags & SYN) > 0 && streamToAddTo->finFlagsFound >= 2)
         streamToAddTo->isFinished = true;
 
     StreamTCPOrder order{};
-    order.seqNumber   = tcp->seq;
-    order.ackNumber   = tcp->ack;
-    order.maxNumber   = std::max(tcp->seq, tcp->ack);
+    order.seqNumber   = packet.seqNumber;
+    order.ackNumber   = packet.ackNumber;
+    order.maxNumber   = std::max(packet.seqNumber, packet.ackNumber);
     order.packetIndex = (uint32) streamToAddTo->packetsOffsets.size();
 
-    streamToAddTo->totalPayload += payload.size;
-    streamToAddTo->packetsOffsets.push_back({ packet, payload, order, *packetData });
+    streamToAddTo->totalPayload += packet.payload.size;
+    streamToAddTo->packetsOffsets.push_back({ packet.packetOffset, packet.payload, order });
 }
 
 void StreamManager::AddToKnownProtocols(const std::string& layerName)
@@ -209,21 +330,165 @@ void StreamManager::AddToKnownProtocols(const std::string& layerName)
     protocolsFound.push_back(layerName);
 }
 
-void StreamManager::AddPacket(const PacketHeader* packet, LinkType network)
+constexpr uint32 DISSECT_READ_SIZE = 4 * 1024 * 1024;
+
+bool PacketFileReader::Open(const std::filesystem::path& path)
 {
-    PacketData packetData = {};
-    packetData.packet     = packet;
-    if (network == LinkType::ETHERNET)
+    return file.OpenRead(path);
+}
+
+const PacketHeader* PacketFileReader::Get(const PacketRecord& record)
+{
+    const uint32 size = sizeof(PacketHeader) + record.header.inclLen;
+    if (record.offset < chunkStart || record.offset + size > chunkStart + chunkSize)
     {
-        auto peh = (Package_EthernetHeader*) ((uint8*) packet + sizeof(PacketHeader));
-        packetData.physicalLayer = { LinkType::ETHERNET, peh };
-        Add_Package_EthernetHeader(&packetData, peh, packet->inclLen, packet);
+        const uint32 toRead = std::max<uint32>(size, DISSECT_READ_SIZE);
+        if (chunk.GetLength() < toRead)
+            chunk.Resize(toRead);
+
+        uint32 bytesRead = 0;
+        CHECK(file.SetCurrentPos(record.offset), nullptr, "");
+        CHECK(file.ReadBuffer(chunk.GetData(), toRead, bytesRead) || bytesRead > 0, nullptr, "");
+        chunkStart = record.offset;
+        chunkSize  = bytesRead;
+        CHECK(size <= chunkSize, nullptr, "");
     }
-    if (network == LinkType::NULL_)
+    return reinterpret_cast<const PacketHeader*>(chunk.GetData() + (record.offset - chunkStart));
+}
+
+uint32 PacketFileReader::GetWorkersCount(Reference<GView::Object> object, uint32 packetsCount)
+{
+    // workers read the packets through their own file handle --> anything that is not a file is processed on the calling thread,
+    // and so is a file object that is only a part of the file at its path (an entry opened from an archive)
+    if (object->GetObjectType() != GView::Object::Type::File)
+        return 1;
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(std::filesystem::path(object->GetPath()), ec);
+    if (ec || fileSize != object->GetData().GetSize())
+        return 1;
+    return std::clamp<uint32>(packetsCount / MIN_PACKETS_PER_WORKER, 1, std::max<uint32>(std::thread::hardware_concurrency(), 1));
+}
+
+void StreamManager::AddPackets(Reference<GView::Object> object, const std::vector<PacketRecord>& packets, LinkType network)
+{
+    const auto packetsCount   = (uint32) packets.size();
+    const uint32 workersCount = PacketFileReader::GetWorkersCount(object, packetsCount);
+
+    // returns false if a packet could not be read
+    const auto dissect = [&](auto& reader, uint32 start, uint32 end, auto&& output) {
+        for (uint32 index = start; index < end; index++)
+        {
+            const auto packet = reader(packets[index]);
+            if (!packet)
+                return false;
+
+            DissectedPacket result{};
+            result.index        = index;
+            result.packetOffset = packets[index].offset;
+            if (DissectPacket(packet, network, result))
+            {
+                result.flowHash = FlowKeyHash{}(result.key.Normalized());
+                output(result);
+            }
+        }
+        return true;
+    };
+
+    const auto addSerially = [&]() {
+        auto& data       = object->GetData();
+        Buffer large;
+        auto cacheReader = [&](const PacketRecord& record) -> const PacketHeader* {
+            const uint32 size = sizeof(PacketHeader) + record.header.inclLen;
+            if (size > data.GetCacheSize())
+            {
+                large = data.CopyToBuffer(record.offset, size);
+                return large.IsValid() ? reinterpret_cast<const PacketHeader*>(large.GetData()) : nullptr;
+            }
+            const auto view = data.Get(record.offset, size, true);
+            return view.IsValid() ? reinterpret_cast<const PacketHeader*>(view.GetData()) : nullptr;
+        };
+
+        // a packet that can not be read is skipped, the ones after it are still processed
+        for (uint32 index = 0; index < packetsCount; index++)
+            dissect(cacheReader, index, index + 1, [this](const DissectedPacket& packet) { AddDissectedPacket(flowTable, packet); });
+    };
+
+    if (workersCount == 1)
     {
-        auto pnh = (Package_NullHeader*) ((uint8*) packet + sizeof(PacketHeader));
-        packetData.physicalLayer = { LinkType::NULL_, pnh };
-        Add_Package_NullHeader(&packetData, pnh, packet->inclLen, packet);
+        addSerially();
+        return;
+    }
+
+    // stage 1: every worker dissects a contiguous range of packets and buckets them by the shard of their flow
+    const std::filesystem::path path(object->GetPath());
+    std::vector<std::vector<std::vector<DissectedPacket>>> buckets(workersCount, std::vector<std::vector<DissectedPacket>>(workersCount));
+    std::atomic<bool> failed{ false };
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(workersCount);
+        for (uint32 worker = 0; worker < workersCount; worker++)
+        {
+            threads.emplace_back([&, worker]() {
+                PacketFileReader fileReader;
+                if (!fileReader.Open(path))
+                {
+                    failed = true;
+                    return;
+                }
+                auto reader  = [&fileReader](const PacketRecord& record) { return fileReader.Get(record); };
+                auto& shards = buckets[worker];
+                auto output  = [&shards, workersCount](const DissectedPacket& packet) { shards[packet.flowHash % workersCount].push_back(packet); };
+                if (!dissect(reader, (uint32) ((uint64) packetsCount * worker / workersCount), (uint32) ((uint64) packetsCount * (worker + 1) / workersCount), output))
+                    failed = true;
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // a worker could not read its packets through its own handle --> redo everything through the object's cache
+    if (failed)
+    {
+        addSerially();
+        return;
+    }
+
+    // stage 2: flows are sharded by their hash; the ranges are consecutive, so each shard sees its packets in capture order
+    std::vector<FlowTable> shards(workersCount);
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(workersCount);
+        for (uint32 shard = 0; shard < workersCount; shard++)
+        {
+            threads.emplace_back([&, shard]() {
+                for (uint32 worker = 0; worker < workersCount; worker++)
+                    for (const auto& packet : buckets[worker][shard])
+                        AddDissectedPacket(shards[shard], packet);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    // merge the shards in the order the flows first appeared --> same result as the serial processing
+    struct MergeEntry
+    {
+        uint32 firstPacket;
+        uint32 shard;
+        uint32 flow;
+    };
+    std::vector<MergeEntry> entries;
+    for (uint32 shard = 0; shard < workersCount; shard++)
+        for (uint32 flow = 0; flow < (uint32) shards[shard].flows.size(); flow++)
+            entries.push_back({ shards[shard].firstPackets[flow], shard, flow });
+    std::sort(entries.begin(), entries.end(), [](const MergeEntry& a, const MergeEntry& b) { return a.firstPacket < b.firstPacket; });
+
+    for (const auto& entry : entries)
+    {
+        auto& connections = shards[entry.shard].flows[entry.flow];
+        flowTable.indexes.try_emplace(connections.front().endpoints.Normalized(), (uint32) flowTable.flows.size());
+        flowTable.firstPackets.push_back(entry.firstPacket);
+        flowTable.flows.emplace_back(std::move(connections));
     }
 }
 
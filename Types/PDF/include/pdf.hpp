@@ -8,6 +8,12 @@
 
 #include "GView.hpp"
 
+#include <array>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace GView
 {
 namespace Type
@@ -380,6 +386,240 @@ namespace Type
 
 #pragma pack(pop) // Back to default packing
 
+        namespace CHAR_CLASS // character classes (PDF 32000-1:2008, 7.2.2)
+        {
+            constexpr uint8 WHITESPACE = 0x01;
+            constexpr uint8 DELIMITER  = 0x02;
+            constexpr uint8 DIGIT      = 0x04;
+            constexpr uint8 HEX_DIGIT  = 0x08;
+            constexpr uint8 NUMERIC    = 0x10; // digits, signs and the decimal point
+        } // namespace CHAR_CLASS
+
+        inline constexpr auto CHAR_CLASSES = []() {
+            std::array<uint8, 256> table{};
+            for (const uint8 ch : { 0x00, 0x09, 0x0A, 0x0C, 0x0D, 0x20 }) {
+                table[ch] |= CHAR_CLASS::WHITESPACE;
+            }
+            for (const uint8 ch : { '(', ')', '<', '>', '[', ']', '{', '}', '/', '%' }) {
+                table[ch] |= CHAR_CLASS::DELIMITER;
+            }
+            for (uint32 ch = '0'; ch <= '9'; ch++) {
+                table[ch] |= CHAR_CLASS::DIGIT | CHAR_CLASS::HEX_DIGIT | CHAR_CLASS::NUMERIC;
+            }
+            for (uint32 ch = 0; ch < 6; ch++) {
+                table['a' + ch] |= CHAR_CLASS::HEX_DIGIT;
+                table['A' + ch] |= CHAR_CLASS::HEX_DIGIT;
+            }
+            for (const uint8 ch : { '+', '-', '.' }) {
+                table[ch] |= CHAR_CLASS::NUMERIC;
+            }
+            return table;
+        }();
+
+        inline bool IsCharClass(uint8 ch, uint8 charClass)
+        {
+            return (CHAR_CLASSES[ch] & charClass) != 0;
+        }
+
+        // random access reads that go through a private window of the file; the window is refilled from the
+        // DataCache only when a read falls outside of it, so scanning byte by byte costs an index per byte
+        class DataReader
+        {
+            GView::Utils::DataCache& cache;
+            Buffer window;
+            uint64 windowStart;
+            uint32 windowLength;
+
+            bool Fill(uint64 offset, uint32 size);
+
+          public:
+            static constexpr uint32 WINDOW_SIZE = 0x10000;
+
+            DataReader(GView::Utils::DataCache& cache);
+
+            inline bool Copy(uint64 offset, uint8& value)
+            {
+                // offsets before the window wrap around and fail the comparison as well
+                if (offset - windowStart < windowLength || Fill(offset, 1)) {
+                    value = window[(uint32) (offset - windowStart)];
+                    return true;
+                }
+                return false;
+            }
+            template <typename T>
+            inline bool Copy(uint64 offset, T& object)
+            {
+                if ((offset - windowStart < windowLength && offset - windowStart + sizeof(T) <= windowLength) || Fill(offset, sizeof(T))) {
+                    memcpy(&object, window.GetData() + (offset - windowStart), sizeof(T));
+                    return true;
+                }
+                return false;
+            }
+            // true if the bytes at offset are exactly the `size` bytes of pattern
+            bool Matches(uint64 offset, const uint8* pattern, uint32 size);
+
+            inline uint64 GetSize() const
+            {
+                return cache.GetSize();
+            }
+            inline GView::Utils::DataCache& GetCache()
+            {
+                return cache;
+            }
+        };
+
+        enum class TokenType : uint8 {
+            None,
+            Name,
+            Number,
+            LiteralString,
+            HexString,
+            DictionaryStart,
+            DictionaryEnd,
+            ArrayStart,
+            ArrayEnd,
+            Keyword, // obj, endobj, stream, R, true, false, null, ...
+            Comment,
+            Other,   // a delimiter that can not start a token ('{', '}', an unmatched ')' or '>')
+        };
+
+        struct Token {
+            TokenType type;
+            uint64 start;
+            uint64 end; // first byte after the token
+        };
+
+        // splits [start, end) into PDF tokens; whitespaces are skipped and the stream data is not (see SkipStream)
+        class Tokenizer
+        {
+            DataReader& reader;
+            uint64 position;
+            uint64 end;
+
+          public:
+            Tokenizer(DataReader& reader, uint64 start, uint64 end);
+
+            bool Next(Token& token);
+            bool IsKeyword(const Token& token, const uint8* keyword, uint32 size);
+            // value of a Number token (the integer part), 0 if it does not fit
+            uint64 GetNumber(const Token& token);
+            std::string GetName(const Token& token);
+
+            inline uint64 GetPosition() const
+            {
+                return position;
+            }
+            inline void SetPosition(uint64 value)
+            {
+                position = value;
+            }
+        };
+
+        // references found while parsing an object, kept in the order they were found and without duplicates
+        class ObjectReferences
+        {
+            std::vector<ObjectNums> references;
+            std::unordered_set<ObjectNums, ObjectNumsHash> known;
+
+          public:
+            // returns false if the reference was already added
+            bool Add(const ObjectNums& reference)
+            {
+                if (!known.insert(reference).second) {
+                    return false;
+                }
+                references.push_back(reference);
+                return true;
+            }
+            std::vector<ObjectNums>::const_iterator begin() const
+            {
+                return references.begin();
+            }
+            std::vector<ObjectNums>::const_iterator end() const
+            {
+                return references.end();
+            }
+        };
+
+        // objects of the file: appended in O(1) while parsing, sorted by offset once (Finalize) and indexed by (number, generation)
+        class ObjectTable
+        {
+            std::vector<PDFObject> objects;
+            std::unordered_map<ObjectNums, uint32, ObjectNumsHash> firstIndex; // (number, generation) -> first object (by offset)
+            std::vector<uint32> nextIndex;                                     // next object with the same (number, generation)
+
+          public:
+            static constexpr uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+            void Add(const PDFObject& object)
+            {
+                objects.push_back(object);
+            }
+            void Finalize();
+
+            // index of the first object (by offset) with the given number and generation or INVALID_INDEX
+            uint32 FindIndex(uint64 number, uint16 generation) const;
+            // index of the next object with the same number and generation or INVALID_INDEX
+            uint32 GetNextIndex(uint32 index) const
+            {
+                return index < nextIndex.size() ? nextIndex[index] : INVALID_INDEX;
+            }
+            PDFObject* Find(uint64 number, uint16 generation, uint64 startBuffer);
+
+            PDFObject& operator[](uint32 index)
+            {
+                return objects[index];
+            }
+            size_t size() const
+            {
+                return objects.size();
+            }
+            std::vector<PDFObject>::iterator begin()
+            {
+                return objects.begin();
+            }
+            std::vector<PDFObject>::iterator end()
+            {
+                return objects.end();
+            }
+            std::vector<PDFObject>::const_iterator begin() const
+            {
+                return objects.begin();
+            }
+            std::vector<PDFObject>::const_iterator end() const
+            {
+                return objects.end();
+            }
+        };
+
+        // decoded stream data, keyed by (object number, generation) and bounded by the total size of the buffers;
+        // the least recently used streams are dropped first
+        class DecodedStreamsCache
+        {
+            struct Entry {
+                ObjectNums key;
+                Buffer data;
+            };
+            std::list<Entry> entries; // most recently used first
+            std::unordered_map<ObjectNums, std::list<Entry>::iterator, ObjectNumsHash> index;
+            uint64 cachedSize;
+            uint64 maxCachedSize;
+            std::mutex lock;
+
+          public:
+            static constexpr uint64 DEFAULT_MAX_SIZE = 256ULL * 1024 * 1024;
+
+            DecodedStreamsCache(uint64 maxCachedSize = DEFAULT_MAX_SIZE);
+
+            bool Contains(const ObjectNums& key);
+            bool Get(const ObjectNums& key, Buffer& output);
+            void Put(const ObjectNums& key, const Buffer& data);
+            // adds data only if it fits without evicting anything
+            bool PutIfFits(const ObjectNums& key, const Buffer& data);
+            bool IsFull();
+            void Clear();
+        };
+
         class PDFFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
         {
           public:
@@ -392,8 +632,8 @@ namespace Type
             std::u16string currentPath;
             uint32 currentItemIndex = 0;
             std::vector<PDF::ObjectNode*> currentChildNodes;
-            std::vector<PDFObject> pdfObjects;
-            std::vector<PDF::ObjectNums> processedObjects;
+            ObjectTable pdfObjects;
+            std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash> processedObjects;
             Reference<GView::Utils::SelectionZoneInterface> selectionZoneInterface;
             PDFStats pdfStats;
             MalformedStats malformedStats;
@@ -401,6 +641,7 @@ namespace Type
             Metadata pdfMetadata;
             std::vector<PDF::ObjectNums> metadataObjectNumbers;
             GView::Utils::ErrorList errList;
+            DecodedStreamsCache decodedStreams;
 
           public:
             PDFFile();
@@ -425,7 +666,13 @@ namespace Type
 
             // View::ContainerViewer::OpenItemInterface
             virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
-            void DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size);
+            // runs the filters of the stream over buffer (does not touch the UI, so it can be called from any thread)
+            bool DecodeStream(const DecodeObjects& decodeObj, Buffer& buffer, const size_t size, String& message);
+            // the decoded data of the stream of node (from the cache if it was already decoded)
+            bool GetDecodedStream(const ObjectNode* node, Buffer& output, String& message);
+            // decodes the streams of the document on worker threads until the cache is full (image codecs are left for on demand);
+            // returns the number of streams that were decoded
+            uint32 DecodeAllStreams();
 
             uint32 GetSelectionZonesCount() override
             {
@@ -479,6 +726,7 @@ namespace Type
                 std::string_view GetValue(NumericFormatter& n, uint32 value);
                 void GoToSelectedSection();
                 void SelectCurrentSection();
+                void DecodeStreams();
 
               public:
                 Sections(Reference<GView::Type::PDF::PDFFile> pdf, Reference<GView::View::WindowInterface> win);
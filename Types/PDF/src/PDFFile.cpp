@@ -2,6 +2,8 @@
 #include <nlohmann/json.hpp>
 #include <regex>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 using nlohmann::json;
 
 using namespace GView::Type::PDF;
@@ -34,10 +36,43 @@ bool PDFFile::Update()
 
 void PDFFile::AddPDFObject(Reference<GView::Type::PDF::PDFFile> pdf, const PDFObject& obj)
 {
-    auto it = std::lower_bound(
-          pdf->pdfObjects.begin(), pdf->pdfObjects.end(), obj, [](const PDFObject& a, const PDFObject& b) { return a.startBuffer < b.startBuffer; });
+    pdf->pdfObjects.Add(obj);
+}
+
+void ObjectTable::Finalize()
+{
+    std::stable_sort(objects.begin(), objects.end(), [](const PDFObject& a, const PDFObject& b) { return a.startBuffer < b.startBuffer; });
+
+    firstIndex.clear();
+    firstIndex.reserve(objects.size());
+    nextIndex.assign(objects.size(), INVALID_INDEX);
+
+    // walk backwards so that every chain starts with the object that has the smallest offset
+    for (auto index = (uint32) objects.size(); index > 0; index--) {
+        const auto current = index - 1;
+        const ObjectNums key{ objects[current].number, objects[current].generation };
+        auto [it, inserted] = firstIndex.try_emplace(key, current);
+        if (!inserted) {
+            nextIndex[current] = it->second;
+            it->second         = current;
+        }
+    }
+}
+
+uint32 ObjectTable::FindIndex(uint64 number, uint16 generation) const
+{
+    const auto it = firstIndex.find(ObjectNums{ number, generation });
+    return it != firstIndex.end() ? it->second : INVALID_INDEX;
+}
 
-    pdf->pdfObjects.insert(it, obj);
+PDFObject* ObjectTable::Find(uint64 number, uint16 generation, uint64 startBuffer)
+{
+    for (auto index = FindIndex(number, generation); index != INVALID_INDEX; index = nextIndex[index]) {
+        if (objects[index].startBuffer == startBuffer) {
+            return &objects[index];
+        }
+    }
+    return nullptr;
 }
 
 bool PDFFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
@@ -192,127 +227,246 @@ static bool IsValidXML(const std::vector<std::string>& dictionarySubtypes)
     return std::find(dictionarySubtypes.begin(), dictionarySubtypes.end(), KEY::PDF_XML) != dictionarySubtypes.end();
 }
 
-void PDFFile::DecodeStream(ObjectNode* node, Buffer& buffer, const size_t size)
+bool PDFFile::DecodeStream(const DecodeObjects& decodeObj, Buffer& buffer, const size_t size, String& message)
 {
     // decompress the stream
     // /DCTDecode -> LoadJPGToImage from JPG
-    if (!node->decodeObj.filters.empty()) {
-        for (const auto& filter : node->decodeObj.filters) {
-            if (filter == PDF::FILTER::FLATE) {
-                Buffer decompressedData;
-                uint64 decompressDataSize = size;
-                String message;
-                if (GView::Decoding::ZLIB::DecompressStream(buffer, decompressedData, message, decompressDataSize)) {
-                    if (node->decodeObj.decodeParams.predictor != 1) {
-                        ApplyPNGFilter(
-                              decompressedData,
-                              node->decodeObj.decodeParams.column,
-                              node->decodeObj.decodeParams.predictor,
-                              node->decodeObj.decodeParams.bitsPerComponent);
-                        decompressDataSize = decompressedData.GetLength();
-                    }
-                    buffer = decompressedData;
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::RUNLENGTH) {
-                Buffer runLengthDecompressed;
-                String message;
-                if (RunLengthDecode(buffer, runLengthDecompressed, message)) {
-                    buffer = runLengthDecompressed;
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::ASCIIHEX) {
-                String message;
-                Buffer asciiHexDecompressed;
-                if (ASCIIHexDecode(buffer, asciiHexDecompressed, message)) {
-                    if (message.Len()) {
-                        Dialogs::MessageBox::ShowWarning("Warning!", message);
-                    }
-                    buffer = asciiHexDecompressed;
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::ASCII85) {
-                String message;
-                Buffer ascii85Decompressed;
-                if (ASCII85Decode(buffer, ascii85Decompressed, message)) {
-                    if (message.Len()) {
-                        Dialogs::MessageBox::ShowWarning("Warning!", message);
-                    }
-                    buffer = ascii85Decompressed;
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::JPX) {
-                // this one has to be a separate plugin for JPEG2000
-                // for the moment being you can only see the decompressed data
-                Buffer jpxDecompressed;
-                uint32_t width = 0, height = 0;
-                uint8_t components = 0;
-                String message;
-                if (JPXDecode(buffer, jpxDecompressed, width, height, components, message)) {
-                    buffer = jpxDecompressed;
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::LZW) {
-                Buffer lzwDecompressed;
-                String message;
-                if (LZWDecodeStream(buffer, lzwDecompressed, node->decodeObj.decodeParams.earlyChange, message)) {
-                    if (node->decodeObj.decodeParams.predictor != 1) {
-                        ApplyPNGFilter(
-                              lzwDecompressed,
-                              node->decodeObj.decodeParams.column,
-                              node->decodeObj.decodeParams.predictor,
-                              node->decodeObj.decodeParams.bitsPerComponent);
-                    }
-                    buffer = std::move(lzwDecompressed);
-                } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
-                }
-            } else if (filter == PDF::FILTER::JBIG2) {
-                Buffer jbig2Decompressed;
-                String message;
-                if (JBIG2Decode(buffer, jbig2Decompressed, message)) {
-                    buffer = std::move(jbig2Decompressed);
+    for (const auto& filter : decodeObj.filters) {
+        if (filter == PDF::FILTER::FLATE) {
+            Buffer decompressedData;
+            uint64 decompressDataSize = size;
+            CHECK(GView::Decoding::ZLIB::DecompressStream(buffer, decompressedData, message, decompressDataSize), false, "");
+            if (decodeObj.decodeParams.predictor != 1) {
+                ApplyPNGFilter(decompressedData, decodeObj.decodeParams.column, decodeObj.decodeParams.predictor, decodeObj.decodeParams.bitsPerComponent);
+            }
+            buffer = std::move(decompressedData);
+        } else if (filter == PDF::FILTER::RUNLENGTH) {
+            Buffer runLengthDecompressed;
+            CHECK(RunLengthDecode(buffer, runLengthDecompressed, message), false, "");
+            buffer = std::move(runLengthDecompressed);
+        } else if (filter == PDF::FILTER::ASCIIHEX) {
+            // a message without a failure is a warning about the input
+            Buffer asciiHexDecompressed;
+            CHECK(ASCIIHexDecode(buffer, asciiHexDecompressed, message), false, "");
+            buffer = std::move(asciiHexDecompressed);
+        } else if (filter == PDF::FILTER::ASCII85) {
+            Buffer ascii85Decompressed;
+            CHECK(ASCII85Decode(buffer, ascii85Decompressed, message), false, "");
+            buffer = std::move(ascii85Decompressed);
+        } else if (filter == PDF::FILTER::JPX) {
+            // this one has to be a separate plugin for JPEG2000
+            // for the moment being you can only see the decompressed data
+            Buffer jpxDecompressed;
+            uint32_t width = 0, height = 0;
+            uint8_t components = 0;
+            CHECK(JPXDecode(buffer, jpxDecompressed, width, height, components, message), false, "");
+            buffer = std::move(jpxDecompressed);
+        } else if (filter == PDF::FILTER::LZW) {
+            Buffer lzwDecompressed;
+            CHECK(LZWDecodeStream(buffer, lzwDecompressed, decodeObj.decodeParams.earlyChange, message), false, "");
+            if (decodeObj.decodeParams.predictor != 1) {
+                ApplyPNGFilter(lzwDecompressed, decodeObj.decodeParams.column, decodeObj.decodeParams.predictor, decodeObj.decodeParams.bitsPerComponent);
+            }
+            buffer = std::move(lzwDecompressed);
+        } else if (filter == PDF::FILTER::JBIG2) {
+            Buffer jbig2Decompressed;
+            CHECK(JBIG2Decode(buffer, jbig2Decompressed, message), false, "");
+            buffer = std::move(jbig2Decompressed);
+        }
+    }
+    return true;
+}
+
+bool PDFFile::GetDecodedStream(const ObjectNode* node, Buffer& output, String& message)
+{
+    CHECK(node->pdfObject.hasStream, false, "");
+    const ObjectNums key{ node->pdfObject.number, node->pdfObject.generation };
+    if (decodedStreams.Get(key, output)) {
+        return true;
+    }
+
+    const uint64 start = node->decodeObj.streamOffsetStart;
+    const uint64 end   = node->decodeObj.streamOffsetEnd;
+    CHECK(end > start && end - start <= 0xFFFFFFFF, false, "");
+
+    const auto size = static_cast<size_t>(end - start);
+    output          = this->obj->GetData().CopyToBuffer(start, static_cast<uint32>(size));
+    CHECK(output.IsValid(), false, "");
+
+    // encrypted streams can not be decoded (yet) -> the raw data is all we have
+    if (pdfStats.isEncrypted) {
+        return true;
+    }
+    CHECK(DecodeStream(node->decodeObj, output, size, message), false, "");
+    decodedStreams.Put(key, output);
+    return true;
+}
+
+uint32 PDFFile::DecodeAllStreams()
+{
+    CHECK(!pdfStats.isEncrypted, 0, "");
+
+    // the same object can be a child of several nodes -> decode each stream once
+    std::vector<const ObjectNode*> nodes;
+    std::unordered_set<ObjectNums, ObjectNumsHash> seen;
+    std::vector<const ObjectNode*> stack{ &objectNodeRoot };
+    while (!stack.empty()) {
+        const auto* node = stack.back();
+        stack.pop_back();
+        // JPEG2000 and JBIG2 images are slow to decode and rarely needed -> only when the object is opened
+        const auto& filters = node->decodeObj.filters;
+        const bool isImage  = std::find(filters.begin(), filters.end(), PDF::FILTER::JPX) != filters.end() ||
+                             std::find(filters.begin(), filters.end(), PDF::FILTER::JBIG2) != filters.end();
+        if (node->pdfObject.hasStream && !isImage && node->decodeObj.streamOffsetEnd > node->decodeObj.streamOffsetStart &&
+            seen.insert(ObjectNums{ node->pdfObject.number, node->pdfObject.generation }).second) {
+            nodes.push_back(node);
+        }
+        for (const auto& child : node->children) {
+            stack.push_back(&child);
+        }
+    }
+    CHECK(!nodes.empty(), 0, "");
+
+    // the DataCache is not thread safe: workers take turns reading the raw data and decode it in parallel
+    std::mutex readLock;
+    std::atomic<size_t> nextNode{ 0 };
+    std::atomic<uint32> decoded{ 0 };
+    std::atomic<bool> full{ false };
+    std::vector<std::string> errors(nodes.size());
+    const auto workersCount = std::clamp<uint32>((uint32) nodes.size(), 1, std::max<uint32>(std::thread::hardware_concurrency(), 1));
+
+    auto worker = [&]() {
+        // once the cache is full, anything decoded would only evict streams decoded earlier
+        for (auto i = nextNode++; i < nodes.size() && !full; i = nextNode++) {
+            const auto* node   = nodes[i];
+            const ObjectNums key{ node->pdfObject.number, node->pdfObject.generation };
+            const uint64 start = node->decodeObj.streamOffsetStart;
+            const uint64 size  = node->decodeObj.streamOffsetEnd - start;
+            // metadata streams are decoded while the tree is built
+            if (size > 0xFFFFFFFF || decodedStreams.Contains(key)) {
+                continue;
+            }
+
+            Buffer buffer;
+            {
+                std::lock_guard<std::mutex> guard(readLock);
+                buffer = this->obj->GetData().CopyToBuffer(start, static_cast<uint32>(size));
+            }
+            if (!buffer.IsValid()) {
+                continue;
+            }
+
+            String message;
+            if (DecodeStream(node->decodeObj, buffer, static_cast<size_t>(size), message)) {
+                if (decodedStreams.PutIfFits(key, buffer)) {
+                    decoded++;
                 } else {
-                    Dialogs::MessageBox::ShowError("Error!", message);
+                    full = true;
                 }
+            } else {
+                errors[i] = message.Len() ? message.GetText() : "unknown error";
             }
         }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workersCount - 1);
+    for (uint32 i = 1; i < workersCount; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
     }
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!errors[i].empty()) {
+            errList.AddWarning("Unable to decode the stream of object %llu: %s", (uint64_t) nodes[i]->pdfObject.number, errors[i].c_str());
+        }
+    }
+    return decoded;
 }
 
-void PDFFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
+DecodedStreamsCache::DecodedStreamsCache(uint64 maxCachedSize) : cachedSize(0), maxCachedSize(maxCachedSize)
 {
-    const auto objectNumber = static_cast<uint32_t>(item.GetData(-1));
-    if (objectNumber == static_cast<uint32_t>(-1)) {
-        return;
-    }
+}
 
-    const auto node = FindNodeByObjectNumber(objectNumber);
-    if (!node || !node->pdfObject.hasStream) {
-        return;
+bool DecodedStreamsCache::Contains(const ObjectNums& key)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return index.find(key) != index.end();
+}
+
+bool DecodedStreamsCache::Get(const ObjectNums& key, Buffer& output)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    const auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
     }
+    entries.splice(entries.begin(), entries, it->second);
+    output = it->second->data;
+    return true;
+}
 
-    const uint64 start = node->decodeObj.streamOffsetStart;
-    const uint64 end   = node->decodeObj.streamOffsetEnd;
+void DecodedStreamsCache::Put(const ObjectNums& key, const Buffer& data)
+{
+    CHECKRET(data.GetLength() <= maxCachedSize, "");
 
-    if (end <= start) {
-        return;
+    std::lock_guard<std::mutex> guard(lock);
+    if (const auto it = index.find(key); it != index.end()) {
+        cachedSize -= it->second->data.GetLength();
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    while (!entries.empty() && cachedSize + data.GetLength() > maxCachedSize) {
+        cachedSize -= entries.back().data.GetLength();
+        index.erase(entries.back().key);
+        entries.pop_back();
     }
+    entries.push_front(Entry{ key, data });
+    index[key] = entries.begin();
+    cachedSize += data.GetLength();
+}
 
-    const size_t size     = static_cast<size_t>(end - start);
-    const auto streamView = this->obj->GetData().Get(static_cast<uint32>(start), static_cast<uint32>(size), true);
+bool DecodedStreamsCache::PutIfFits(const ObjectNums& key, const Buffer& data)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    CHECK(index.find(key) == index.end(), true, "");
+    if (cachedSize + data.GetLength() > maxCachedSize) {
+        return false;
+    }
+    entries.push_front(Entry{ key, data });
+    index[key] = entries.begin();
+    cachedSize += data.GetLength();
+    return true;
+}
 
-    if (!streamView.IsValid() || streamView.GetLength() < size) {
+bool DecodedStreamsCache::IsFull()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return cachedSize >= maxCachedSize;
+}
+
+void DecodedStreamsCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    cachedSize = 0;
+}
+
+void PDFFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
+{
+    const auto objectNumber = static_cast<uint32_t>(item.GetData(-1));
+    if (objectNumber == static_cast<uint32_t>(-1)) {
         return;
     }
 
-    Buffer buffer;
-    buffer = streamView;
+    const auto node = FindNodeByObjectNumber(objectNumber);
+    if (!node || !node->pdfObject.hasStream) {
+        return;
+    }
 
     std::u16string tmpName = u"Stream ";
     tmpName += to_u16string((uint32_t) node->pdfObject.number);
@@ -320,14 +474,26 @@ void PDFFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
     LocalUnicodeStringBuilder<64> streamName;
     CHECKRET(streamName.Set(tmpName), "");
 
+    Buffer buffer;
+    String message;
+    if (!GetDecodedStream(node, buffer, message)) {
+        // show what could be decoded, as long as the stream could be read
+        if (message.Len()) {
+            Dialogs::MessageBox::ShowError("Error!", message);
+        }
+        CHECKRET(buffer.GetLength() > 0, "");
+        message.Clear();
+    }
+
     // Encrypted fallback
     if (pdfStats.isEncrypted) {
         Dialogs::MessageBox::ShowWarning("Warning!", "Unable to decompress the stream because the PDF is encrypted! Raw data will be displayed instead.");
         GView::App::OpenBuffer(buffer, streamName.ToStringView(), streamName.ToStringView(), GView::App::OpenMethod::BestMatch);
         return;
     }
-
-    DecodeStream(node, buffer, size);
+    if (message.Len()) {
+        Dialogs::MessageBox::ShowWarning("Warning!", message);
+    }
 
     // PDF inside PDF
     constexpr const char pdfSig[] = "%PDF-";
@@ -0,0 +1,184 @@
+#include "pdf.hpp"
+
+using namespace GView::Type::PDF;
+
+DataReader::DataReader(GView::Utils::DataCache& cache) : cache(cache), windowStart(0), windowLength(0)
+{
+}
+
+bool DataReader::Fill(uint64 offset, uint32 size)
+{
+    // reads past the end of the data are normal (probes while tokenizing) -> no error is logged, like DataCache::Copy
+    const auto fileSize = cache.GetSize();
+    if (offset >= fileSize || size > fileSize - offset) {
+        return false;
+    }
+
+    // keep the window small enough to be served by a single read from the cache
+    const auto windowSize = std::max<uint32>(std::min<uint32>(WINDOW_SIZE, cache.GetCacheSize() >> 1), size);
+
+    // a read right before the current window is most likely a backward scan -> end the new window at the requested bytes
+    auto start = offset;
+    if (windowLength > 0 && offset < windowStart && windowStart - offset < windowSize) {
+        start = offset + size > windowSize ? offset + size - windowSize : 0;
+    }
+    const auto length = (uint32) std::min<uint64>(windowSize, fileSize - start);
+
+    const auto view = cache.Get(start, length, true);
+    CHECK(view.IsValid(), false, "Unable to read %u bytes from %llu offset", length, start);
+    if (window.GetLength() < length) {
+        window.Resize(length);
+    }
+    memcpy(window.GetData(), view.GetData(), length);
+    windowStart  = start;
+    windowLength = length;
+    return true;
+}
+
+bool DataReader::Matches(uint64 offset, const uint8* pattern, uint32 size)
+{
+    if (offset - windowStart >= windowLength || offset - windowStart + size > windowLength) {
+        if (!Fill(offset, size)) {
+            return false;
+        }
+    }
+    return memcmp(window.GetData() + (offset - windowStart), pattern, size) == 0;
+}
+
+Tokenizer::Tokenizer(DataReader& reader, uint64 start, uint64 end) : reader(reader), position(start), end(std::min(end, reader.GetSize()))
+{
+}
+
+bool Tokenizer::Next(Token& token)
+{
+    uint8 ch = 0;
+    while (position < end && reader.Copy(position, ch) && IsCharClass(ch, CHAR_CLASS::WHITESPACE)) {
+        position++;
+    }
+    if (position >= end || !reader.Copy(position, ch)) {
+        token.type = TokenType::None;
+        return false;
+    }
+
+    token.start = position++;
+    switch (ch) {
+    case DC::SOLIDUS:
+        token.type = TokenType::Name;
+        while (position < end && reader.Copy(position, ch) && !IsCharClass(ch, CHAR_CLASS::WHITESPACE | CHAR_CLASS::DELIMITER)) {
+            position++;
+        }
+        break;
+    case DC::LEFT_PARETHESIS: {
+        // literal strings may contain balanced parentheses and escaped characters
+        token.type   = TokenType::LiteralString;
+        uint32 depth = 1;
+        while (position < end && depth > 0 && reader.Copy(position, ch)) {
+            if (ch == DC::REVERSE_SOLIDUS) {
+                position++;
+            } else if (ch == DC::LEFT_PARETHESIS) {
+                depth++;
+            } else if (ch == DC::RIGHT_PARETHESIS) {
+                depth--;
+            }
+            position++;
+        }
+        break;
+    }
+    case DC::LESS_THAN:
+        if (position < end && reader.Copy(position, ch) && ch == DC::LESS_THAN) {
+            token.type = TokenType::DictionaryStart;
+            position++;
+            break;
+        }
+        token.type = TokenType::HexString;
+        while (position < end && reader.Copy(position, ch) && ch != DC::GREATER_THAN) {
+            position++;
+        }
+        position = std::min(position + 1, end);
+        break;
+    case DC::GREATER_THAN:
+        if (position < end && reader.Copy(position, ch) && ch == DC::GREATER_THAN) {
+            token.type = TokenType::DictionaryEnd;
+            position++;
+        } else {
+            token.type = TokenType::Other;
+        }
+        break;
+    case DC::LEFT_SQUARE_BRACKET:
+        token.type = TokenType::ArrayStart;
+        break;
+    case DC::RIGHT_SQUARE_BRACKET:
+        token.type = TokenType::ArrayEnd;
+        break;
+    case DC::PERCENT:
+        token.type = TokenType::Comment;
+        while (position < end && reader.Copy(position, ch) && ch != WSC::LINE_FEED && ch != WSC::CARRIAGE_RETURN) {
+            position++;
+        }
+        break;
+    case DC::LEFT_CURLY_BRACKET:
+    case DC::RIGHT_CURLY_BRACKET:
+    case DC::RIGHT_PARETHESIS:
+        token.type = TokenType::Other;
+        break;
+    default:
+        token.type = IsCharClass(ch, CHAR_CLASS::NUMERIC) ? TokenType::Number : TokenType::Keyword;
+        while (position < end && reader.Copy(position, ch) && !IsCharClass(ch, CHAR_CLASS::WHITESPACE | CHAR_CLASS::DELIMITER)) {
+            if (!IsCharClass(ch, CHAR_CLASS::NUMERIC)) {
+                token.type = TokenType::Keyword;
+            }
+            position++;
+        }
+        break;
+    }
+    token.end = position;
+    return true;
+}
+
+bool Tokenizer::IsKeyword(const Token& token, const uint8* keyword, uint32 size)
+{
+    return token.type == TokenType::Keyword && token.end - token.start == size && reader.Matches(token.start, keyword, size);
+}
+
+uint64 Tokenizer::GetNumber(const Token& token)
+{
+    CHECK(token.type == TokenType::Number, 0, "");
+
+    uint64 value = 0;
+    uint8 ch     = 0;
+    for (auto offset = token.start; offset < token.end && reader.Copy(offset, ch); offset++) {
+        if (ch == '.') {
+            break;
+        }
+        if (!IsCharClass(ch, CHAR_CLASS::DIGIT)) {
+            continue; // sign
+        }
+        const uint64 digit = ch - '0';
+        if (value > (0xFFFFFFFFFFFFFFFFULL - digit) / 10) {
+            return 0;
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+std::string Tokenizer::GetName(const Token& token)
+{
+    CHECK(token.type == TokenType::Name, "", "");
+
+    std::string result;
+    result.reserve((size_t) (token.end - token.start));
+    uint8 ch = 0, high = 0, low = 0;
+    for (auto offset = token.start; offset < token.end && reader.Copy(offset, ch); offset++) {
+        // #xx -> the byte with the hexadecimal code xx
+        if (ch == '#' && offset + 2 < token.end && reader.Copy(offset + 1, high) && reader.Copy(offset + 2, low) &&
+            IsCharClass(high, CHAR_CLASS::HEX_DIGIT) && IsCharClass(low, CHAR_CLASS::HEX_DIGIT)) {
+            const auto hexValue = [](uint8 c) { return (uint8) (c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10); };
+            result.push_back((char) (hexValue(high) * 16 + hexValue(low)));
+            offset += 2;
+            continue;
+        }
+        result.push_back((char) ch);
+    }
+    return result;
+}
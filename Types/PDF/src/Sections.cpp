@@ -8,6 +8,7 @@ constexpr int PDF_OBJECTS_GOTO   = 1;
 constexpr int PDF_OBJECTS_SELECT  = 2;
 constexpr int PDF_TEXTVIEWER      = 3;
 constexpr int PDF_SAVEASTXT       = 4;
+constexpr int PDF_DECODESTREAMS   = 5;
 
 Panels::Sections::Sections(Reference<GView::Type::PDF::PDFFile> _pdf, Reference<GView::View::WindowInterface> _win) : TabPage("&Objects")
 {
@@ -122,6 +123,17 @@ void Panels::Sections::Update()
     }
 }
 
+void Panels::Sections::DecodeStreams()
+{
+    const auto decoded = pdf->DecodeAllStreams();
+    LocalString<128> message;
+    message.SetFormat("Decoded %u stream(s)", decoded);
+    if (pdf->decodedStreams.IsFull()) {
+        message.Add(" (the cache is full, the rest are decoded when opened)");
+    }
+    AppCUI::Dialogs::MessageBox::ShowNotification("Decode streams", message);
+}
+
 std::string_view Panels::Sections::GetValue(NumericFormatter& n, uint32 value)
 {
     if (Base == 10) {
@@ -137,6 +149,7 @@ bool Panels::Sections::OnUpdateCommandBar(AppCUI::Application::CommandBar& comma
     commandBar.SetCommand(Key::F9, "Select", PDF_OBJECTS_SELECT);
     commandBar.SetCommand(Key::F10, "Text Viewer", PDF_TEXTVIEWER);
     commandBar.SetCommand(Key::F11, "Save as .txt file", PDF_SAVEASTXT);
+    commandBar.SetCommand(Key::F8, "Decode streams", PDF_DECODESTREAMS);
     return true;
 }
 
@@ -162,6 +175,10 @@ bool Panels::Sections::OnEvent(Reference<Control> ctrl, Event evnt, int controlI
             return true;
         case PDF_SAVEASTXT:
             pdf->ExtractAndSaveTextWithDialog(pdf);
+            return true;
+        case PDF_DECODESTREAMS:
+            DecodeStreams();
+            return true;
         }
     }
     return false;
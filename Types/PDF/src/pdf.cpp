@@ -55,17 +55,9 @@ PLUGIN_EXPORT TypeInterface* CreateInstance()
     return new PDF::PDFFile;
 }
 
-bool CheckType(GView::Utils::DataCache& data, uint64& offset, const uint64& size_type, const uint8_t PDF_ARRAY[])
+bool CheckType(PDF::DataReader& data, uint64& offset, const uint64& size_type, const uint8_t PDF_ARRAY[])
 {
-    uint8_t buffer;
-    bool match = true;
-    for (uint64 i = 0; i < size_type; ++i) {
-        if (!data.Copy(offset + i, buffer) || buffer != PDF_ARRAY[i]) {
-            match = false;
-            break;
-        }
-    }
-    return match;
+    return data.Matches(offset, PDF_ARRAY, (uint32) size_type);
 }
 
 bool IsEqualType(const std::string& s, const uint64_t& size_type, const uint8_t PDF_ARRAY[])
@@ -82,54 +74,22 @@ bool IsEqualType(const std::string& s, const uint64_t& size_type, const uint8_t
     return true;
 }
 
-static bool TerminateProcessing(const int8 buffer)
+static bool TerminateProcessing(const uint8 buffer)
 {
-    switch (buffer) {
-    case PDF::WSC::SPACE:
-    case PDF::WSC::LINE_FEED:
-    case PDF::WSC::FORM_FEED:
-    case PDF::WSC::CARRIAGE_RETURN:
-    case PDF::DC::SOLIDUS:
-    case PDF::DC::RIGHT_SQUARE_BRACKET:
-    case PDF::DC::LEFT_SQUARE_BRACKET:
-    case PDF::DC::LESS_THAN:
-    case PDF::DC::GREATER_THAN:
-    case PDF::DC::LEFT_PARETHESIS:
-    case PDF::DC::RIGHT_PARETHESIS:
-    case PDF::DC::LEFT_CURLY_BRACKET:
-    case PDF::DC::RIGHT_CURLY_BRACKET:
-        return true;
-        break;
-    default:
-        return false;
-    }
+    return PDF::IsCharClass(buffer, PDF::CHAR_CLASS::WHITESPACE | PDF::CHAR_CLASS::DELIMITER);
 }
 
 bool IsWhitespace(const uint8 ch)
 {
-    return ch == PDF::WSC::SPACE || ch == PDF::WSC::LINE_FEED || ch == PDF::WSC::FORM_FEED || ch == PDF::WSC::HORIZONAL_TAB || ch == PDF::WSC::CARRIAGE_RETURN;
+    return PDF::IsCharClass(ch, PDF::CHAR_CLASS::WHITESPACE);
 }
 
 bool IsDigit(const char ch)
 {
-    return ch >= '0' && ch <= '9';
+    return PDF::IsCharClass((uint8) ch, PDF::CHAR_CLASS::DIGIT);
 }
 
-static int HexVal(const uint8_t c)
-{
-    if (IsDigit(c)) {
-        return c - '0';
-    }
-    if (c >= 'A' && c <= 'F') {
-        return c - 'A' + 10;
-    }
-    if (c >= 'a' && c <= 'f') {
-        return c - 'a' + 10;
-    }
-    return -1;
-}
-
-static bool HasHashEscaping(GView::Utils::DataCache& data, uint64_t offset, const uint64_t endBuffer)
+static bool HasHashEscaping(PDF::DataReader& data, uint64_t offset, const uint64_t endBuffer)
 {
     offset++;
     while (offset < endBuffer) {
@@ -147,9 +107,7 @@ static bool HasHashEscaping(GView::Utils::DataCache& data, uint64_t offset, cons
                     break;
                 }
 
-                const int v1 = HexVal(c1);
-                const int v2 = HexVal(c2);
-                if (v1 >= 0 && v2 >= 0) {
+                if (PDF::IsCharClass(c1, PDF::CHAR_CLASS::HEX_DIGIT) && PDF::IsCharClass(c2, PDF::CHAR_CLASS::HEX_DIGIT)) {
                     return true;
                 }
             }
@@ -159,92 +117,41 @@ static bool HasHashEscaping(GView::Utils::DataCache& data, uint64_t offset, cons
     return false;
 }
 
-static std::string DecodeName(GView::Utils::DataCache& data, uint64_t& offset, const uint64_t endBuffer)
+// offset must point to the '/' of the name; it is moved after the last character of the name
+static std::string DecodeName(PDF::DataReader& data, uint64_t& offset, const uint64_t endBuffer)
 {
-    std::string result;
-    result += "/";
-    offset++;
-    while (offset < endBuffer) {
-        uint8 c;
-        if (!data.Copy(offset, c)) {
-            break;
-        }
-
-        if (TerminateProcessing(c)) {
-            break;
-        }
-
-        if (c == '#') {
-            if (offset + 2 < endBuffer) {
-                uint8 c1, c2;
-                if (!data.Copy(offset + 1, c1) || !data.Copy(offset + 2, c2)) {
-                    break;
-                }
-
-                const int v1 = HexVal(c1);
-                const int v2 = HexVal(c2);
-                if (v1 >= 0 && v2 >= 0) {
-                    uint8_t decoded = static_cast<uint8_t>(v1 * 16 + v2);
-                    result.push_back((char) decoded);
-                    // Skip the '#' + two hex digits
-                    offset += 3;
-                    continue;
-                }
-            }
-        }
-        result.push_back((char) c);
+    PDF::Tokenizer tokenizer(data, offset, endBuffer);
+    PDF::Token token;
+    if (!tokenizer.Next(token) || token.type != PDF::TokenType::Name || token.start != offset) {
         offset++;
+        return "/";
     }
-    // offset--;
-    return result;
+    offset = token.end;
+    return tokenizer.GetName(token);
 }
 
-uint64_t GetTypeValue(GView::Utils::DataCache& data, uint64_t& offset, const uint64_t& dataSize)
+uint64_t GetTypeValue(PDF::DataReader& data, uint64_t& offset, const uint64_t& dataSize)
 {
     if (offset >= dataSize) {
         return 0;
     }
 
-    const uint64_t start = offset;
-    uint8_t b            = 0;
-    while (offset < dataSize && data.Copy(offset, b) && std::isdigit(static_cast<unsigned char>(b))) {
-        ++offset;
-    }
-
-    const uint64_t len = offset - start;
-    if (len == 0) {
-        return 0;
-    }
-
-    if (len > 20) {
-        // Dialogs::MessageBox::ShowError("Error!", "Unusual big size for length");
-        return 0;
-    }
-
-    char buf[21];
-    for (uint64_t i = 0; i < len; ++i) {
-        data.Copy(start + i, b);
-        buf[i] = static_cast<char>(b);
-    }
-
-    if (len == 20) {
-        static constexpr char kMax[] = "18446744073709551615";
-        if (std::lexicographical_compare(kMax, kMax + 20, buf, buf + 20) == false) {
-            // buf >= kMax -> overflow
+    uint64_t value = 0;
+    bool overflow  = false;
+    uint8_t b      = 0;
+    while (offset < dataSize && data.Copy(offset, b) && IsDigit(b)) {
+        const uint64_t digit = b - '0';
+        if (value > (0xFFFFFFFFFFFFFFFFULL - digit) / 10) {
             // Dialogs::MessageBox::ShowError("Error!", "Length value overflows uint64");
-            return 0;
+            overflow = true;
         }
+        value = value * 10 + digit;
+        ++offset;
     }
-
-    uint64_t value = 0;
-    auto res       = std::from_chars(buf, buf + len, value, 10);
-    if (res.ec != std::errc()) {
-        return 0;
-    }
-    return value;
+    return overflow ? 0 : value;
 }
 
-uint8 GetWValue(GView::Utils::DataCache& data, uint64& offset)
+uint8 GetWValue(PDF::DataReader& data, uint64& offset)
 {
     std::string lengthValStr;
     uint8_t buffer;
@@ -260,7 +167,7 @@ uint8 GetWValue(GView::Utils::DataCache& data, uint64& offset)
     return value;
 }
 
-void GetFilters(GView::Utils::DataCache& data, uint64& offset, const uint64& dataSize, std::vector<std::string>& filters, GView::Utils::ErrorList& errList)
+void GetFilters(PDF::DataReader& data, uint64& offset, const uint64& dataSize, std::vector<std::string>& filters, GView::Utils::ErrorList& errList)
 {
     const std::unordered_set<std::string> STANDARD_FILTERS = { "/ASCIIHexDecode",  "/ASCII85Decode",  "/LZWDecode",   "/FlateDecode",
                                                                "/RunLengthDecode", "/CCITTFaxDecode", "/JBIG2Decode", "/DCTDecode",
@@ -325,7 +232,7 @@ void GetDecompressDataValue(Buffer& decompressedData, uint64& offset, const uint
 void GetObjectsOffsets(
       const uint64& numEntries,
       uint64& offset,
-      GView::Utils::DataCache& data,
+      PDF::DataReader& data,
       std::vector<uint64_t>& objectOffsets,
       GView::Utils::ErrorList& errList,
       bool& enableFaultTolerance)
@@ -377,7 +284,7 @@ void GetObjectsOffsets(
     }
 }
 
-uint64 GetNumberOfEntries(uint64& offset, const uint64& dataSize, GView::Utils::DataCache& data)
+uint64 GetNumberOfEntries(uint64& offset, const uint64& dataSize, PDF::DataReader& data)
 {
     uint8_t buffer;
     uint16_t numEntries = 0;
@@ -423,7 +330,7 @@ uint64 GetNumberOfEntries(uint64& offset, const uint64& dataSize, GView::Utils::
     return numEntries;
 }
 
-bool GetTrailerOffset(uint64 offset, const uint64& dataSize, GView::Utils::DataCache& data, uint64& trailerOffset)
+bool GetTrailerOffset(uint64 offset, const uint64& dataSize, PDF::DataReader& data, uint64& trailerOffset)
 {
     // trailer segment
     bool foundTrailer = false;
@@ -439,7 +346,7 @@ bool GetTrailerOffset(uint64 offset, const uint64& dataSize, GView::Utils::DataC
 }
 
 void HighlightObjectTypes(
-      GView::Utils::DataCache& data, Reference<PDF::PDFFile> pdf, BufferViewer::Settings& settings, const uint64_t& dataSize, PDF::PDFObject& pdfObject)
+      PDF::DataReader& data, Reference<PDF::PDFFile> pdf, BufferViewer::Settings& settings, const uint64_t& dataSize, PDF::PDFObject& pdfObject)
 {
     uint8_t buffer;
     uint64_t lengthVal    = 0;
@@ -452,141 +359,97 @@ void HighlightObjectTypes(
     }
     objectOffset += PDF::KEY::PDF_OBJ_SIZE;
 
-    while (objectOffset < pdfObject.endBuffer) {
-        if (!data.Copy(objectOffset, buffer)) {
+    PDF::Tokenizer tokenizer(data, objectOffset, pdfObject.endBuffer);
+    PDF::Token token;
+    while (tokenizer.Next(token)) {
+        const uint64_t tokenSize = token.end - token.start;
+        switch (token.type) {
+        case PDF::TokenType::DictionaryStart:
+        case PDF::TokenType::DictionaryEnd:
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::Yellow, Color::DarkBlue }, "Dictionary");
+            break;
+        case PDF::TokenType::ArrayStart:
+        case PDF::TokenType::ArrayEnd:
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::Olive, Color::DarkBlue }, "Array");
+            break;
+        case PDF::TokenType::Number:
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::Green, Color::DarkBlue }, "Numeric");
+            break;
+        case PDF::TokenType::LiteralString:
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::DarkGreen, Color::DarkBlue }, "Literal String");
+            break;
+        case PDF::TokenType::HexString:
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::DarkGreen, Color::DarkBlue }, "Hex String");
             break;
-        } else if (
-              CheckType(data, objectOffset, PDF::KEY::PDF_DIC_SIZE, PDF::KEY::PDF_DIC_START) ||
-              CheckType(data, objectOffset, PDF::KEY::PDF_DIC_SIZE, PDF::KEY::PDF_DIC_END)) {
-            settings.AddZone(objectOffset, PDF::KEY::PDF_DIC_SIZE, ColorPair{ Color::Yellow, Color::DarkBlue }, "Dictionary");
-            objectOffset += PDF::KEY::PDF_DIC_SIZE;
-        } else if (buffer == PDF::DC::SOLIDUS) {
-            uint64_t copyObjectOffset = objectOffset;
+        case PDF::TokenType::Name: {
             if (!pdf->hashEscaping) {
-                pdf->hashEscaping = HasHashEscaping(data, copyObjectOffset, pdfObject.endBuffer);
+                pdf->hashEscaping = HasHashEscaping(data, token.start, token.end);
             }
-            std::string decodedName = DecodeName(data, copyObjectOffset, pdfObject.endBuffer);
+            settings.AddZone(token.start, tokenSize, ColorPair{ Color::Red, Color::DarkBlue }, "Name");
             // get the length for the stream so that we don't have to go through all the bytes
-            if (!foundLength && IsEqualType(decodedName, PDF::KEY::PDF_STREAM_LENGTH_SIZE, PDF::KEY::PDF_STREAM_LENGTH)) { // /Length for the stream
-                settings.AddZone(objectOffset, copyObjectOffset - objectOffset, ColorPair{ Color::Red, Color::DarkBlue }, "Name");
-                objectOffset                 = copyObjectOffset + 1;
-                const uint64_t start_segment = objectOffset;
-                lengthVal                    = GetTypeValue(data, objectOffset, dataSize);
-                settings.AddZone(start_segment, objectOffset - start_segment, ColorPair{ Color::Green, Color::DarkBlue }, "Numeric");
-                foundLength = true;
-            } else {
-                const uint64_t start_segment = objectOffset;
-                objectOffset++;
-                bool end_name = false;
-                while (objectOffset < dataSize && !end_name) {
-                    if (!data.Copy(objectOffset, buffer)) {
-                        break;
-                    }
-                    switch (buffer) {
-                    case PDF::WSC::SPACE:
-                    case PDF::WSC::LINE_FEED:
-                    case PDF::WSC::FORM_FEED:
-                    case PDF::WSC::CARRIAGE_RETURN:
-                    case PDF::DC::SOLIDUS:
-                    case PDF::DC::RIGHT_SQUARE_BRACKET:
-                    case PDF::DC::LEFT_SQUARE_BRACKET:
-                    case PDF::DC::LESS_THAN:
-                    case PDF::DC::GREATER_THAN:
-                    case PDF::DC::LEFT_PARETHESIS:
-                    case PDF::DC::RIGHT_PARETHESIS:
-                        end_name = true;
-                        break;
-                    default:
-                        objectOffset++;
-                    }
+            if (!foundLength && tokenizer.GetName(token) == std::string_view{ (const char*) PDF::KEY::PDF_STREAM_LENGTH, PDF::KEY::PDF_STREAM_LENGTH_SIZE }) {
+                PDF::Token value;
+                const auto valuePosition = tokenizer.GetPosition();
+                if (tokenizer.Next(value) && value.type == PDF::TokenType::Number) {
+                    settings.AddZone(value.start, value.end - value.start, ColorPair{ Color::Green, Color::DarkBlue }, "Numeric");
+                    lengthVal   = tokenizer.GetNumber(value);
+                    foundLength = true;
+                } else {
+                    tokenizer.SetPosition(valuePosition);
                 }
-                settings.AddZone(start_segment, objectOffset - start_segment, ColorPair{ Color::Red, Color::DarkBlue }, "Name");
             }
-        } else if (buffer == PDF::KEY::PDF_INDIRECTOBJ) {
-            settings.AddZone(objectOffset, 1, ColorPair{ Color::Yellow, Color::Blue }, "Indirect Obj");
-            objectOffset++;
-        } else if (CheckType(data, objectOffset, PDF::KEY::PDF_STREAM_SIZE, PDF::KEY::PDF_STREAM)) {
-            if (foundLength) {
-                const uint64_t start_segment = objectOffset;
-                objectOffset += PDF::KEY::PDF_STREAM_SIZE + lengthVal;
-
-                while (data.Copy(objectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
-                    objectOffset++;
-                }
+            break;
+        }
+        case PDF::TokenType::Keyword:
+            if (tokenSize == 1 && data.Copy(token.start, buffer) && buffer == PDF::KEY::PDF_INDIRECTOBJ) {
+                settings.AddZone(token.start, 1, ColorPair{ Color::Yellow, Color::Blue }, "Indirect Obj");
+            } else if (tokenizer.IsKeyword(token, PDF::KEY::PDF_STREAM, PDF::KEY::PDF_STREAM_SIZE)) {
+                // the stream data is not tokenized: jump over it using /Length or look for endstream
+                const uint64_t start_segment = token.start;
+                objectOffset                 = token.start;
+                if (foundLength) {
+                    objectOffset += PDF::KEY::PDF_STREAM_SIZE + lengthVal;
+
+                    while (data.Copy(objectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
+                        objectOffset++;
+                    }
 
-                if (!CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM) && objectOffset < dataSize) {
-                    objectOffset -= lengthVal;
-                    while (objectOffset < dataSize) {
-                        if (CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM)) {
-                            break;
-                        } else {
+                    if (!CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM) && objectOffset < dataSize) {
+                        objectOffset -= lengthVal;
+                        while (objectOffset < dataSize && !CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM)) {
                             objectOffset++;
                         }
                     }
-                }
-                objectOffset += PDF::KEY::PDF_ENDSTREAM_SIZE;
-                settings.AddZone(start_segment, objectOffset - start_segment, ColorPair{ Color::Aqua, Color::DarkBlue }, "Stream");
-                pdf->pdfStats.streamsCount++;
-            } else {
-                const uint64_t start_segment = objectOffset;
-                objectOffset += PDF::KEY::PDF_STREAM_SIZE;
-                while (objectOffset < dataSize) {
-                    if (CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM)) {
-                        break;
-                    } else {
+                } else {
+                    objectOffset += PDF::KEY::PDF_STREAM_SIZE;
+                    while (objectOffset < dataSize && !CheckType(data, objectOffset, PDF::KEY::PDF_ENDSTREAM_SIZE, PDF::KEY::PDF_ENDSTREAM)) {
                         objectOffset++;
                     }
                 }
                 objectOffset += PDF::KEY::PDF_ENDSTREAM_SIZE;
                 settings.AddZone(start_segment, objectOffset - start_segment, ColorPair{ Color::Aqua, Color::DarkBlue }, "Stream");
                 pdf->pdfStats.streamsCount++;
-                break;
-            }
-        } else if (buffer == PDF::DC::LEFT_SQUARE_BRACKET || buffer == PDF::DC::RIGHT_SQUARE_BRACKET) {
-            settings.AddZone(objectOffset, 1, ColorPair{ Color::Olive, Color::DarkBlue }, "Array");
-            objectOffset++;
-        } else if (buffer == '-' || buffer == '+' || IsDigit(buffer)) {
-            const uint64_t start_segment = objectOffset;
-            objectOffset++;
-            while (objectOffset < dataSize && data.Copy(objectOffset, buffer) && (IsDigit(buffer) || buffer == '.')) {
-                objectOffset++;
-            }
-            settings.AddZone(start_segment, objectOffset - start_segment, ColorPair{ Color::Green, Color::DarkBlue }, "Numeric");
-        } else if (buffer == PDF::DC::LEFT_PARETHESIS) {
-            const uint64_t start_segment = objectOffset;
-            objectOffset++;
-            while (objectOffset < dataSize && data.Copy(objectOffset, buffer) && buffer != PDF::DC::RIGHT_PARETHESIS) {
-                if (buffer == PDF::DC::REVERSE_SOLIDUS) {
-                    objectOffset++;
-                }
-                objectOffset++;
-            }
-            settings.AddZone(start_segment, objectOffset - start_segment + 1, ColorPair{ Color::DarkGreen, Color::DarkBlue }, "Literal String");
-        } else if (buffer == PDF::DC::LESS_THAN) {
-            const uint64_t start_segment = objectOffset;
-            objectOffset++;
-            while (objectOffset < dataSize && data.Copy(objectOffset, buffer) && buffer != PDF::DC::GREATER_THAN) {
-                objectOffset++;
+                if (!foundLength) {
+                    return;
+                }
+                tokenizer.SetPosition(objectOffset);
+            } else if (tokenizer.IsKeyword(token, PDF::KEY::PDF_TRUE, PDF::KEY::PDF_TRUE_SIZE)) {
+                settings.AddZone(token.start, tokenSize, ColorPair{ Color::DarkRed, Color::DarkBlue }, "Boolean");
+            } else if (tokenizer.IsKeyword(token, PDF::KEY::PDF_FALSE, PDF::KEY::PDF_FALSE_SIZE)) {
+                settings.AddZone(token.start, tokenSize, ColorPair{ Color::DarkRed, Color::DarkBlue }, "Boolean");
+            } else if (tokenizer.IsKeyword(token, PDF::KEY::PDF_NULL, PDF::KEY::PDF_NULL_SIZE)) {
+                settings.AddZone(token.start, tokenSize, ColorPair{ Color::White, Color::Blue }, "Null");
+            } else if (tokenizer.IsKeyword(token, PDF::KEY::PDF_ENDOBJ, PDF::KEY::PDF_ENDOBJ_SIZE)) {
+                return;
             }
-            settings.AddZone(start_segment, objectOffset - start_segment + 1, ColorPair{ Color::DarkGreen, Color::DarkBlue }, "Hex String");
-        } else if (CheckType(data, objectOffset, PDF::KEY::PDF_TRUE_SIZE, PDF::KEY::PDF_TRUE)) {
-            settings.AddZone(objectOffset, PDF::KEY::PDF_TRUE_SIZE, ColorPair{ Color::DarkRed, Color::DarkBlue }, "Boolean");
-            objectOffset += PDF::KEY::PDF_TRUE_SIZE;
-        } else if (CheckType(data, objectOffset, PDF::KEY::PDF_FALSE_SIZE, PDF::KEY::PDF_FALSE)) {
-            settings.AddZone(objectOffset, PDF::KEY::PDF_FALSE_SIZE, ColorPair{ Color::DarkRed, Color::DarkBlue }, "Boolean");
-            objectOffset += PDF::KEY::PDF_FALSE_SIZE;
-        } else if (CheckType(data, objectOffset, PDF::KEY::PDF_NULL_SIZE, PDF::KEY::PDF_NULL)) {
-            settings.AddZone(objectOffset, PDF::KEY::PDF_NULL_SIZE, ColorPair{ Color::White, Color::Blue }, "Null");
-            objectOffset += PDF::KEY::PDF_NULL_SIZE;
-        } else if (CheckType(data, objectOffset, PDF::KEY::PDF_ENDOBJ_SIZE, PDF::KEY::PDF_ENDOBJ)) {
             break;
-        } else {
-            objectOffset++;
+        default:
+            break;
         }
     }
 }
 
-bool IsCrossRefStream(uint64 offset, GView::Utils::DataCache& data, const uint64& dataSize)
+bool IsCrossRefStream(uint64 offset, PDF::DataReader& data, const uint64& dataSize)
 {
     uint8_t buffer;
     if (!data.Copy(offset, buffer) || !IsDigit(buffer)) {
@@ -632,7 +495,7 @@ bool IsCrossRefStream(uint64 offset, GView::Utils::DataCache& data, const uint64
     return true;
 }
 
-bool ExtractObjectNumbers(GView::Utils::DataCache& data, uint64& offset, uint64& objectNumber, uint16& generationNumber)
+bool ExtractObjectNumbers(PDF::DataReader& data, uint64& offset, uint64& objectNumber, uint16& generationNumber)
 {
     std::string numberStr;
     std::string genStr;
@@ -694,7 +557,7 @@ void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<PDF
 {
     BufferViewer::Settings settings;
 
-    auto& data            = pdf->obj->GetData();
+    PDF::DataReader data(pdf->obj->GetData());
     const uint64 dataSize = data.GetSize();
     uint64 offset         = dataSize;
     uint64 crossRefOffset = 0;
@@ -1296,10 +1159,10 @@ void CreateBufferView(Reference<GView::View::WindowInterface> win, Reference<PDF
 
 bool GetObjectReference(
       const uint64& dataSize,
-      GView::Utils::DataCache& data,
+      PDF::DataReader& data,
       uint64& objectOffset,
       uint8& buffer,
-      std::vector<PDF::ObjectNums>& objectNums,
+      PDF::ObjectReferences& objectNums,
       uint64& outObjectNumber,
       uint16& outGeneration)
 {
@@ -1356,15 +1219,13 @@ bool GetObjectReference(
     outGeneration   = gen;
 
     const PDF::ObjectNums ref{ obj, gen };
-    if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-        objectNums.push_back(ref);
-    }
+    objectNums.Add(ref);
 
     objectOffset = pos;
     return true;
 }
 
-std::string GetDictionaryType(GView::Utils::DataCache& data, uint64& objectOffset, const uint64& dataSize, std::vector<std::string>& entries)
+std::string GetDictionaryType(PDF::DataReader& data, uint64& objectOffset, const uint64& dataSize, std::vector<std::string>& entries)
 {
     uint8 buffer;
     std::string entry;
@@ -1381,12 +1242,12 @@ std::string GetDictionaryType(GView::Utils::DataCache& data, uint64& objectOffse
 }
 
 uint64 GetLengthNumber(
-      GView::Utils::DataCache& data,
+      PDF::DataReader& data,
       uint64& objectOffset,
       const uint64& dataSize,
-      std::vector<PDF::PDFObject>& pdfObjects,
-      const std::vector<PDF::ObjectNums>& processedObjects,
-      std::vector<PDF::ObjectNums>& objectNums)
+      PDF::ObjectTable& pdfObjects,
+      const std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash>& processedObjects,
+      PDF::ObjectReferences& objectNums)
 {
     uint64 numberLength = 0;
     uint8 buffer;
@@ -1417,30 +1278,27 @@ uint64 GetLengthNumber(
 
     if (foundRef) {
         PDF::ObjectNums ref{ static_cast<uint32_t>(numberLength), static_cast<uint16_t>(generation) };
-        if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-            if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                objectNums.push_back(ref);
-            }
+        if (processedObjects.find(ref) == processedObjects.end()) {
+            objectNums.Add(ref);
         }
     }
 
     if (foundRef) {
-        for (auto& object : pdfObjects) {
-            if (object.number == numberLength) {
-                uint64 refObjectOffset = object.startBuffer;
-                while (refObjectOffset <= object.endBuffer) {
-                    if (CheckType(data, refObjectOffset, PDF::KEY::PDF_OBJ_SIZE, PDF::KEY::PDF_OBJ)) {
-                        refObjectOffset += PDF::KEY::PDF_OBJ_SIZE;
-                        while (data.Copy(refObjectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
-                            refObjectOffset++;
-                        }
-                        numberLength = GetTypeValue(data, refObjectOffset, dataSize);
-                        break;
-                    } else {
+        const auto index = pdfObjects.FindIndex(numberLength, static_cast<uint16>(generation));
+        if (index != PDF::ObjectTable::INVALID_INDEX) {
+            auto& object           = pdfObjects[index];
+            uint64 refObjectOffset = object.startBuffer;
+            while (refObjectOffset <= object.endBuffer) {
+                if (CheckType(data, refObjectOffset, PDF::KEY::PDF_OBJ_SIZE, PDF::KEY::PDF_OBJ)) {
+                    refObjectOffset += PDF::KEY::PDF_OBJ_SIZE;
+                    while (data.Copy(refObjectOffset, buffer) && (buffer == PDF::WSC::LINE_FEED || buffer == PDF::WSC::CARRIAGE_RETURN)) {
                         refObjectOffset++;
                     }
+                    numberLength = GetTypeValue(data, refObjectOffset, dataSize);
+                    break;
+                } else {
+                    refObjectOffset++;
                 }
-                break;
             }
         }
         objectOffset = copyOffset;
@@ -1457,16 +1315,6 @@ void InsertValuesIntoStats(std::vector<std::string>& stats, const std::vector<st
     stats.assign(uniqueFilters.begin(), uniqueFilters.end());
 }
 
-static PDF::PDFObject* FindObjectByNumber(std::vector<PDF::PDFObject>& pdfObjects, const uint64 number, const uint64 generation, const uint64 start)
-{
-    for (auto& obj : pdfObjects) {
-        if (obj.number == number && obj.generation == generation && obj.startBuffer == start) {
-            return &obj;
-        }
-    }
-    return nullptr;
-}
-
 static std::string MakeXMPDateReadable(const std::string& xmpDate)
 {
     if (xmpDate.size() < 19) {
@@ -1633,29 +1481,21 @@ void ExtractXMPMetadata(const Buffer& buffer, PDF::Metadata& pdfMetadata)
     }
 }
 
-void ProcessMetadataStream(Reference<GView::Type::PDF::PDFFile> pdf, GView::Utils::DataCache& data, PDF::ObjectNode* objectNode, PDF::Metadata& pdfMetadata)
+void ProcessMetadataStream(Reference<GView::Type::PDF::PDFFile> pdf, PDF::ObjectNode* objectNode, PDF::Metadata& pdfMetadata)
 {
     if (objectNode->pdfObject.hasStream) {
-        const uint64 offset = objectNode->decodeObj.streamOffsetStart;
-        const uint64 end    = objectNode->decodeObj.streamOffsetEnd;
-
-        if (end <= offset || end > data.GetEntireFile().GetLength()) {
-            return;
-        }
-        const size_t size = static_cast<size_t>(end - offset);
-
-        Buffer buffer;
-        buffer.Resize(size);
-        memcpy(buffer.GetData(), data.GetEntireFile().GetData() + offset, size);
-
         // encrypted -> can't open the stream, for now
         if (pdf->pdfStats.isEncrypted) {
             Dialogs::MessageBox::ShowWarning("Warning!", "Unable to decompress the stream because the PDF is encrypted! Raw data will be displayed instead.");
-            pdf->errList.AddError("Unable to decompress the stream because the PDF is encrypted (0x%llX)", (uint64_t) offset);
+            pdf->errList.AddError("Unable to decompress the stream because the PDF is encrypted (0x%llX)", (uint64_t) objectNode->decodeObj.streamOffsetStart);
             return;
         }
         // Decode the content of the stream based on the filters
-        pdf->DecodeStream(objectNode, buffer, size);
+        Buffer buffer;
+        String message;
+        if (!pdf->GetDecodedStream(objectNode, buffer, message)) {
+            return;
+        }
         ExtractXMPMetadata(buffer, pdfMetadata);
     }
 }
@@ -1794,7 +1634,7 @@ static std::string MakeDateReadable(const std::string& pdfDate)
     return out.str();
 }
 
-static std::string ParseLiteralString(GView::Utils::DataCache& data, uint64& offset, uint64 endOffset)
+static std::string ParseLiteralString(PDF::DataReader& data, uint64& offset, uint64 endOffset)
 {
     offset++; // Skip '('
     std::string result;
@@ -1878,7 +1718,7 @@ static std::string ParseLiteralString(GView::Utils::DataCache& data, uint64& off
 }
 
 static void ProcessMetadataObject(
-      GView::Utils::DataCache& data, const PDF::ObjectNode& objectNode, PDF::Metadata& pdfMetadata, GView::Utils::ErrorList& errList)
+      PDF::DataReader& data, const PDF::ObjectNode& objectNode, PDF::Metadata& pdfMetadata, GView::Utils::ErrorList& errList)
 {
     uint64 offset          = objectNode.pdfObject.startBuffer;
     const uint64 endOffset = objectNode.pdfObject.endBuffer;
@@ -1933,7 +1773,7 @@ static void ProcessMetadataObject(
 
 static void FindAndProcessMetadataObjects(Reference<GView::Type::PDF::PDFFile> pdf)
 {
-    auto& data = pdf->obj->GetData();
+    PDF::DataReader data(pdf->obj->GetData());
     std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash> toFind(pdf->metadataObjectNumbers.begin(), pdf->metadataObjectNumbers.end());
     std::function<void(PDF::ObjectNode&)> searchTree = [&](PDF::ObjectNode& node) {
         if (toFind.empty()) {
@@ -1953,7 +1793,7 @@ static void FindAndProcessMetadataObjects(Reference<GView::Type::PDF::PDFFile> p
                 ProcessMetadataObject(data, node, pdf->pdfMetadata, pdf->errList);
             } else {
                 // stream <XML data> endstream
-                ProcessMetadataStream(pdf, data, &node, pdf->pdfMetadata);
+                ProcessMetadataStream(pdf, &node, pdf->pdfMetadata);
             }
             toFind.erase(it);
             if (toFind.empty()) {
@@ -1973,10 +1813,10 @@ static void FindAndProcessMetadataObjects(Reference<GView::Type::PDF::PDFFile> p
 
 void ProcessPDFTree(
       const uint64& dataSize,
-      GView::Utils::DataCache& data,
+      PDF::DataReader& data,
       PDF::ObjectNode& objectNode,
-      vector<PDF::PDFObject>& pdfObjects,
-      vector<PDF::ObjectNums>& processedObjects,
+      PDF::ObjectTable& pdfObjects,
+      std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash>& processedObjects,
       PDF::PDFStats& pdfStats,
       vector<PDF::ObjectNums>& metadataObjectNumbers,
       GView::Utils::ErrorList& errList)
@@ -1986,9 +1826,9 @@ void ProcessPDFTree(
     uint8 buffer;
     uint64 streamLength = 0;
     bool foundLength    = false;
-    std::vector<PDF::ObjectNums> objectNums;
+    PDF::ObjectReferences objectNums;
     PDF::ObjectNums key{ objectNode.pdfObject.number, objectNode.pdfObject.generation };
-    processedObjects.push_back(key);
+    processedObjects.insert(key);
     objectNode.pdfObject.hasStream = false;
 
     while (objectOffset < objectNode.pdfObject.endBuffer) {
@@ -2226,10 +2066,8 @@ void ProcessPDFTree(
                     metadataObjectNumbers.push_back(ref);
                 }
 
-                if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-                    if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                        objectNums.push_back(ref);
-                    }
+                if (processedObjects.find(ref) == processedObjects.end()) {
+                    objectNums.Add(ref);
                 }
             } else {
                 objectOffset--;
@@ -2316,10 +2154,8 @@ void ProcessPDFTree(
             }
             if (foundObjRef) {
                 PDF::ObjectNums ref{ number, generation };
-                if (std::count(processedObjects.begin(), processedObjects.end(), ref) == 0) {
-                    if (std::find(objectNums.begin(), objectNums.end(), ref) == objectNums.end()) {
-                        objectNums.push_back(ref);
-                    }
+                if (processedObjects.find(ref) == processedObjects.end()) {
+                    objectNums.Add(ref);
                 }
             } else {
                 objectOffset++;
@@ -2329,7 +2165,7 @@ void ProcessPDFTree(
         }
     }
 
-    if (auto* found = FindObjectByNumber(pdfObjects, objectNode.pdfObject.number, objectNode.pdfObject.generation, objectNode.pdfObject.startBuffer)) {
+    if (auto* found = pdfObjects.Find(objectNode.pdfObject.number, objectNode.pdfObject.generation, objectNode.pdfObject.startBuffer)) {
         found->hasStream          = objectNode.pdfObject.hasStream;
         found->filters            = objectNode.decodeObj.filters;
         found->dictionaryTypes    = objectNode.pdfObject.dictionaryTypes;
@@ -2338,17 +2174,15 @@ void ProcessPDFTree(
     }
 
     for (const auto& ref : objectNums) {
-        for (const auto& object : pdfObjects) {
-            if (ref.obj == object.number && ref.gen == object.generation) {
-                PDF::ObjectNode newObject;
-                newObject.pdfObject = object;
-                objectNode.children.push_back(newObject);
-            }
+        for (auto index = pdfObjects.FindIndex(ref.obj, ref.gen); index != PDF::ObjectTable::INVALID_INDEX; index = pdfObjects.GetNextIndex(index)) {
+            PDF::ObjectNode newObject;
+            newObject.pdfObject = pdfObjects[index];
+            objectNode.children.push_back(newObject);
         }
     }
     for (auto& child : objectNode.children) {
         PDF::ObjectNums key{ child.pdfObject.number, child.pdfObject.generation };
-        if (std::count(processedObjects.begin(), processedObjects.end(), key) == 0) {
+        if (processedObjects.find(key) == processedObjects.end()) {
             ProcessPDFTree(dataSize, data, child, pdfObjects, processedObjects, pdfStats, metadataObjectNumbers, errList);
         }
     }
@@ -2356,9 +2190,12 @@ void ProcessPDFTree(
 
 static void ProcessPDF(Reference<PDF::PDFFile> pdf)
 {
-    auto& data            = pdf->obj->GetData();
+    // CreateBufferView can stop early (no startxref / trailer) -> index whatever objects it found here
+    pdf->pdfObjects.Finalize();
+
+    PDF::DataReader data(pdf->obj->GetData());
     const uint64 dataSize = data.GetSize();
-    std::vector<PDF::ObjectNums> objectNums;
+    PDF::ObjectReferences objectNums;
 
     if (pdf->hasXrefTable) {
         bool firstTrailer = false;
@@ -2596,12 +2433,12 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
                 crossStreamCnt = true;
             } else if (object.type == PDF::SectionPDFObjectType::CrossRefStream) {
                 PDF::ObjectNums objectNum{ object.number, object.generation };
-                objectNums.push_back(objectNum);
+                objectNums.Add(objectNum);
             }
         }
     }
 
-    if (auto* found = FindObjectByNumber(pdf->pdfObjects, pdf->objectNodeRoot.pdfObject.number, pdf->objectNodeRoot.pdfObject.generation, pdf->objectNodeRoot.pdfObject.startBuffer)) {
+    if (auto* found = pdf->pdfObjects.Find(pdf->objectNodeRoot.pdfObject.number, pdf->objectNodeRoot.pdfObject.generation, pdf->objectNodeRoot.pdfObject.startBuffer)) {
         found->filters            = pdf->objectNodeRoot.decodeObj.filters;
         found->dictionaryTypes    = pdf->objectNodeRoot.pdfObject.dictionaryTypes;
         found->dictionarySubtypes = pdf->objectNodeRoot.pdfObject.dictionarySubtypes;
@@ -2613,14 +2450,11 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
     std::unordered_set<PDF::ObjectNums, PDF::ObjectNumsHash> insertedObjectIds;
 
     for (const auto& ref : objectNums) {
-        for (const auto& object : pdf->pdfObjects) {
-            if (ref.obj == object.number && ref.gen == object.generation) {
-                if (insertedObjectIds.insert(ref).second) {
-                    PDF::ObjectNode newObject;
-                    newObject.pdfObject = object;
-                    pdf->objectNodeRoot.children.push_back(newObject);
-                }
-            }
+        const auto index = pdf->pdfObjects.FindIndex(ref.obj, ref.gen);
+        if (index != PDF::ObjectTable::INVALID_INDEX && insertedObjectIds.insert(ref).second) {
+            PDF::ObjectNode newObject;
+            newObject.pdfObject = pdf->pdfObjects[index];
+            pdf->objectNodeRoot.children.push_back(newObject);
         }
     }
 
@@ -2634,7 +2468,7 @@ static void ProcessPDF(Reference<PDF::PDFFile> pdf)
     for (const auto& object : pdf->pdfObjects) {
         PDF::ObjectNums key{ object.number, object.generation };
         if (object.number != 0 && object.type != PDF::SectionPDFObjectType::CrossRefStream &&
-            std::count(pdf->processedObjects.begin(), pdf->processedObjects.end(), key) == 0) {
+            pdf->processedObjects.find(key) == pdf->processedObjects.end()) {
             pdf->objectNodeRoot.children.emplace_back();
             auto& childNode = pdf->objectNodeRoot.children.back();
 
@@ -7,6 +7,7 @@ namespace GView::Type::SQLite
 constexpr uint8_t SQLITE3_MAGIC[]      = "SQLite format 3";
 constexpr char BUFFER_VIEW_SEPARATOR[] = ",";
 constexpr char separator               = ',';
+constexpr uint32 MAX_TABLE_VIEWERS     = 8;
 
 class SQLiteFile : public TypeInterface
 {
@@ -33,6 +34,27 @@ class SQLiteFile : public TypeInterface
     GView::Utils::JsonBuilderInterface* GetSmartAssistantContext(const std::string_view& prompt, std::string_view displayPrompt) override;
 };
 
+// a table of the database for the grid viewer, read page by page through a cursor;
+// the cursor (and its connections and threads) is opened when the grid asks for data for the first time
+class TableDataSource : public GView::View::GridViewer::DataSourceInterface
+{
+    Reference<GView::SQLite3::Database> db;
+    std::string table;
+    GView::SQLite3::Cursor cursor;
+    bool opened;
+
+    bool Open();
+
+  public:
+    TableDataSource(Reference<GView::SQLite3::Database> db, std::string_view table);
+
+    uint64 GetRowsCount() override;
+    bool HasRow(uint64 row) override;
+    uint32 GetColumnsCount() override;
+    bool GetColumnName(uint32 column, String& name) override;
+    bool GetCell(uint64 row, uint32 column, String& value) override;
+};
+
 namespace Panels
 {
     class Information : public AppCUI::Controls::TabPage
@@ -15,51 +15,64 @@ bool SQLiteFile::Update()
     return true;
 }
 
-void SQLiteFile::GetStatementResult(const std::string_view& entity, bool fromTable)
+static void AddCSVEntry(AppCUI::Utils::String& content, AppCUI::Utils::String& entry, bool& comma)
 {
-    auto data = fromTable ? db.GetTableData(entity) : db.GetStatementData(entity);
+    if (!comma) {
+        comma = true;
+    } else {
+        content.AddChar(separator);
+    }
 
-    AppCUI::Utils::String content;
+    for (auto i = 0u; i < entry.Len(); i++) {
+        if (entry.GetText()[i] == separator) {
+            entry.SetChar(i, ';');
+        }
+    }
+    content.Add(entry);
+}
 
+void SQLiteFile::GetStatementResult(const std::string_view& entity, bool fromTable)
+{
+    AppCUI::Utils::String content;
+    AppCUI::Utils::String entry;
     bool comma = false;
 
-    for (auto& column : data.first) {
-        if (!comma) {
-            comma = true;
-        } else {
-            content.AddChar(separator);
+    if (fromTable) {
+        // tables are read one page at a time, a row is formatted only while it is written
+        auto cursor = db.OpenCursor(entity);
+        CHECKRET(cursor.IsValid(), "");
+
+        const auto columnsCount = cursor.GetColumnsCount();
+        for (auto i = 0u; i < columnsCount; i++) {
+            entry.Set(cursor.GetColumnName(i));
+            AddCSVEntry(content, entry, comma);
         }
+        content.Add("\n");
 
-        for (auto i = 0u; i < column.Len(); i++) {
-            if (column.GetText()[i] == separator) {
-                column.SetChar(i, ';');
+        for (uint64 row = 0; columnsCount > 0 && cursor.GetCell(row, 0, entry); row++) {
+            comma = false;
+            AddCSVEntry(content, entry, comma);
+            for (auto i = 1u; i < columnsCount; i++) {
+                cursor.GetCell(row, i, entry);
+                AddCSVEntry(content, entry, comma);
             }
+            content.Add("\n");
         }
+    } else {
+        auto data = db.GetStatementData(entity);
 
-        content.Add(column);
-    }
-
-    content.Add("\n");
-
-    for (auto& row : data.second) {
-        comma = false;
-
-        for (auto& entry : row) {
-            if (!comma) {
-                comma = true;
-            } else {
-                content.AddChar(separator);
-            }
+        for (auto& column : data.first) {
+            AddCSVEntry(content, column, comma);
+        }
+        content.Add("\n");
 
-            for (auto i = 0u; i < entry.Len(); i++) {
-                if (entry.GetText()[i] == separator) {
-                    entry.SetChar(i, ';');
-                }
+        for (auto& row : data.second) {
+            comma = false;
+            for (auto& cell : row) {
+                AddCSVEntry(content, cell, comma);
             }
-            content.Add(entry);
+            content.Add("\n");
         }
-
-        content.Add("\n");
     }
 
     AppCUI::Utils::String filename;
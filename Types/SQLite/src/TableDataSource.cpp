@@ -0,0 +1,49 @@
+#include "sqlite.hpp"
+
+using namespace GView::Type::SQLite;
+
+TableDataSource::TableDataSource(Reference<GView::SQLite3::Database> db, std::string_view table) : db(db), table(table), opened(false)
+{
+}
+
+bool TableDataSource::Open()
+{
+    if (!opened) {
+        opened = true;
+        cursor = db->OpenCursor(table);
+    }
+    return cursor.IsValid();
+}
+
+uint64 TableDataSource::GetRowsCount()
+{
+    CHECK(Open(), 0, "");
+    bool exact      = false;
+    const auto rows = cursor.GetRowsCount(exact);
+    return rows < 0 ? 0 : static_cast<uint64>(rows);
+}
+
+bool TableDataSource::HasRow(uint64 row)
+{
+    CHECK(Open(), false, "");
+    return cursor.HasRow(row);
+}
+
+uint32 TableDataSource::GetColumnsCount()
+{
+    CHECK(Open(), 0, "");
+    return cursor.GetColumnsCount();
+}
+
+bool TableDataSource::GetColumnName(uint32 column, String& name)
+{
+    CHECK(Open(), false, "");
+    CHECK(column < cursor.GetColumnsCount(), false, "");
+    return name.Set(cursor.GetColumnName(column));
+}
+
+bool TableDataSource::GetCell(uint64 row, uint32 column, String& value)
+{
+    CHECK(Open(), false, "");
+    return cursor.GetCell(row, column, value);
+}
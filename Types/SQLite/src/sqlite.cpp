@@ -39,6 +39,15 @@ PLUGIN_EXPORT bool PopulateWindow(Reference<GView::View::WindowInterface> win)
     BufferViewer::Settings settings;
     win->CreateViewer(settings);
 
+    // a grid for each of the first tables; a table is opened when its grid is shown and only the rows of the page are read
+    auto tables = sqlite->db.GetTables();
+    for (auto i = 0u; i < tables.size() && i < SQLite::MAX_TABLE_VIEWERS; i++) {
+        GridViewer::Settings gridSettings;
+        gridSettings.SetName(tables[i]);
+        gridSettings.SetDataSource(new SQLite::TableDataSource(&sqlite->db, tables[i]));
+        win->CreateViewer(gridSettings);
+    }
+
     win->AddPanel(Pointer<TabPage>(new SQLite::Panels::Information(sqlite)), true);
     win->AddPanel(Pointer<TabPage>(new SQLite::Panels::Count(sqlite)), true);
 
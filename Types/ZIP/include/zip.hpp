@@ -4,6 +4,27 @@
 
 namespace GView::Type::ZIP
 {
+constexpr int64 LARGE_ENTRY_SIZE = 0x10000000; // 256 MB
+constexpr int64 COMPRESSION_METHOD_STORE = 0;
+
+#pragma pack(push, 1)
+struct LocalFileHeader {
+    uint32 signature;
+    uint16 versionNeeded;
+    uint16 flags;
+    uint16 compressionMethod;
+    uint16 lastModifiedTime;
+    uint16 lastModifiedDate;
+    uint32 crc32;
+    uint32 compressedSize;
+    uint32 uncompressedSize;
+    uint16 filenameLength;
+    uint16 extraFieldLength;
+};
+#pragma pack(pop)
+static_assert(sizeof(LocalFileHeader) == 30);
+
+constexpr uint32 LOCAL_FILE_HEADER_SIGNATURE = 0x04034B50;
 class ZIPFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
   public:
@@ -26,14 +47,17 @@ class ZIPFile : public TypeInterface, public View::ContainerViewer::EnumerateInt
         return "ZIP";
     }
 
-    void RunCommand(std::string_view) override
-    {
-    }
+    void RunCommand(std::string_view command) override;
 
     virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
     virtual bool PopulateItem(TreeViewItem item) override;
     virtual void OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item) override;
 
+    std::u16string GetDropPath(std::u8string_view name) const;
+    bool GetStoredEntryDataOffset(const GView::Decoding::ZIP::Entry& entry, uint64& offset);
+    bool DecompressToDropFolder(uint32 index, const std::string& password);
+    void ExtractAll();
+
   public:
     Reference<GView::Utils::SelectionZoneInterface> selectionZoneInterface;
 
@@ -30,56 +30,10 @@ bool ZIPFile::Update()
 
 bool ZIPFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
 {
-    const auto count = this->info.GetCount();
-    CHECK(count > 0, false, "");
+    CHECK(this->info.GetCount() > 0, false, "");
 
     currentItemIndex = 0;
-    curentChildIndexes.clear();
-
-    if (path.empty()) {
-        for (uint32 i = 0; i < count; i++) {
-            GView::Decoding::ZIP::Entry entry{ 0 };
-            CHECK(this->info.GetEntry(i, entry), false, "");
-
-            auto filename        = entry.GetFilename();
-            const auto entryType = entry.GetType();
-
-            const auto f = filename.find_first_of('/');
-
-            if ((entryType == GView::Decoding::ZIP::EntryType::Directory && f == filename.size() - 1) ||
-                (entryType != GView::Decoding::ZIP::EntryType::Directory && f == std::string::npos)) {
-                curentChildIndexes.push_back(i);
-            }
-        }
-
-        if (this->curentChildIndexes.size() > 0) {
-            return currentItemIndex != this->curentChildIndexes.size();
-        }
-    }
-
-    UnicodeStringBuilder usb;
-    for (uint32 i = 0; i < count; i++) {
-        GView::Decoding::ZIP::Entry entry{ 0 };
-        CHECK(this->info.GetEntry(i, entry), false, "");
-
-        auto filename        = entry.GetFilename();
-        const auto entryType = entry.GetType();
-
-        if (entryType == GView::Decoding::ZIP::EntryType::Directory) {
-            if (filename[filename.size() - 1] == '/') {
-                filename = { filename.data(), filename.size() - 1 };
-            }
-        }
-        CHECK(usb.Set(filename), false, "");
-
-        const auto sv = usb.ToStringView();
-        if (sv.size() > path.size() && sv.starts_with(path) && sv[path.size()] == '/') {
-            const auto tmpSV = std::u16string_view{ sv.data() + path.size(), sv.size() - path.size() };
-            if (tmpSV.find_first_of('/') == tmpSV.find_last_of('/')) {
-                curentChildIndexes.push_back(i);
-            }
-        }
-    }
+    CHECK(this->info.GetChildren(path, curentChildIndexes), false, "");
 
     return currentItemIndex != this->curentChildIndexes.size();
 }
@@ -206,6 +160,98 @@ class PasswordDialog : public Window, public Handlers::OnButtonPressedInterface
     }
 };
 
+std::u16string ZIPFile::GetDropPath(std::u8string_view name) const
+{
+    std::u16string path{ obj->GetPath() };
+    path.append(u".drop");
+    path.push_back((char16_t) std::filesystem::path::preferred_separator);
+
+    LocalUnicodeStringBuilder<1024> ub;
+    CHECK(ub.Set(name), path, "");
+
+    path.append(ub.ToStringView());
+
+    if (std::filesystem::path::preferred_separator == u'\\') // if on windows
+    {
+        std::replace(path.begin(), path.end(), u'/', u'\\');
+    }
+    return path;
+}
+
+bool ZIPFile::GetStoredEntryDataOffset(const GView::Decoding::ZIP::Entry& entry, uint64& offset)
+{
+    CHECK(entry.GetDiskNumber() == 0, false, "");
+    CHECK(entry.GetDiskOffset() >= 0, false, "");
+
+    // the data follows the local header (its name and extra field may differ from the central directory ones)
+    LocalFileHeader header{};
+    const auto headerOffset = static_cast<uint64>(entry.GetDiskOffset());
+    CHECK(obj->GetData().Copy(headerOffset, header), false, "");
+    CHECK(header.signature == LOCAL_FILE_HEADER_SIGNATURE, false, "");
+
+    offset = headerOffset + sizeof(LocalFileHeader) + header.filenameLength + header.extraFieldLength;
+    CHECK(offset + entry.GetCompressedSize() <= obj->GetData().GetSize(), false, "");
+
+    return true;
+}
+
+bool ZIPFile::DecompressToDropFolder(uint32 index, const std::string& entryPassword)
+{
+    GView::Decoding::ZIP::Entry entry{ 0 };
+    CHECK(this->info.GetEntry(index, entry), false, "");
+    CHECK(GView::Decoding::ZIP::IsSafeEntryPath(entry.GetFilename()), false, "Entry name would be written outside of the drop folder");
+
+    const std::filesystem::path path = GetDropPath(entry.GetFilename());
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    AppCUI::OS::File file;
+    CHECK(file.Create(path, true), false, "");
+    const bool decompressed = this->info.Decompress(file, index, entryPassword);
+    file.Close();
+    if (!decompressed) {
+        // a wrong password or a corrupted entry leaves a partial file behind
+        std::filesystem::remove(path, ec);
+        RETURNERROR(false, "");
+    }
+
+    GView::App::OpenFile(path, GView::App::OpenMethod::BestMatch, "", Application::GetCurrentWindow(), "extraction and decompression");
+    return true;
+}
+
+void ZIPFile::ExtractAll()
+{
+    if (!isTopContainer) {
+        Dialogs::MessageBox::ShowError("Error!", "Extraction is available only for archives stored on disk!");
+        return;
+    }
+
+    std::vector<uint32> rootEntries;
+    CHECKRET(this->info.GetChildren(u"", rootEntries), "");
+
+    const std::filesystem::path destination = GetDropPath(u8"");
+    GView::Decoding::ZIP::ExtractResult result{};
+    this->info.Extract(rootEntries, destination, password, result);
+
+    LocalString<256> message;
+    const double seconds = std::max<double>(result.milliseconds, 1.0) / 1000.0;
+    message.SetFormat(
+          "Extracted %u entries (%llu bytes) in %.2f seconds (%.2f MB/s).\nFailed: %u",
+          result.extracted,
+          (unsigned long long) result.bytes,
+          seconds,
+          (double) result.bytes / (1024.0 * 1024.0) / seconds,
+          result.failed);
+    Dialogs::MessageBox::ShowNotification("Extract all", message);
+}
+
+void ZIPFile::RunCommand(std::string_view command)
+{
+    if (command == "ExtractAll") {
+        ExtractAll();
+    }
+}
+
 void ZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewItem item)
 {
     CHECKRET(item.GetParent().GetHandle() != InvalidItemHandle, "");
@@ -215,34 +261,33 @@ void ZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
     GView::Decoding::ZIP::Entry entry{ 0 };
     CHECKRET(this->info.GetEntry((uint32) index, entry), "");
 
+    // stored entries are opened directly from the archive, without being copied
+    uint64 dataOffset = 0;
+    if (entry.GetType() == GView::Decoding::ZIP::EntryType::File && !entry.IsEncrypted() && entry.GetCompressionMethod() == COMPRESSION_METHOD_STORE &&
+        GetStoredEntryDataOffset(entry, dataOffset)) {
+        const auto name = entry.GetFilename();
+        GView::App::OpenSubRange(
+              obj, dataOffset, entry.GetCompressedSize(), name, GetDropPath(name), GView::App::OpenMethod::BestMatch, "", Application::GetCurrentWindow(), "extraction");
+        return;
+    }
+
     Buffer buffer{};
     bool decompressed{ false };
 
+    // big entries are streamed into the drop folder instead of being decompressed in memory
+    // (unless their name would place them outside of it)
+    const bool isLarge =
+          isTopContainer && entry.GetUncompressedSize() > LARGE_ENTRY_SIZE && GView::Decoding::ZIP::IsSafeEntryPath(entry.GetFilename());
+
     if (entry.IsEncrypted() == false || password.empty() == false) {
-        if (isTopContainer) {
-            decompressed = this->info.Decompress(buffer, (uint32) index, password);
-        } else {
-            const auto cache = obj->GetData().GetEntireFile();
-            if (cache.IsValid()) {
-                decompressed = this->info.Decompress(cache, buffer, (uint32) index, password);
-            }
+        if (isLarge && DecompressToDropFolder((uint32) index, password)) {
+            return;
         }
+        decompressed = !isLarge && this->info.Decompress(buffer, (uint32) index, password);
 
         if (decompressed) {
-            std::u16string path{ obj->GetPath() };
-            path.append(u".drop");
-            path.push_back((char16_t) std::filesystem::path::preferred_separator);
-
-            LocalUnicodeStringBuilder<1024> ub;
             const auto name = entry.GetFilename();
-            CHECKRET(ub.Set(name), "");
-
-            path.append(ub.ToStringView());
-
-            if (std::filesystem::path::preferred_separator == u'\\') // if on windows
-            {
-                std::replace(path.begin(), path.end(), u'/', u'\\');
-            }
+            const auto path = GetDropPath(name);
             GView::App::OpenBuffer(buffer, name, path, GView::App::OpenMethod::BestMatch,"",Application::GetCurrentWindow(),"extraction and decompression");
 
             return;
@@ -258,15 +303,20 @@ void ZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
 
     PasswordDialog pd;
     while (pd.Show() == Dialogs::Result::Ok) {
-        if (isTopContainer) {
-            decompressed = this->info.Decompress(buffer, (uint32) index, pd.GetPassword());
-        } else {
-            const auto cache = obj->GetData().GetEntireFile();
-            if (cache.IsValid()) {
-                decompressed = this->info.Decompress(cache, buffer, (uint32) index, pd.GetPassword());
+        if (isLarge) {
+            decompressed = DecompressToDropFolder((uint32) index, pd.GetPassword());
+            if (decompressed && pd.SavePasswordAsDefault()) {
+                this->password = pd.GetPassword();
             }
+            if (decompressed) {
+                return;
+            }
+            Dialogs::MessageBox::ShowError("Error!", "Wrong password!");
+            continue;
         }
 
+        decompressed = this->info.Decompress(buffer, (uint32) index, pd.GetPassword());
+
         if (decompressed) {
             if (pd.SavePasswordAsDefault()) {
                 this->password = pd.GetPassword();
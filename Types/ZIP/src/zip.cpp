@@ -117,5 +117,6 @@ PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     sect["Extension"]   = "zip";
     sect["Priority"]    = 1;
     sect["Description"] = "Archive file format (*.zip)";
+    sect["Command.ExtractAll"] = AppCUI::Input::Key::Shift | AppCUI::Input::Key::F10;
 }
 }